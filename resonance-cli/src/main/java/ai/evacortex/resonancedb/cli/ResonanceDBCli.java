@@ -79,6 +79,7 @@ public final class ResonanceDBCli {
             case "interferencemap" -> { cmdInterferenceMap(store, flags); yield 0; }
             case "composite" -> { cmdComposite(store, flags); yield 0; }
             case "compositedetailed" -> { cmdCompositeDetailed(store, flags); yield 0; }
+            case "querybatch" -> { cmdQueryBatch(store, flags); yield 0; }
             case "repl" -> { repl(dbRoot, store); yield 0; }
             default -> {
                 System.err.println("ERR: Unknown command: " + cmd);
@@ -179,6 +180,16 @@ public final class ResonanceDBCli {
         printMatchesDetailed(matches);
     }
 
+    private static void cmdQueryBatch(ResonanceStore store, Map<String, String> flags) {
+        List<WavePattern> queries = readPatterns(flags, "queryBatch");
+        int topK = parseIntOr(flags, "topk", 10);
+        List<List<ResonanceMatch>> results = store.queryBatch(queries, clampTopK(topK));
+        for (int i = 0; i < results.size(); i++) {
+            System.out.println("# query " + i);
+            printMatches(results.get(i));
+        }
+    }
+
     private static void repl(Path dbRoot, WavePatternStoreImpl store) throws IOException {
         System.out.println("ResonanceDB REPL");
         System.out.println("dbRoot: " + dbRoot);
@@ -241,6 +252,7 @@ public final class ResonanceDBCli {
             case "interferencemap" -> cmdInterferenceMap(store, flags);
             case "composite" -> cmdComposite(store, flags);
             case "compositedetailed" -> cmdCompositeDetailed(store, flags);
+            case "querybatch" -> cmdQueryBatch(store, flags);
             default -> System.err.println("ERR: Unknown REPL command: " + cmd);
         }
     }
@@ -281,9 +293,30 @@ public final class ResonanceDBCli {
     }
 
     private static CompositeInput readComposite(Map<String, String> flags) {
+        List<WavePattern> patterns = readPatterns(flags, "Composite");
+
+        List<Double> weights = null;
+        String wRaw = firstNonBlank(flags.get("weights"), flags.get("w"));
+        if (wRaw != null && !wRaw.trim().isEmpty()) {
+            weights = new ArrayList<>();
+            for (String s : wRaw.split(",")) {
+                String t = s.trim();
+                if (t.isEmpty()) continue;
+                try {
+                    weights.add(Double.parseDouble(t));
+                } catch (NumberFormatException e) {
+                    throw new IllegalArgumentException("Bad weight: " + t);
+                }
+            }
+        }
+
+        return new CompositeInput(patterns, weights);
+    }
+
+    private static List<WavePattern> readPatterns(Map<String, String> flags, String command) {
         String patternsRaw = firstNonBlank(flags.get("patterns"), flags.get("p"));
         if (patternsRaw == null) {
-            throw new IllegalArgumentException("Composite requires --patterns (format: amp|phase; amp|phase; ...)");
+            throw new IllegalArgumentException(command + " requires --patterns (format: amp|phase; amp|phase; ...)");
         }
 
         List<WavePattern> patterns = new ArrayList<>();
@@ -297,30 +330,14 @@ public final class ResonanceDBCli {
             String amp = b.substring(0, bar).trim();
             String phs = b.substring(bar + 1).trim();
 
-            double[] A = parseDoubles(amp, "composite amp");
-            double[] P = parseDoubles(phs, "composite phase");
+            double[] A = parseDoubles(amp, command + " amp");
+            double[] P = parseDoubles(phs, command + " phase");
             if (A.length != P.length) throw new IllegalArgumentException("Amplitude/phase mismatch in block: " + b);
 
             patterns.add(new WavePattern(A, P));
         }
-        if (patterns.isEmpty()) throw new IllegalArgumentException("Composite patterns list is empty");
-
-        List<Double> weights = null;
-        String wRaw = firstNonBlank(flags.get("weights"), flags.get("w"));
-        if (wRaw != null && !wRaw.trim().isEmpty()) {
-            weights = new ArrayList<>();
-            for (String s : wRaw.split(",")) {
-                String t = s.trim();
-                if (t.isEmpty()) continue;
-                try {
-                    weights.add(Double.parseDouble(t));
-                } catch (NumberFormatException e) {
-                    throw new IllegalArgumentException("Bad weight: " + t);
-                }
-            }
-        }
-
-        return new CompositeInput(patterns, weights);
+        if (patterns.isEmpty()) throw new IllegalArgumentException(command + " patterns list is empty");
+        return patterns;
     }
 
     private static Map<String, String> parseMeta(String meta) {
@@ -398,6 +415,7 @@ public final class ResonanceDBCli {
                   interferenceMap --amp=... --phase=... [--topK=10]
                   composite --patterns="amp|phase; amp|phase; ..." [--weights=1,0.5,0.2] [--topK=10]
                   compositeDetailed --patterns="amp|phase; amp|phase; ..." [--weights=...] [--topK=10]
+                  queryBatch --patterns="amp|phase; amp|phase; ..." [--topK=10]
                   repl
 
                 Flags:
@@ -423,6 +441,7 @@ public final class ResonanceDBCli {
                   interferenceMap --amp=... --phase=... [--topK=10]
                   composite --patterns="amp|phase; amp|phase" [--weights=...] [--topK=10]
                   compositeDetailed --patterns="..." [--weights=...] [--topK=10]
+                  queryBatch --patterns="amp|phase; amp|phase" [--topK=10]
                   exit
                 """);
     }
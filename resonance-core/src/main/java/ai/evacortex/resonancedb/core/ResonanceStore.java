@@ -8,15 +8,22 @@
  */
 package ai.evacortex.resonancedb.core;
 
+import ai.evacortex.resonancedb.core.engine.QueryOptions;
 import ai.evacortex.resonancedb.core.exceptions.*;
 import ai.evacortex.resonancedb.core.storage.WavePattern;
 import ai.evacortex.resonancedb.core.storage.responce.InterferenceEntry;
 import ai.evacortex.resonancedb.core.storage.responce.InterferenceMap;
+import ai.evacortex.resonancedb.core.storage.responce.QueryCacheStats;
+import ai.evacortex.resonancedb.core.storage.responce.QueryPage;
+import ai.evacortex.resonancedb.core.storage.responce.QueryResult;
 import ai.evacortex.resonancedb.core.storage.responce.ResonanceMatch;
 import ai.evacortex.resonancedb.core.storage.responce.ResonanceMatchDetailed;
+import ai.evacortex.resonancedb.core.storage.responce.ThresholdResult;
 
 import java.util.List;
 import java.util.Map;
+import java.util.concurrent.CompletableFuture;
+import java.util.function.Consumer;
 
 /**
  * {@code ResonanceStore} defines the core contract for interacting with a cognitive waveform database
@@ -34,6 +41,11 @@ import java.util.Map;
  * <p>Implementations must be fully thread-safe, support concurrent reads and lock-isolated writes,
  * and guarantee deterministic behavior under identical input conditions.</p>
  *
+ * <p>The {@code *Async} variants return immediately with a {@link CompletableFuture}. The defaults
+ * run the blocking call on {@link CompletableFuture#supplyAsync(java.util.function.Supplier)};
+ * implementations with their own query executor should complete the futures there and stop a
+ * running scan when its future is cancelled.</p>
+ *
  * @see WavePattern
  * @see ResonanceMatch
  * @see ResonanceMatchDetailed
@@ -85,6 +97,39 @@ public interface ResonanceStore {
      */
     float compare(WavePattern a, WavePattern b);
 
+    /**
+     * Asynchronous {@link #insert(WavePattern, Map)}; failures complete the future exceptionally.
+     *
+     * @param psi      the wave pattern to store
+     * @param metadata optional metadata associated with the pattern
+     * @return a future of the content-derived ID
+     */
+    default CompletableFuture<String> insertAsync(WavePattern psi, Map<String, String> metadata) {
+        return CompletableFuture.supplyAsync(() -> insert(psi, metadata));
+    }
+
+    /**
+     * Asynchronous {@link #delete(String)}.
+     *
+     * @param id the content-derived hash of the pattern to delete
+     * @return a future completed once the pattern is deleted
+     */
+    default CompletableFuture<Void> deleteAsync(String id) {
+        return CompletableFuture.runAsync(() -> delete(id));
+    }
+
+    /**
+     * Asynchronous {@link #replace(String, WavePattern, Map)}.
+     *
+     * @param id       the ID of the existing pattern to remove
+     * @param psi      the new {@link WavePattern} to insert
+     * @param metadata optional metadata to associate
+     * @return a future of the content-derived ID of the new pattern
+     */
+    default CompletableFuture<String> replaceAsync(String id, WavePattern psi, Map<String, String> metadata) {
+        return CompletableFuture.supplyAsync(() -> replace(id, psi, metadata));
+    }
+
     /**
      * Queries the store for the top-K most resonant matches to the given pattern.
      *
@@ -96,6 +141,96 @@ public interface ResonanceStore {
      */
     List<ResonanceMatch> query(WavePattern query, int topK);
 
+    /**
+     * Queries the store for the top-K most resonant matches using explicit execution options.
+     *
+     * <p>Options control how candidates are scanned (for example a coarse spectral-prefix pass
+     * before full scoring); they do not change the similarity function.</p>
+     *
+     * @param query   the input pattern
+     * @param topK    the number of top matches to return
+     * @param options per-query execution options
+     * @return list of {@link ResonanceMatch}, ordered by descending similarity
+     * @see QueryOptions
+     */
+    List<ResonanceMatch> query(WavePattern query, int topK, QueryOptions options);
+
+    /**
+     * Same as {@link #query(WavePattern, int, QueryOptions)}, but also reports the effective
+     * options (phase epsilon after widening, resolved overfetch) and how much work was done.
+     *
+     * @param query   the input pattern
+     * @param topK    the number of top matches to return
+     * @param options per-query execution options
+     * @return matches ordered by descending similarity, with the applied options
+     */
+    QueryResult<ResonanceMatch> queryResult(WavePattern query, int topK, QueryOptions options);
+
+    /**
+     * Asynchronous {@link #query(WavePattern, int, QueryOptions)}. Cancelling the future stops the
+     * scan at the next batch boundary.
+     *
+     * @param query   the input pattern
+     * @param topK    the number of top matches to return
+     * @param options per-query execution options
+     * @return a future of the matches, ordered by descending similarity
+     */
+    default CompletableFuture<List<ResonanceMatch>> queryAsync(WavePattern query, int topK, QueryOptions options) {
+        return queryResultAsync(query, topK, options).thenApply(QueryResult::matches);
+    }
+
+    /**
+     * Asynchronous {@link #queryResult(WavePattern, int, QueryOptions)}.
+     *
+     * @param query   the input pattern
+     * @param topK    the number of top matches to return
+     * @param options per-query execution options
+     * @return a future of the matches with the applied options
+     */
+    default CompletableFuture<QueryResult<ResonanceMatch>> queryResultAsync(WavePattern query, int topK, QueryOptions options) {
+        return CompletableFuture.supplyAsync(() -> queryResult(query, topK, options));
+    }
+
+    /**
+     * Returns one page of a ranked query. The first call passes {@code cursor = null}; each page
+     * carries a cursor that resumes strictly after its last match, so deep pages never rescan with a
+     * growing {@code topK}. A page may be served from a short-lived prefetch made by the previous
+     * call while the corpus version is unchanged; after a mutation the next page is ranked against
+     * the current corpus.
+     *
+     * @param query    the query pattern
+     * @param pageSize the number of matches per page
+     * @param cursor   the cursor returned with the previous page, or {@code null} for the first page
+     * @param options  per-query execution options
+     * @return the page and the cursor of the next one
+     * @throws IllegalArgumentException if the cursor is malformed or belongs to another query
+     */
+    QueryPage<ResonanceMatch> queryPage(WavePattern query, int pageSize, String cursor, QueryOptions options);
+
+    /**
+     * Runs several top-K queries in one pass over the store.
+     *
+     * <p>Routed segments are unioned across the batch; each block of candidates is decoded once and
+     * scored against every query routed to its segment. Each result equals a
+     * {@link QueryOptions.ScanMode#FULL} query of that pattern without sketch prefilter.</p>
+     *
+     * @param queries the input patterns
+     * @param topK    the number of top matches to return per query
+     * @return one match list per query, in input order
+     */
+    List<List<ResonanceMatch>> queryBatch(List<WavePattern> queries, int topK);
+
+    /**
+     * Asynchronous {@link #queryBatch(List, int)}.
+     *
+     * @param queries the input patterns
+     * @param topK    the number of top matches to return per query
+     * @return a future of one match list per query, in input order
+     */
+    default CompletableFuture<List<List<ResonanceMatch>>> queryBatchAsync(List<WavePattern> queries, int topK) {
+        return CompletableFuture.supplyAsync(() -> queryBatch(queries, topK));
+    }
+
     /**
      * Queries the store and returns detailed match results, including phase deltas and zones.
      *
@@ -107,6 +242,63 @@ public interface ResonanceStore {
      */
     List<ResonanceMatchDetailed> queryDetailed(WavePattern query, int topK);
 
+    /**
+     * Detailed query using explicit routing options; scan modes and the sketch prefilter do not
+     * apply to detailed scoring.
+     *
+     * @param query   the input pattern
+     * @param topK    the number of top detailed matches to return
+     * @param options per-query execution options
+     * @return list of {@link ResonanceMatchDetailed} results
+     */
+    List<ResonanceMatchDetailed> queryDetailed(WavePattern query, int topK, QueryOptions options);
+
+    /**
+     * Same as {@link #queryDetailed(WavePattern, int, QueryOptions)}, with the effective options reported.
+     *
+     * @param query   the input pattern
+     * @param topK    the number of top detailed matches to return
+     * @param options per-query execution options
+     * @return detailed matches with the applied options
+     */
+    QueryResult<ResonanceMatchDetailed> queryDetailedResult(WavePattern query, int topK, QueryOptions options);
+
+    /**
+     * Asynchronous {@link #queryDetailedResult(WavePattern, int, QueryOptions)}.
+     *
+     * @param query   the input pattern
+     * @param topK    the number of top detailed matches to return
+     * @param options per-query execution options
+     * @return a future of the detailed matches with the applied options
+     */
+    default CompletableFuture<QueryResult<ResonanceMatchDetailed>> queryDetailedResultAsync(WavePattern query,
+                                                                                           int topK,
+                                                                                           QueryOptions options) {
+        return CompletableFuture.supplyAsync(() -> queryDetailedResult(query, topK, options));
+    }
+
+    /**
+     * Streams every pattern whose resonance energy with {@code query} is at least {@code minEnergy},
+     * without keeping a global top-K. Segments and candidates whose score bound falls below the floor
+     * are skipped.
+     *
+     * <p>Matches arrive in no particular order. The sink is invoked serially, but not necessarily on
+     * the calling thread, against a snapshot of the corpus pinned when the query starts: writes proceed
+     * meanwhile and are not seen by the scan. An exception thrown by the sink stops the scan and
+     * propagates to the caller. Routing, sketch and overfetch options do not apply;
+     * {@code maxSegments}, {@code maxCandidates}, {@code timeoutMillis} and {@code projection} do.</p>
+     *
+     * @param query     the query pattern
+     * @param minEnergy the energy floor τ
+     * @param options   per-query execution options
+     * @param sink      receives each match with energy ≥ τ
+     * @return the number of emitted matches and scan statistics
+     */
+    ThresholdResult queryThreshold(WavePattern query,
+                                   float minEnergy,
+                                   QueryOptions options,
+                                   Consumer<? super ResonanceMatch> sink);
+
     /**
      * Computes a high-level interference map for the query pattern, aggregating detailed results.
      *
@@ -150,4 +342,31 @@ public interface ResonanceStore {
      * @return list of {@link ResonanceMatchDetailed} with zone analysis
      */
     List<ResonanceMatchDetailed> queryCompositeDetailed(List<WavePattern> patterns, List<Double> weights, int topK);
+
+    /**
+     * Reads a stored pattern by id, e.g. to fetch payloads lazily after a query with a
+     * projection other than {@code FULL}.
+     *
+     * @param id the content-based pattern ID
+     * @return the stored wave pattern
+     * @throws PatternNotFoundException if no pattern with the given ID exists
+     */
+    WavePattern getPattern(String id);
+
+    /**
+     * Returns the metadata stored with a pattern.
+     *
+     * @param id the content-based pattern ID
+     * @return the metadata map; empty when none was stored
+     * @throws PatternNotFoundException if no pattern with the given ID exists
+     */
+    Map<String, String> getMetadata(String id);
+
+    /**
+     * Returns hit/miss counters and size of the query result cache, together with the current
+     * corpus version that cache entries are validated against.
+     *
+     * @return result cache statistics; all zero when the cache is disabled
+     */
+    QueryCacheStats queryCacheStats();
 }
\ No newline at end of file
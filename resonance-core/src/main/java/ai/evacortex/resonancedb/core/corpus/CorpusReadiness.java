@@ -0,0 +1,30 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.corpus;
+
+/**
+ * Warm-up state of one open corpus. Queries against a corpus that is still {@link Phase#WARMING}
+ * wait until its segment readers are open rather than miss records.
+ */
+public record CorpusReadiness(
+        String corpusId,
+        Phase phase,
+        int segmentsWarm,
+        int segmentsTotal
+) {
+    public enum Phase {
+        WARMING,
+        READY,
+        FAILED
+    }
+
+    public boolean ready() {
+        return phase == Phase.READY;
+    }
+}
@@ -9,10 +9,18 @@
 package ai.evacortex.resonancedb.core.corpus;
 
 import ai.evacortex.resonancedb.core.ResonanceStore;
+import ai.evacortex.resonancedb.core.engine.QueryOptions;
+import ai.evacortex.resonancedb.core.exceptions.CorpusNotFoundException;
+import ai.evacortex.resonancedb.core.storage.WavePattern;
+import ai.evacortex.resonancedb.core.storage.responce.AdmissionStats;
+import ai.evacortex.resonancedb.core.storage.responce.CorpusMatch;
+import ai.evacortex.resonancedb.core.storage.responce.MemoryStats;
+import ai.evacortex.resonancedb.core.storage.responce.QueryResult;
 
 import java.util.List;
 import java.util.Objects;
 import java.util.Optional;
+import java.util.concurrent.CompletableFuture;
 
 public interface CorpusService extends AutoCloseable {
 
@@ -25,6 +33,41 @@ public interface CorpusService extends AutoCloseable {
 
     List<CorpusInfo> list();
 
+    /**
+     * Best {@code topK} matches of {@code query} across {@code corpusIds}, ranked as one scan instead of
+     * one query per corpus. The result does not depend on the order of {@code corpusIds}.
+     *
+     * @throws CorpusNotFoundException if any of {@code corpusIds} does not exist; nothing is scanned
+     */
+    QueryResult<CorpusMatch> queryMany(List<String> corpusIds, WavePattern query, int topK, QueryOptions options);
+
+    default QueryResult<CorpusMatch> queryMany(List<String> corpusIds, WavePattern query, int topK) {
+        return queryMany(corpusIds, query, topK, QueryOptions.defaultOptions());
+    }
+
+    /** Asynchronous {@link #queryMany(List, WavePattern, int, QueryOptions)}. */
+    default CompletableFuture<QueryResult<CorpusMatch>> queryManyAsync(List<String> corpusIds,
+                                                                       WavePattern query,
+                                                                       int topK,
+                                                                       QueryOptions options) {
+        return CompletableFuture.supplyAsync(() -> queryMany(corpusIds, query, topK, options));
+    }
+
+    /** Queue depth and in-flight counters of query admission control shared by all corpora. */
+    default AdmissionStats admissionStats() {
+        return AdmissionStats.EMPTY;
+    }
+
+    /** Bytes accounted by the memory governor per corpus, against its global budget. */
+    default MemoryStats memoryStats() {
+        return MemoryStats.EMPTY;
+    }
+
+    /** Warm-up state of every currently open corpus. */
+    default List<CorpusReadiness> readiness() {
+        return List.of();
+    }
+
     @Override
     void close();
 
@@ -8,6 +8,7 @@
  */
 package ai.evacortex.resonancedb.core.engine;
 
+import ai.evacortex.resonancedb.core.math.SignSketch;
 import ai.evacortex.resonancedb.core.storage.responce.ComparisonResult;
 import ai.evacortex.resonancedb.core.storage.WavePattern;
 
@@ -169,4 +170,9 @@ public final class JavaKernel implements ResonanceKernel {
         double phaseDelta = Math.atan2(sinSum, cosSum);
         return new ComparisonResult(energy, phaseDelta);
     }
-}
\ No newline at end of file
+
+    @Override
+    public int[] hammingMany(long[] querySketch, long[] sketches, int words, int count) {
+        return SignSketch.hammingMany(querySketch, sketches, words, count);
+    }
+}
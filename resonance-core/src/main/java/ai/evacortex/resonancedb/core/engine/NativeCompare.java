@@ -13,6 +13,7 @@ import java.io.InputStream;
 import java.lang.foreign.*;
 import java.lang.invoke.MethodHandle;
 import java.lang.foreign.SymbolLookup;
+import java.nio.ByteOrder;
 import java.nio.file.Files;
 import java.nio.file.Path;
 import java.nio.file.StandardCopyOption;
@@ -35,10 +36,20 @@ public final class NativeCompare {
     private static final FunctionDescriptor DELTA_DESC = FunctionDescriptor.ofVoid(
             ADDRESS, ADDRESS, ADDRESS, ADDRESS, JAVA_INT, ADDRESS);
 
+    private static final FunctionDescriptor HAMMING_DESC = FunctionDescriptor.ofVoid(
+            ADDRESS, ADDRESS, JAVA_INT, JAVA_INT, JAVA_INT, ADDRESS);
+
+    /** Largest {@code count} a single native call accepts; mirrors {@code MAX_COUNT} in compare.c. */
+    static final int MAX_COUNT = 1 << 24;
+
+    /** Sign sketches are stored little-endian; both operands use it so the XOR is host-order independent. */
+    private static final ValueLayout.OfLong SKETCH_LONG = JAVA_LONG.withOrder(ByteOrder.LITTLE_ENDIAN);
+
     private static final MethodHandle SCALAR;
     private static final MethodHandle BATCH;
     private static final MethodHandle FLAT;
     private static final MethodHandle DELTA;
+    private static final MethodHandle HAMMING;
 
     static {
         loadNativeLibrary("resonance");
@@ -48,6 +59,9 @@ public final class NativeCompare {
             BATCH  = LINKER.downcallHandle(lookup.find("compare_many").orElseThrow(),           BATCH_DESC);
             FLAT   = LINKER.downcallHandle(lookup.find("compare_many_flat").orElseThrow(),      FLAT_DESC);
             DELTA  = LINKER.downcallHandle(lookup.find("compare_with_phase_delta").orElseThrow(), DELTA_DESC);
+            HAMMING = lookup.find("hamming_many_strided")
+                    .map(sym -> LINKER.downcallHandle(sym, HAMMING_DESC))
+                    .orElse(null);
         }
     }
 
@@ -168,6 +182,67 @@ public final class NativeCompare {
         }
     }
 
+    public static boolean hasHamming() {
+        return HAMMING != null;
+    }
+
+    public static int[] hammingMany(long[] query, long[] all, int words, int count) throws Throwable {
+        if (HAMMING == null) {
+            throw new UnsupportedOperationException("hamming_many_strided is not exported by the native library");
+        }
+        if (query == null || all == null)
+            throw new IllegalArgumentException("Null sketch array");
+        if (words <= 0 || count <= 0)
+            throw new IllegalArgumentException("words and count must be > 0");
+        long total = (long) words * (long) count;
+        if (query.length < words || all.length < total || total > Integer.MAX_VALUE)
+            throw new IllegalArgumentException("Sketch buffer length mismatch");
+
+        try (Arena arena = Arena.ofConfined()) {
+            MemorySegment seg = arena.allocate(JAVA_LONG, total);
+            MemorySegment.copy(all, 0, seg, SKETCH_LONG, 0, (int) total);
+            return hammingStrided(arena, query, seg, words, words, count);
+        }
+    }
+
+    /**
+     * Hamming distances against {@code count} little-endian sketches of {@code words} longs spaced
+     * {@code stride} longs apart in {@code all}, which must be native and 8-byte aligned (e.g. a mapped
+     * sidecar). The kernel reads {@code all} in place.
+     */
+    public static int[] hammingMany(long[] query, MemorySegment all, int words, int stride, int count)
+            throws Throwable {
+        if (HAMMING == null) {
+            throw new UnsupportedOperationException("hamming_many_strided is not exported by the native library");
+        }
+        if (query == null || all == null)
+            throw new IllegalArgumentException("Null sketch buffer");
+        if (words <= 0 || count <= 0 || stride < words)
+            throw new IllegalArgumentException("words and count must be > 0 and stride >= words");
+        if (!all.isNative() || all.address() % Long.BYTES != 0)
+            throw new IllegalArgumentException("Sketch segment must be native and 8-byte aligned");
+        if (query.length < words || all.byteSize() < ((long) (count - 1) * stride + words) * Long.BYTES)
+            throw new IllegalArgumentException("Sketch buffer length mismatch");
+
+        try (Arena arena = Arena.ofConfined()) {
+            return hammingStrided(arena, query, all, words, stride, count);
+        }
+    }
+
+    /** Calls the kernel in slices of at most {@link #MAX_COUNT} sketches, which it would otherwise reject. */
+    private static int[] hammingStrided(Arena arena, long[] query, MemorySegment all,
+                                        int words, int stride, int count) throws Throwable {
+        MemorySegment q = arena.allocate(JAVA_LONG, words);
+        MemorySegment.copy(query, 0, q, SKETCH_LONG, 0, words);
+        MemorySegment out = arena.allocate(JAVA_INT, count);
+        for (int from = 0; from < count; from += MAX_COUNT) {
+            int n = Math.min(MAX_COUNT, count - from);
+            HAMMING.invoke(q, all.asSlice((long) from * stride * Long.BYTES), words, stride, n,
+                    out.asSlice((long) from * Integer.BYTES));
+        }
+        return out.toArray(JAVA_INT);
+    }
+
     private static void validate(float[] a1, float[] p1, float[] a2, float[] p2) {
         if (a1 == null || p1 == null || a2 == null || p2 == null)
             throw new IllegalArgumentException("Null array");
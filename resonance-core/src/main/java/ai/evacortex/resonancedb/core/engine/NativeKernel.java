@@ -8,17 +8,23 @@
  */
 package ai.evacortex.resonancedb.core.engine;
 
+import ai.evacortex.resonancedb.core.math.SignSketch;
 import ai.evacortex.resonancedb.core.storage.responce.ComparisonResult;
 import ai.evacortex.resonancedb.core.storage.WavePattern;
 
+import java.lang.foreign.MemorySegment;
 import java.util.List;
 import java.util.Objects;
+import java.util.concurrent.atomic.AtomicBoolean;
 
 
 public final class NativeKernel implements ResonanceKernel {
 
     private static final JavaKernel JAVA_FALLBACK = new JavaKernel();
     private static final int CFG_BATCH = Math.max(1024, Integer.getInteger("resonance.native.batch", 8192));
+    /** Why the native {@code hamming_many_strided} cannot be used, or {@code null}; resolved once. */
+    private static final String HAMMING_UNAVAILABLE = hammingUnavailable();
+    private static final AtomicBoolean HAMMING_FALLBACK_WARNED = new AtomicBoolean();
 
     private static final ThreadLocal<float[]> TL_Q_AMP   = ThreadLocal.withInitial(() -> new float[0]);
     private static final ThreadLocal<float[]> TL_Q_PHASE = ThreadLocal.withInitial(() -> new float[0]);
@@ -154,6 +160,50 @@ public final class NativeKernel implements ResonanceKernel {
         }
     }
 
+    @Override
+    public int[] hammingMany(long[] querySketch, long[] sketches, int words, int count) {
+        if (count <= 0) return new int[0];
+        if (HAMMING_UNAVAILABLE == null) {
+            try {
+                return NativeCompare.hammingMany(querySketch, sketches, words, count);
+            } catch (Throwable e) {
+                warnHammingFallback(e.toString());
+            }
+        } else {
+            warnHammingFallback(HAMMING_UNAVAILABLE);
+        }
+        return SignSketch.hammingMany(querySketch, sketches, words, count);
+    }
+
+    @Override
+    public int[] hammingMany(long[] querySketch, MemorySegment sketches, int words, int stride, int count) {
+        if (count <= 0) return new int[0];
+        if (HAMMING_UNAVAILABLE == null && sketches.isNative() && sketches.address() % Long.BYTES == 0) {
+            try {
+                return NativeCompare.hammingMany(querySketch, sketches, words, stride, count);
+            } catch (Throwable e) {
+                warnHammingFallback(e.toString());
+            }
+        } else if (HAMMING_UNAVAILABLE != null) {
+            warnHammingFallback(HAMMING_UNAVAILABLE);
+        }
+        return SignSketch.hammingMany(querySketch, sketches, words, stride, count);
+    }
+
+    private static String hammingUnavailable() {
+        try {
+            return NativeCompare.hasHamming() ? null : "hamming_many_strided is not exported by the native library";
+        } catch (Throwable e) {
+            return "native library failed to load: " + e;
+        }
+    }
+
+    private static void warnHammingFallback(String reason) {
+        if (HAMMING_FALLBACK_WARNED.compareAndSet(false, true)) {
+            System.err.println("Native hammingMany unavailable, using the Java popcount: " + reason);
+        }
+    }
+
     private static float[] ensureCapacity(ThreadLocal<float[]> tl, int need) {
         float[] a = tl.get();
         if (a.length < need) {
@@ -0,0 +1,173 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.engine;
+
+import java.util.Locale;
+import java.util.Objects;
+
+/**
+ * Per-query execution options for {@code ResonanceStore.query(...)}.
+ *
+ * <p>Options select which segments are routed, how candidates are scanned and which fields each
+ * match carries; they never change how a candidate is scored. All options are immutable and
+ * thread-safe. Stores report the values they actually applied in {@code QueryResult#options()}.</p>
+ *
+ * <ul>
+ *     <li>{@code scanMode} — {@link ScanMode#FULL} scores every routed candidate;
+ *     {@link ScanMode#SPECTRAL_PREFIX} first bounds each candidate from its stored spectral prefix
+ *     and residual energy, and fully scores only candidates whose bound can still reach the top-K;
+ *     {@link ScanMode#AMPLITUDE_CASCADE} bounds each candidate by its amplitude-only score
+ *     ({@code cos Δφ ≤ 1}, no trigonometry) and phase-scores only candidates that can still reach the top-K.
+ *     All modes return the same results.</li>
+ *     <li>{@code sketchPrefilter} — narrow large segments to the closest candidates by sign-sketch
+ *     Hamming distance before scoring (approximate)</li>
+ *     <li>{@code phaseEpsilon} — initial routing radius in radians around the query mean phase;
+ *     widened step by step while no segment qualifies</li>
+ *     <li>{@code maxSegments} — upper bound on segments scanned, best-ranked first ({@code 0} = unlimited)</li>
+ *     <li>{@code maxCandidates} — upper bound on candidates scored across all segments ({@code 0} = unlimited)</li>
+ *     <li>{@code overfetch} — per-segment overfetch factor for the sketch prefilter and detailed heaps
+ *     ({@code 0} = adaptive from {@code topK})</li>
+ *     <li>{@code exact} — scan every segment with no prefilter or caps; overrides the routing options above</li>
+ *     <li>{@code timeoutMillis} — query deadline measured from the start of execution ({@code 0} = none);
+ *     when it expires the best matches found so far are returned and the result is flagged partial.
+ *     Exact mode does not lift the deadline.</li>
+ *     <li>{@code projection} — which match fields are returned: ids, scores, stored metadata, and for
+ *     {@link Projection#FULL} the decoded pattern. Patterns are read from segments only for {@code FULL}.</li>
+ *     <li>{@code priority} — admission class: {@link Priority#INTERACTIVE} queries get a larger fair share
+ *     and a tighter queueing target than {@link Priority#BATCH} ones</li>
+ * </ul>
+ */
+public record QueryOptions(
+        ScanMode scanMode,
+        boolean sketchPrefilter,
+        double phaseEpsilon,
+        int maxSegments,
+        int maxCandidates,
+        int overfetch,
+        boolean exact,
+        long timeoutMillis,
+        Projection projection,
+        Priority priority
+) {
+    public enum ScanMode {
+        FULL,
+        SPECTRAL_PREFIX,
+        AMPLITUDE_CASCADE
+    }
+
+    public enum Projection {
+        IDS,
+        IDS_SCORES,
+        IDS_SCORES_METADATA,
+        FULL;
+
+        /** Parses {@code ids}, {@code ids+scores}, {@code ids+scores+metadata} or {@code full}, case-insensitively. */
+        public static Projection parse(String raw) {
+            return valueOf(raw.trim().toUpperCase(Locale.ROOT).replace('+', '_'));
+        }
+    }
+
+    public enum Priority {
+        INTERACTIVE,
+        BATCH
+    }
+
+    private static final QueryOptions DEFAULTS = new QueryOptions(
+            parseScanMode(System.getProperty("resonance.query.scanMode", "FULL")),
+            Boolean.parseBoolean(System.getProperty("resonance.query.sketch.enabled", "false")),
+            Double.parseDouble(System.getProperty("resonance.query.epsilon", "0.1")),
+            Math.max(0, Integer.getInteger("resonance.query.maxSegments", 0)),
+            Math.max(0, Integer.getInteger("resonance.query.maxCandidates", 0)),
+            0,
+            Boolean.parseBoolean(System.getProperty("resonance.query.exact", "false")),
+            Math.max(0L, Long.getLong("resonance.query.timeoutMillis", 0L)),
+            parseProjection(System.getProperty("resonance.query.projection", "full")),
+            parsePriority(System.getProperty("resonance.query.priority", "interactive"))
+    );
+
+    public QueryOptions {
+        Objects.requireNonNull(scanMode, "scanMode must not be null");
+        Objects.requireNonNull(projection, "projection must not be null");
+        Objects.requireNonNull(priority, "priority must not be null");
+        if (!(phaseEpsilon >= 0.0) || Double.isInfinite(phaseEpsilon)) {
+            throw new IllegalArgumentException("phaseEpsilon must be finite and >= 0, got: " + phaseEpsilon);
+        }
+        if (maxSegments < 0 || maxCandidates < 0 || overfetch < 0 || timeoutMillis < 0) {
+            throw new IllegalArgumentException("maxSegments, maxCandidates, overfetch and timeoutMillis must be >= 0");
+        }
+    }
+
+    public static QueryOptions defaultOptions() {
+        return DEFAULTS;
+    }
+
+    public QueryOptions withScanMode(ScanMode mode) {
+        return new QueryOptions(mode, sketchPrefilter, phaseEpsilon, maxSegments, maxCandidates, overfetch, exact, timeoutMillis, projection, priority);
+    }
+
+    public QueryOptions withSketchPrefilter(boolean enabled) {
+        return new QueryOptions(scanMode, enabled, phaseEpsilon, maxSegments, maxCandidates, overfetch, exact, timeoutMillis, projection, priority);
+    }
+
+    public QueryOptions withPhaseEpsilon(double eps) {
+        return new QueryOptions(scanMode, sketchPrefilter, eps, maxSegments, maxCandidates, overfetch, exact, timeoutMillis, projection, priority);
+    }
+
+    public QueryOptions withMaxSegments(int max) {
+        return new QueryOptions(scanMode, sketchPrefilter, phaseEpsilon, max, maxCandidates, overfetch, exact, timeoutMillis, projection, priority);
+    }
+
+    public QueryOptions withMaxCandidates(int max) {
+        return new QueryOptions(scanMode, sketchPrefilter, phaseEpsilon, maxSegments, max, overfetch, exact, timeoutMillis, projection, priority);
+    }
+
+    public QueryOptions withOverfetch(int factor) {
+        return new QueryOptions(scanMode, sketchPrefilter, phaseEpsilon, maxSegments, maxCandidates, factor, exact, timeoutMillis, projection, priority);
+    }
+
+    public QueryOptions withExact(boolean enabled) {
+        return new QueryOptions(scanMode, sketchPrefilter, phaseEpsilon, maxSegments, maxCandidates, overfetch, enabled, timeoutMillis, projection, priority);
+    }
+
+    public QueryOptions withTimeoutMillis(long millis) {
+        return new QueryOptions(scanMode, sketchPrefilter, phaseEpsilon, maxSegments, maxCandidates, overfetch, exact, millis, projection, priority);
+    }
+
+    public QueryOptions withProjection(Projection p) {
+        return new QueryOptions(scanMode, sketchPrefilter, phaseEpsilon, maxSegments, maxCandidates, overfetch, exact, timeoutMillis, p, priority);
+    }
+
+    public QueryOptions withPriority(Priority p) {
+        return new QueryOptions(scanMode, sketchPrefilter, phaseEpsilon, maxSegments, maxCandidates, overfetch, exact, timeoutMillis, projection, p);
+    }
+
+    private static Projection parseProjection(String raw) {
+        try {
+            return Projection.parse(raw);
+        } catch (IllegalArgumentException e) {
+            return Projection.FULL;
+        }
+    }
+
+    private static Priority parsePriority(String raw) {
+        try {
+            return Priority.valueOf(raw.trim().toUpperCase(Locale.ROOT));
+        } catch (IllegalArgumentException e) {
+            return Priority.INTERACTIVE;
+        }
+    }
+
+    private static ScanMode parseScanMode(String raw) {
+        try {
+            return ScanMode.valueOf(raw.trim().toUpperCase(Locale.ROOT));
+        } catch (IllegalArgumentException e) {
+            return ScanMode.FULL;
+        }
+    }
+}
@@ -8,9 +8,11 @@
  */
 package ai.evacortex.resonancedb.core.engine;
 
+import ai.evacortex.resonancedb.core.math.SignSketch;
 import ai.evacortex.resonancedb.core.storage.responce.ComparisonResult;
 import ai.evacortex.resonancedb.core.storage.WavePattern;
 
+import java.lang.foreign.MemorySegment;
 import java.util.List;
 /**
  * {@code ResonanceKernel} defines the interface for computing similarity between two {@link WavePattern}
@@ -161,4 +163,20 @@ public interface ResonanceKernel {
      */
     ComparisonResult compareWithPhaseDelta(WavePattern a, WavePattern b);
 
+    /**
+     * Hamming distances between {@code querySketch} and each of {@code count} packed sign sketches of
+     * {@code words} longs, as used by the sketch prefilter. Kernels with a vectorised popcount override it.
+     */
+    default int[] hammingMany(long[] querySketch, long[] sketches, int words, int count) {
+        return SignSketch.hammingMany(querySketch, sketches, words, count);
+    }
+
+    /**
+     * As {@link #hammingMany(long[], long[], int, int)}, reading little-endian sketches spaced {@code stride}
+     * longs apart directly from {@code sketches}, e.g. the mapped summary sidecar, without a heap copy.
+     */
+    default int[] hammingMany(long[] querySketch, MemorySegment sketches, int words, int stride, int count) {
+        return SignSketch.hammingMany(querySketch, sketches, words, stride, count);
+    }
+
 }
\ No newline at end of file
@@ -0,0 +1,26 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.exceptions;
+
+import java.util.List;
+
+/** Thrown when a request names corpora that do not exist; {@link #corpusIds()} lists them. */
+public class CorpusNotFoundException extends RuntimeException {
+
+    private final List<String> corpusIds;
+
+    public CorpusNotFoundException(List<String> corpusIds) {
+        super("Corpus not found: " + String.join(", ", corpusIds));
+        this.corpusIds = List.copyOf(corpusIds);
+    }
+
+    public List<String> corpusIds() {
+        return corpusIds;
+    }
+}
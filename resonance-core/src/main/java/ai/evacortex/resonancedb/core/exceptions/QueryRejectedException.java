@@ -0,0 +1,16 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.exceptions;
+
+/** Thrown when query admission control sheds a query instead of queueing it; the caller may retry later. */
+public class QueryRejectedException extends RuntimeException {
+    public QueryRejectedException(String message) {
+        super(message);
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.math;
+
+import ai.evacortex.resonancedb.core.storage.WavePattern;
+
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import java.nio.ByteOrder;
+import java.util.Arrays;
+import java.util.Objects;
+
+/**
+ * 1-bit sign sketch of a wave pattern.
+ *
+ * <p>Each element contributes two bits: the signs of {@code A·cos φ} and {@code A·sin φ}.
+ * The Hamming distance between two sketches tracks the angle between the complex
+ * vectors and therefore the interference term of the resonance score, which makes it
+ * a cheap ranking signal for candidate pruning before exact scoring.</p>
+ */
+public final class SignSketch {
+
+    private SignSketch() {}
+
+    public static int wordsFor(int len) {
+        if (len <= 0) {
+            throw new IllegalArgumentException("len must be > 0, got: " + len);
+        }
+        return (2 * len + 63) >>> 6;
+    }
+
+    public static long[] of(WavePattern pattern) {
+        Objects.requireNonNull(pattern, "pattern must not be null");
+        long[] out = new long[wordsFor(pattern.amplitude().length)];
+        encode(pattern.amplitude(), pattern.phase(), out, 0);
+        return out;
+    }
+
+    public static void encode(double[] amp, double[] phase, long[] dst, int dstOff) {
+        final int len = amp.length;
+        if (phase.length != len) {
+            throw new IllegalArgumentException("Amplitude/phase length mismatch");
+        }
+        final int words = wordsFor(len);
+        Arrays.fill(dst, dstOff, dstOff + words, 0L);
+
+        for (int i = 0; i < len; i++) {
+            double a = amp[i];
+            double p = phase[i];
+            int bit = i << 1;
+            if (a * Math.cos(p) >= 0.0) {
+                dst[dstOff + (bit >>> 6)] |= 1L << (bit & 63);
+            }
+            bit++;
+            if (a * Math.sin(p) >= 0.0) {
+                dst[dstOff + (bit >>> 6)] |= 1L << (bit & 63);
+            }
+        }
+    }
+
+    public static int hamming(long[] a, int aOff, long[] b, int bOff, int words) {
+        int d = 0;
+        for (int w = 0; w < words; w++) {
+            d += Long.bitCount(a[aOff + w] ^ b[bOff + w]);
+        }
+        return d;
+    }
+
+    public static int[] hammingMany(long[] query, long[] all, int words, int count) {
+        Objects.requireNonNull(query, "query must not be null");
+        Objects.requireNonNull(all, "all must not be null");
+        if (query.length < words || (long) words * count > all.length) {
+            throw new IllegalArgumentException("Sketch buffer too small for words=" + words + ", count=" + count);
+        }
+
+        int[] out = new int[count];
+        int off = 0;
+        for (int i = 0; i < count; i++, off += words) {
+            out[i] = hamming(query, 0, all, off, words);
+        }
+        return out;
+    }
+
+    /**
+     * As {@link #hammingMany(long[], long[], int, int)} over little-endian sketches spaced {@code stride}
+     * longs apart in {@code all}.
+     */
+    public static int[] hammingMany(long[] query, MemorySegment all, int words, int stride, int count) {
+        Objects.requireNonNull(query, "query must not be null");
+        Objects.requireNonNull(all, "all must not be null");
+        if (query.length < words || stride < words
+                || (count > 0 && ((long) (count - 1) * stride + words) * Long.BYTES > all.byteSize())) {
+            throw new IllegalArgumentException("Sketch buffer too small for words=" + words + ", count=" + count);
+        }
+
+        ValueLayout.OfLong layout = ValueLayout.JAVA_LONG_UNALIGNED.withOrder(ByteOrder.LITTLE_ENDIAN);
+        int[] out = new int[count];
+        long off = 0;
+        for (int i = 0; i < count; i++, off += stride) {
+            int d = 0;
+            for (int w = 0; w < words; w++) {
+                d += Long.bitCount(query[w] ^ all.getAtIndex(layout, off + w));
+            }
+            out[i] = d;
+        }
+        return out;
+    }
+}
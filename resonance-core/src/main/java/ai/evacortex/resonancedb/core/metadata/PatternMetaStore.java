@@ -18,14 +18,23 @@ import java.nio.file.Files;
 import java.nio.file.Path;
 import java.nio.file.StandardOpenOption;
 import java.util.*;
-import java.util.concurrent.locks.ReentrantReadWriteLock;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicLong;
 
+/**
+ * Metadata per pattern id, persisted as one JSON file.
+ *
+ * <p>Updates go to a concurrent map and become durable on {@link #flush()}. Flushes are
+ * group-committed: concurrent writers share one file write that covers all of their updates.</p>
+ */
 public class PatternMetaStore {
 
     private final Path metaFile;
     private final Map<String, PatternMeta> store;
     private final ObjectMapper mapper;
-    private final ReentrantReadWriteLock rwLock;
+    private final AtomicLong mutations = new AtomicLong();
+    private final Object flushLock = new Object();
+    private long flushedMutations = -1L;
 
     public record PatternMeta(Map<String, String> metadata) {}
 
@@ -35,9 +44,7 @@ public class PatternMetaStore {
             try (InputStream in = Files.newInputStream(path)) {
                 TypeReference<Map<String, PatternMeta>> typeRef = new TypeReference<>() {};
                 Map<String, PatternMeta> loaded = metaStore.mapper.readValue(in, typeRef);
-                synchronized (metaStore.store) {
-                    metaStore.store.putAll(loaded);
-                }
+                metaStore.store.putAll(loaded);
             } catch (IOException e) {
                 throw new RuntimeException("Failed to load metadata store", e);
             }
@@ -48,82 +55,62 @@ public class PatternMetaStore {
     private PatternMetaStore(Path metaFile) {
         this.metaFile = metaFile;
         this.mapper = new ObjectMapper();
-        this.store = Collections.synchronizedMap(new HashMap<>());
-        this.rwLock = new ReentrantReadWriteLock();
+        this.store = new ConcurrentHashMap<>();
     }
 
     public void put(String hashId, Map<String, String> metadata) {
-        rwLock.writeLock().lock();
-        try {
-            store.put(hashId, new PatternMeta(new HashMap<>(metadata)));
-            flush();
-        } finally {
-            rwLock.writeLock().unlock();
-        }
+        store.put(hashId, new PatternMeta(new HashMap<>(metadata)));
+        mutations.incrementAndGet();
     }
 
     public void remove(String hashId) {
-        rwLock.writeLock().lock();
-        try {
-            store.remove(hashId);
-            flush();
-        } finally {
-            rwLock.writeLock().unlock();
-        }
+        store.remove(hashId);
+        mutations.incrementAndGet();
     }
 
     public Map<String, String> getMetadata(String hashId) {
-        rwLock.readLock().lock();
-        try {
-            PatternMeta meta = store.get(hashId);
-            return meta != null ? new HashMap<>(meta.metadata()) : null;
-        } finally {
-            rwLock.readLock().unlock();
-        }
+        PatternMeta meta = store.get(hashId);
+        return meta != null ? new HashMap<>(meta.metadata()) : null;
     }
 
     public boolean contains(String hashId) {
-        rwLock.readLock().lock();
-        try {
-            return store.containsKey(hashId);
-        } finally {
-            rwLock.readLock().unlock();
-        }
+        return store.containsKey(hashId);
     }
 
+    public int size() {
+        return store.size();
+    }
+
+    /** Writes the store; returns without writing if a flush that started after the caller's updates covered them. */
     public void flush() {
-        rwLock.writeLock().lock();
-        try {
-            Files.createDirectories(metaFile.getParent());
-            try (OutputStream out = Files.newOutputStream(metaFile, StandardOpenOption.CREATE, StandardOpenOption.TRUNCATE_EXISTING)) {
-                mapper.writerWithDefaultPrettyPrinter().writeValue(out, store);
+        long target = mutations.get();
+        synchronized (flushLock) {
+            if (flushedMutations >= target) {
+                return;
             }
-        } catch (IOException e) {
-            throw new RuntimeException("Failed to flush metadata store", e);
-        } finally {
-            rwLock.writeLock().unlock();
+            long seq = mutations.get();
+            Map<String, PatternMeta> copy = new TreeMap<>(store);
+            try {
+                Files.createDirectories(metaFile.getParent());
+                try (OutputStream out = Files.newOutputStream(metaFile, StandardOpenOption.CREATE, StandardOpenOption.TRUNCATE_EXISTING)) {
+                    mapper.writerWithDefaultPrettyPrinter().writeValue(out, copy);
+                }
+            } catch (IOException e) {
+                throw new RuntimeException("Failed to flush metadata store", e);
+            }
+            flushedMutations = seq;
         }
     }
 
     public Map<String, PatternMeta> snapshot() {
-        rwLock.readLock().lock();
-        try {
-            Map<String, PatternMeta> copy = new HashMap<>();
-            for (var entry : store.entrySet()) {
-                copy.put(entry.getKey(), new PatternMeta(new HashMap<>(entry.getValue().metadata())));
-            }
-            return copy;
-        } finally {
-            rwLock.readLock().unlock();
+        Map<String, PatternMeta> copy = new HashMap<>();
+        for (var entry : store.entrySet()) {
+            copy.put(entry.getKey(), new PatternMeta(new HashMap<>(entry.getValue().metadata())));
         }
+        return copy;
     }
 
     public Set<String> getAllIds() {
-        rwLock.readLock().lock();
-        try {
-            return new HashSet<>(store.keySet());
-        } finally {
-            rwLock.readLock().unlock();
-        }
+        return new HashSet<>(store.keySet());
     }
 }
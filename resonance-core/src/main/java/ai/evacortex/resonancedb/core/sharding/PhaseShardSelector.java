@@ -23,8 +23,15 @@ public class PhaseShardSelector {
     private final double epsilon;
     private final int totalShards;
     private final boolean useExplicitRanges;
+    private final Map<String, SegmentPhaseHistogram> histograms;
 
     public PhaseShardSelector(Map<Double, String> phaseShardMap, double epsilon) {
+        this(phaseShardMap, epsilon, null);
+    }
+
+    private PhaseShardSelector(Map<Double, String> phaseShardMap,
+                               double epsilon,
+                               Map<String, SegmentPhaseHistogram> histograms) {
         if (phaseShardMap == null || phaseShardMap.isEmpty())
             throw new IllegalArgumentException("Phase shard map must not be null or empty.");
 
@@ -39,6 +46,7 @@ public class PhaseShardSelector {
         this.epsilon = Math.max(0.0, epsilon);
         this.totalShards = phaseShardMap.size();
         this.useExplicitRanges = true;
+        this.histograms = histograms;
     }
 
     public PhaseShardSelector(int totalShards) {
@@ -49,6 +57,7 @@ public class PhaseShardSelector {
         this.epsilon = 0.0;
         this.totalShards = totalShards;
         this.useExplicitRanges = false;
+        this.histograms = null;
     }
 
     public String selectShard(WavePattern pattern) {
@@ -112,6 +121,43 @@ public class PhaseShardSelector {
         return new PhaseShardSelector(map, epsilon);
     }
 
+    /**
+     * Builds a selector from per-segment phase histograms. Segments are centred on their mean phase
+     * for {@link #selectShard}; {@link #getRelevantShards(WavePattern, double)} returns every segment
+     * holding a record within epsilon of the query phase, best estimated score first.
+     */
+    public static PhaseShardSelector fromHistograms(Map<String, SegmentPhaseHistogram> histograms, double epsilon) {
+        return fromHistograms(histograms, epsilon, true);
+    }
+
+    /**
+     * Like {@link #fromHistograms(Map, double)} for histograms that are no longer modified, such as the
+     * copies a corpus snapshot holds; they are used as they are instead of being copied again.
+     */
+    public static PhaseShardSelector fromFrozenHistograms(Map<String, SegmentPhaseHistogram> histograms,
+                                                          double epsilon) {
+        return fromHistograms(histograms, epsilon, false);
+    }
+
+    private static PhaseShardSelector fromHistograms(Map<String, SegmentPhaseHistogram> histograms,
+                                                     double epsilon,
+                                                     boolean copy) {
+        TreeMap<Double, String> map = new TreeMap<>();
+        Map<String, SegmentPhaseHistogram> live = new HashMap<>();
+        for (Map.Entry<String, SegmentPhaseHistogram> e : histograms.entrySet()) {
+            SegmentPhaseHistogram h = copy ? e.getValue().copy() : e.getValue();
+            if (h.total() == 0) continue;
+            live.put(e.getKey(), h);
+            double avg = h.meanPhase();
+            while (map.containsKey(avg)) avg = Math.nextUp(avg);
+            map.put(avg, e.getKey());
+        }
+        if (map.isEmpty()) {
+            return emptyFallback();
+        }
+        return new PhaseShardSelector(map, epsilon, live);
+    }
+
     public static PhaseShardSelector emptyFallback() {
         return new PhaseShardSelector(Map.of(0.0, "phase-0.segment"), Math.PI);
     }
@@ -144,6 +190,10 @@ public class PhaseShardSelector {
         double avg = normalizePhase(Arrays.stream(query.phase()).average().orElse(0.0));
         double eps = Math.max(0.0, customEps);
 
+        if (histograms != null) {
+            return rankByHistogram(query, avg, eps);
+        }
+
         double min = avg - eps;
         double max = avg + eps;
 
@@ -164,6 +214,28 @@ public class PhaseShardSelector {
         return new ArrayList<>(new LinkedHashSet<>(out));
     }
 
+    private List<String> rankByHistogram(WavePattern query, double avg, double eps) {
+        double energy = 0.0;
+        for (double a : query.amplitude()) energy += a * a;
+
+        Map<String, Double> scores = new HashMap<>();
+        for (Map.Entry<String, SegmentPhaseHistogram> e : histograms.entrySet()) {
+            if (e.getValue().minDistance(avg) <= eps) {
+                scores.put(e.getKey(), e.getValue().estimateBestScore(avg, energy));
+            }
+        }
+        if (scores.isEmpty()) {
+            for (Map.Entry<String, SegmentPhaseHistogram> e : histograms.entrySet()) {
+                scores.put(e.getKey(), e.getValue().estimateBestScore(avg, energy));
+            }
+        }
+
+        List<String> out = new ArrayList<>(scores.keySet());
+        out.sort(Comparator.comparingDouble((String s) -> scores.get(s)).reversed()
+                .thenComparing(Comparator.naturalOrder()));
+        return out;
+    }
+
     private static double normalizePhase(double x) {
         double y = x;
         while (y <= -PI) y += TWO_PI;
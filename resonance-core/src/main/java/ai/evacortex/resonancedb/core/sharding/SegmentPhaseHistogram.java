@@ -0,0 +1,148 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.sharding;
+
+/**
+ * Small per-segment sketch of record phase centers and energies.
+ *
+ * <p>Phase centers are counted in fixed bins over {@code (-π, π]}; energies are tracked as a
+ * {@code [min, max]} range. The selector uses it to tell whether a segment holds any record near
+ * the query phase and to rank segments by an estimate of their best achievable score.</p>
+ */
+public final class SegmentPhaseHistogram {
+
+    private static final double PI = Math.PI;
+    private static final double TWO_PI = 2 * Math.PI;
+    private static final int BINS = Math.max(4, Integer.getInteger("resonance.selector.histogramBins", 32));
+
+    private final int[] counts;
+    private int total;
+    private double phaseSum;
+    private double minEnergy = Double.POSITIVE_INFINITY;
+    private double maxEnergy = Double.NEGATIVE_INFINITY;
+    private boolean unknownEnergy;
+
+    public SegmentPhaseHistogram() {
+        this.counts = new int[BINS];
+    }
+
+    private SegmentPhaseHistogram(SegmentPhaseHistogram src) {
+        this.counts = src.counts.clone();
+        this.total = src.total;
+        this.phaseSum = src.phaseSum;
+        this.minEnergy = src.minEnergy;
+        this.maxEnergy = src.maxEnergy;
+        this.unknownEnergy = src.unknownEnergy;
+    }
+
+    /** Records one pattern; pass {@code NaN} when its energy is not known. */
+    public synchronized void add(double phaseCenter, double energy) {
+        double p = normalizePhase(phaseCenter);
+        counts[bin(p)]++;
+        total++;
+        phaseSum += p;
+        if (Double.isNaN(energy)) {
+            unknownEnergy = true;
+        } else {
+            minEnergy = Math.min(minEnergy, energy);
+            maxEnergy = Math.max(maxEnergy, energy);
+        }
+    }
+
+    /** Removes one pattern; the energy range is not narrowed. */
+    public synchronized void remove(double phaseCenter) {
+        double p = normalizePhase(phaseCenter);
+        int b = bin(p);
+        if (counts[b] > 0) {
+            counts[b]--;
+            total--;
+            phaseSum -= p;
+        }
+    }
+
+    /** Replaces the energy range, e.g. with exact values from the segment summary. */
+    public synchronized void setEnergyRange(double min, double max) {
+        this.minEnergy = min;
+        this.maxEnergy = max;
+        this.unknownEnergy = false;
+    }
+
+    public synchronized SegmentPhaseHistogram copy() {
+        return new SegmentPhaseHistogram(this);
+    }
+
+    public synchronized int total() {
+        return total;
+    }
+
+    public synchronized double meanPhase() {
+        return total == 0 ? 0.0 : normalizePhase(phaseSum / total);
+    }
+
+    /** Circular distance from {@code phase} to the nearest non-empty bin, or {@code +∞} if empty. */
+    public synchronized double minDistance(double phase) {
+        double q = normalizePhase(phase);
+        double best = Double.POSITIVE_INFINITY;
+        for (int b = 0; b < counts.length; b++) {
+            if (counts[b] > 0) {
+                best = Math.min(best, distanceToBin(q, b));
+            }
+        }
+        return best;
+    }
+
+    /**
+     * Estimated best score a record of this segment can reach for a query with the given mean phase
+     * and energy: {@code (1 + cos d)/2} for the closest populated bin, scaled by the amplitude factor
+     * {@code 2√(eA·eB)/(eA+eB)} at the record energy closest to the query energy.
+     */
+    public synchronized double estimateBestScore(double queryPhase, double queryEnergy) {
+        double d = minDistance(queryPhase);
+        if (Double.isInfinite(d)) {
+            return 0.0;
+        }
+        return 0.5 * (1.0 + Math.cos(Math.min(d, PI))) * maxAmplitudeFactor(queryEnergy);
+    }
+
+    /**
+     * Largest amplitude factor {@code 2√(eA·eB)/(eA+eB)} a record of this segment can reach against a query
+     * of energy {@code eA}; {@code 1} when the energy range is unknown and {@code 0} for an empty segment.
+     */
+    public synchronized double maxAmplitudeFactor(double queryEnergy) {
+        if (total == 0) {
+            return 0.0;
+        }
+        if (unknownEnergy || minEnergy > maxEnergy || queryEnergy <= 0.0) {
+            return 1.0;
+        }
+        double eB = Math.max(minEnergy, Math.min(maxEnergy, queryEnergy));
+        return eB > 0.0 ? 2.0 * Math.sqrt(queryEnergy * eB) / (queryEnergy + eB) : 0.0;
+    }
+
+    private double distanceToBin(double q, int b) {
+        double lo = -PI + b * (TWO_PI / counts.length);
+        double hi = lo + TWO_PI / counts.length;
+        if (q >= lo && q <= hi) {
+            return 0.0;
+        }
+        return Math.min(Math.abs(normalizePhase(q - lo)), Math.abs(normalizePhase(q - hi)));
+    }
+
+    private int bin(double p) {
+        int b = (int) Math.floor((p + PI) / TWO_PI * counts.length);
+        return Math.max(0, Math.min(counts.length - 1, b));
+    }
+
+    static double normalizePhase(double x) {
+        double y = x;
+        while (y <= -PI) y += TWO_PI;
+        while (y >   PI) y -= TWO_PI;
+        return y;
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.storage;
+
+import ai.evacortex.resonancedb.core.sharding.PhaseShardSelector;
+import ai.evacortex.resonancedb.core.sharding.SegmentPhaseHistogram;
+import ai.evacortex.resonancedb.core.storage.io.CachedReader;
+import ai.evacortex.resonancedb.core.storage.io.SegmentWriter;
+
+import java.util.Collection;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * Immutable view of the corpus that queries read from.
+ *
+ * <p>A snapshot pins one {@link CachedReader} per segment, so the records a query can see are fixed
+ * when the snapshot is published; writers publish a new snapshot instead of changing this one.
+ * The store holds one reference until it replaces the snapshot, each query holds one until it
+ * closes it, and the pinned readers are released when the last reference goes away.</p>
+ */
+final class CorpusSnapshot implements AutoCloseable {
+
+    private final long version;
+    private final List<SegmentWriter> writers;
+    private final Map<String, CachedReader> readers;
+    private final Map<String, SegmentPhaseHistogram> histograms;
+    private final PhaseShardSelector selector;
+    private final AtomicInteger refs = new AtomicInteger(1);
+
+    /** Takes ownership of one acquired reference on each reader. */
+    CorpusSnapshot(long version,
+                   List<SegmentWriter> writers,
+                   Map<String, CachedReader> readers,
+                   Map<String, SegmentPhaseHistogram> histograms,
+                   PhaseShardSelector selector) {
+        this.version = version;
+        this.writers = List.copyOf(writers);
+        this.readers = Map.copyOf(readers);
+        this.histograms = Map.copyOf(histograms);
+        this.selector = selector;
+    }
+
+    long version() {
+        return version;
+    }
+
+    List<SegmentWriter> writers() {
+        return writers;
+    }
+
+    /** Reader pinned for {@code segmentName}, or {@code null} if the segment was empty or unreadable. */
+    CachedReader reader(String segmentName) {
+        return readers.get(segmentName);
+    }
+
+    Collection<CachedReader> readers() {
+        return readers.values();
+    }
+
+    SegmentPhaseHistogram histogram(String segmentName) {
+        return histograms.get(segmentName);
+    }
+
+    PhaseShardSelector selector() {
+        return selector;
+    }
+
+    /** Adds a reference; fails once the last reference has been closed. */
+    boolean retain() {
+        int cur;
+        do {
+            cur = refs.get();
+            if (cur <= 0) {
+                return false;
+            }
+        } while (!refs.compareAndSet(cur, cur + 1));
+        return true;
+    }
+
+    @Override
+    public void close() {
+        if (refs.decrementAndGet() == 0) {
+            readers.values().forEach(CachedReader::release);
+        }
+    }
+}
@@ -9,16 +9,26 @@
 package ai.evacortex.resonancedb.core.storage;
 
 import ai.evacortex.resonancedb.core.corpus.CorpusInfo;
+import ai.evacortex.resonancedb.core.corpus.CorpusReadiness;
 import ai.evacortex.resonancedb.core.corpus.CorpusService;
 import ai.evacortex.resonancedb.core.corpus.CorpusSpec;
 import ai.evacortex.resonancedb.core.corpus.CorpusState;
 import ai.evacortex.resonancedb.core.ResonanceStore;
+import ai.evacortex.resonancedb.core.engine.QueryOptions;
+import ai.evacortex.resonancedb.core.exceptions.CorpusNotFoundException;
 import ai.evacortex.resonancedb.core.exceptions.PatternNotFoundException;
 import ai.evacortex.resonancedb.core.storage.io.SegmentReader;
+import ai.evacortex.resonancedb.core.storage.responce.AdmissionStats;
+import ai.evacortex.resonancedb.core.storage.responce.CorpusMatch;
 import ai.evacortex.resonancedb.core.storage.responce.InterferenceEntry;
 import ai.evacortex.resonancedb.core.storage.responce.InterferenceMap;
+import ai.evacortex.resonancedb.core.storage.responce.MemoryStats;
+import ai.evacortex.resonancedb.core.storage.responce.QueryCacheStats;
+import ai.evacortex.resonancedb.core.storage.responce.QueryPage;
+import ai.evacortex.resonancedb.core.storage.responce.QueryResult;
 import ai.evacortex.resonancedb.core.storage.responce.ResonanceMatch;
 import ai.evacortex.resonancedb.core.storage.responce.ResonanceMatchDetailed;
+import ai.evacortex.resonancedb.core.storage.responce.ThresholdResult;
 import com.fasterxml.jackson.databind.ObjectMapper;
 
 import java.io.Closeable;
@@ -29,6 +39,7 @@ import java.nio.file.*;
 import java.nio.file.attribute.FileTime;
 import java.time.Instant;
 import java.util.*;
+import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.ConcurrentMap;
 import java.util.concurrent.ScheduledFuture;
@@ -37,6 +48,8 @@ import java.util.concurrent.atomic.AtomicBoolean;
 import java.util.concurrent.atomic.AtomicInteger;
 import java.util.concurrent.atomic.AtomicLong;
 import java.util.concurrent.locks.ReentrantLock;
+import java.util.function.Consumer;
+import java.util.function.Supplier;
 import java.util.stream.Collectors;
 import java.util.stream.Stream;
 
@@ -164,6 +177,83 @@ public final class FileSystemCorpusService implements CorpusService, Closeable {
         return List.copyOf(out);
     }
 
+    @Override
+    public QueryResult<CorpusMatch> queryMany(List<String> corpusIds, WavePattern query, int topK, QueryOptions options) {
+        Objects.requireNonNull(corpusIds, "corpusIds must not be null");
+        ensureOpen();
+        ensureStorageRoots();
+
+        Set<String> ids = new LinkedHashSet<>();
+        for (String corpusId : corpusIds) {
+            ids.add(CorpusService.normalizeCorpusId(corpusId));
+        }
+        List<String> missing = new ArrayList<>();
+        for (String id : ids) {
+            CorpusSlot slot = slots.get(id);
+            if ((slot == null || !slot.existsOnDisk()) && !existsOnDisk(id)) {
+                missing.add(id);
+            }
+        }
+        if (!missing.isEmpty()) {
+            throw new CorpusNotFoundException(missing);
+        }
+
+        List<CorpusSlot> accessed = new ArrayList<>(ids.size());
+        try {
+            Map<String, WavePatternStoreImpl> stores = new LinkedHashMap<>();
+            for (String id : ids) {
+                CorpusSlot slot = slots.computeIfAbsent(id, CorpusSlot::new);
+                slot.beginAccess();
+                accessed.add(slot);
+                WavePatternStoreImpl store = slot.openForRead();
+                if (store == null) {
+                    missing.add(id);
+                } else {
+                    stores.put(id, store);
+                }
+            }
+            if (!missing.isEmpty()) {
+                throw new CorpusNotFoundException(missing);
+            }
+            return WavePatternStoreImpl.queryMany(stores, query, topK, options);
+        } finally {
+            for (CorpusSlot slot : accessed) {
+                slot.endAccess();
+            }
+        }
+    }
+
+    @Override
+    public CompletableFuture<QueryResult<CorpusMatch>> queryManyAsync(List<String> corpusIds,
+                                                                      WavePattern query,
+                                                                      int topK,
+                                                                      QueryOptions options) {
+        return WavePatternStoreImpl.submitAsync(runtime.queryPool(),
+                () -> queryMany(corpusIds, query, topK, options), false);
+    }
+
+    @Override
+    public AdmissionStats admissionStats() {
+        return runtime.admission().stats();
+    }
+
+    @Override
+    public MemoryStats memoryStats() {
+        return runtime.memory().stats();
+    }
+
+    @Override
+    public List<CorpusReadiness> readiness() {
+        List<CorpusReadiness> out = new ArrayList<>();
+        for (CorpusSlot slot : new TreeMap<>(slots).values()) {
+            CorpusReadiness readiness = slot.readiness();
+            if (readiness != null) {
+                out.add(readiness);
+            }
+        }
+        return List.copyOf(out);
+    }
+
     @Override
     public void close() {
         if (!closed.compareAndSet(false, true)) {
@@ -174,6 +264,7 @@ public final class FileSystemCorpusService implements CorpusService, Closeable {
 
         List<CorpusSlot> openSlots = new ArrayList<>(slots.values());
         for (CorpusSlot slot : openSlots) {
+            runtime.memory().unregister(slot);
             slot.closeOpenStore();
         }
 
@@ -238,8 +329,10 @@ public final class FileSystemCorpusService implements CorpusService, Closeable {
 
             int openCount = open.size();
 
+            // With a memory budget, corpora are evicted by the bytes they hold rather than by count.
+            boolean countCapped = !runtime.memory().enabled();
             for (CorpusSlot slot : open) {
-                boolean overCapacity = openCount > maxOpenCorpora;
+                boolean overCapacity = countCapped && openCount > maxOpenCorpora;
                 boolean idleExpired = slot.lastAccessNanos() < idleBefore;
 
                 if ((overCapacity || idleExpired) && slot.tryEvict()) {
@@ -476,7 +569,7 @@ public final class FileSystemCorpusService implements CorpusService, Closeable {
                 || Files.exists(dbRoot.resolve(LEGACY_METADATA));
     }
 
-    private final class CorpusSlot {
+    private final class CorpusSlot implements MemoryGovernor.Tenant {
         private final String corpusId;
         private final ReentrantLock lock = new ReentrantLock();
         private final AtomicInteger activeOps = new AtomicInteger();
@@ -489,6 +582,29 @@ public final class FileSystemCorpusService implements CorpusService, Closeable {
 
         private CorpusSlot(String corpusId) {
             this.corpusId = corpusId;
+            runtime.memory().register(this);
+        }
+
+        @Override
+        public String name() {
+            return corpusId;
+        }
+
+        @Override
+        public MemoryGovernor.Footprint footprint() {
+            WavePatternStoreImpl local = store;
+            return local != null ? local.memoryFootprint() : MemoryGovernor.Footprint.ZERO;
+        }
+
+        @Override
+        public long trim(long bytes) {
+            WavePatternStoreImpl local = store;
+            return local != null ? local.trimMemory(bytes) : 0L;
+        }
+
+        @Override
+        public boolean evict() {
+            return isOpen() && tryEvict();
         }
 
         private CorpusInfo peekInfo() {
@@ -515,7 +631,22 @@ public final class FileSystemCorpusService implements CorpusService, Closeable {
             return store != null;
         }
 
-        private long lastAccessNanos() {
+        /** Warm-up state of the open store; {@code null} while the corpus is closed. */
+        private CorpusReadiness readiness() {
+            WavePatternStoreImpl local = store;
+            if (local == null) {
+                return lastOpenFailure != null
+                        ? new CorpusReadiness(corpusId, CorpusReadiness.Phase.FAILED, 0, 0)
+                        : null;
+            }
+            CorpusReadiness.Phase phase = local.isReady() ? CorpusReadiness.Phase.READY
+                    : local.isWarmupFailed() ? CorpusReadiness.Phase.FAILED
+                    : CorpusReadiness.Phase.WARMING;
+            return new CorpusReadiness(corpusId, phase, local.warmedSegments(), local.warmupSegments());
+        }
+
+        @Override
+        public long lastAccessNanos() {
             return lastAccessNanos.get();
         }
 
@@ -782,6 +913,43 @@ public final class FileSystemCorpusService implements CorpusService, Closeable {
             }
         }
 
+        @Override
+        public List<ResonanceMatch> query(WavePattern query, int topK, QueryOptions options) {
+            slot.beginAccess();
+            try {
+                WavePatternStoreImpl store = slot.openForRead();
+                return store == null ? List.of() : store.query(query, topK, options);
+            } finally {
+                slot.endAccess();
+            }
+        }
+
+        @Override
+        public QueryResult<ResonanceMatch> queryResult(WavePattern query, int topK, QueryOptions options) {
+            slot.beginAccess();
+            try {
+                WavePatternStoreImpl store = slot.openForRead();
+                return store == null
+                        ? new QueryResult<>(List.of(), options, 0, 0L, false)
+                        : store.queryResult(query, topK, options);
+            } finally {
+                slot.endAccess();
+            }
+        }
+
+        @Override
+        public List<List<ResonanceMatch>> queryBatch(List<WavePattern> queries, int topK) {
+            slot.beginAccess();
+            try {
+                WavePatternStoreImpl store = slot.openForRead();
+                return store == null
+                        ? Collections.nCopies(queries.size(), List.of())
+                        : store.queryBatch(queries, topK);
+            } finally {
+                slot.endAccess();
+            }
+        }
+
         @Override
         public List<ResonanceMatchDetailed> queryDetailed(WavePattern query, int topK) {
             slot.beginAccess();
@@ -793,6 +961,30 @@ public final class FileSystemCorpusService implements CorpusService, Closeable {
             }
         }
 
+        @Override
+        public List<ResonanceMatchDetailed> queryDetailed(WavePattern query, int topK, QueryOptions options) {
+            slot.beginAccess();
+            try {
+                WavePatternStoreImpl store = slot.openForRead();
+                return store == null ? List.of() : store.queryDetailed(query, topK, options);
+            } finally {
+                slot.endAccess();
+            }
+        }
+
+        @Override
+        public QueryResult<ResonanceMatchDetailed> queryDetailedResult(WavePattern query, int topK, QueryOptions options) {
+            slot.beginAccess();
+            try {
+                WavePatternStoreImpl store = slot.openForRead();
+                return store == null
+                        ? new QueryResult<>(List.of(), options, 0, 0L, false)
+                        : store.queryDetailedResult(query, topK, options);
+            } finally {
+                slot.endAccess();
+            }
+        }
+
         @Override
         public InterferenceMap queryInterference(WavePattern query, int topK) {
             slot.beginAccess();
@@ -838,6 +1030,176 @@ public final class FileSystemCorpusService implements CorpusService, Closeable {
                 slot.endAccess();
             }
         }
+
+        @Override
+        public QueryPage<ResonanceMatch> queryPage(WavePattern query, int pageSize, String cursor, QueryOptions options) {
+            slot.beginAccess();
+            try {
+                WavePatternStoreImpl store = slot.openForRead();
+                return store == null
+                        ? new QueryPage<>(List.of(), null, options, 0L, false)
+                        : store.queryPage(query, pageSize, cursor, options);
+            } finally {
+                slot.endAccess();
+            }
+        }
+
+        @Override
+        public ThresholdResult queryThreshold(WavePattern query,
+                                              float minEnergy,
+                                              QueryOptions options,
+                                              Consumer<? super ResonanceMatch> sink) {
+            slot.beginAccess();
+            try {
+                WavePatternStoreImpl store = slot.openForRead();
+                return store == null
+                        ? new ThresholdResult(0L, options, 0, 0L, false)
+                        : store.queryThreshold(query, minEnergy, options, sink);
+            } finally {
+                slot.endAccess();
+            }
+        }
+
+        @Override
+        public WavePattern getPattern(String id) {
+            slot.beginAccess();
+            try {
+                WavePatternStoreImpl store = slot.openForRead();
+                if (store == null) {
+                    throw new PatternNotFoundException(id);
+                }
+                return store.getPattern(id);
+            } finally {
+                slot.endAccess();
+            }
+        }
+
+        @Override
+        public Map<String, String> getMetadata(String id) {
+            slot.beginAccess();
+            try {
+                WavePatternStoreImpl store = slot.openForRead();
+                if (store == null) {
+                    throw new PatternNotFoundException(id);
+                }
+                return store.getMetadata(id);
+            } finally {
+                slot.endAccess();
+            }
+        }
+
+        @Override
+        public QueryCacheStats queryCacheStats() {
+            slot.beginAccess();
+            try {
+                WavePatternStoreImpl store = slot.openForRead();
+                return store == null
+                        ? new QueryCacheStats(0L, 0L, 0L, 0.0, 0L, 0L, 0L)
+                        : store.queryCacheStats();
+            } finally {
+                slot.endAccess();
+            }
+        }
+
+        @Override
+        public CompletableFuture<String> insertAsync(WavePattern psi, Map<String, String> metadata) {
+            return tracked(() -> slot.openForWrite(psi)
+                    .insertAsync(psi, metadata == null ? Map.of() : metadata)
+                    .thenApply(id -> {
+                        slot.afterInsert();
+                        return id;
+                    }));
+        }
+
+        @Override
+        public CompletableFuture<Void> deleteAsync(String id) {
+            return tracked(() -> {
+                WavePatternStoreImpl store = slot.openForRead();
+                if (store == null) {
+                    throw new PatternNotFoundException(id);
+                }
+                return store.deleteAsync(id).thenRun(slot::afterDelete);
+            });
+        }
+
+        @Override
+        public CompletableFuture<String> replaceAsync(String id, WavePattern psi, Map<String, String> metadata) {
+            return tracked(() -> {
+                WavePatternStoreImpl store = slot.openForRead();
+                if (store == null) {
+                    throw new PatternNotFoundException(id);
+                }
+                return store.replaceAsync(id, psi, metadata == null ? Map.of() : metadata)
+                        .thenApply(newId -> {
+                            slot.afterReplace();
+                            return newId;
+                        });
+            });
+        }
+
+        @Override
+        public CompletableFuture<List<ResonanceMatch>> queryAsync(WavePattern query, int topK, QueryOptions options) {
+            return tracked(() -> {
+                WavePatternStoreImpl store = slot.openForRead();
+                return store == null
+                        ? CompletableFuture.completedFuture(List.of())
+                        : store.queryAsync(query, topK, options);
+            });
+        }
+
+        @Override
+        public CompletableFuture<QueryResult<ResonanceMatch>> queryResultAsync(WavePattern query, int topK, QueryOptions options) {
+            return tracked(() -> {
+                WavePatternStoreImpl store = slot.openForRead();
+                return store == null
+                        ? CompletableFuture.completedFuture(new QueryResult<>(List.of(), options, 0, 0L, false))
+                        : store.queryResultAsync(query, topK, options);
+            });
+        }
+
+        @Override
+        public CompletableFuture<List<List<ResonanceMatch>>> queryBatchAsync(List<WavePattern> queries, int topK) {
+            return tracked(() -> {
+                WavePatternStoreImpl store = slot.openForRead();
+                return store == null
+                        ? CompletableFuture.completedFuture(Collections.nCopies(queries.size(), List.of()))
+                        : store.queryBatchAsync(queries, topK);
+            });
+        }
+
+        @Override
+        public CompletableFuture<QueryResult<ResonanceMatchDetailed>> queryDetailedResultAsync(WavePattern query,
+                                                                                              int topK,
+                                                                                              QueryOptions options) {
+            return tracked(() -> {
+                WavePatternStoreImpl store = slot.openForRead();
+                return store == null
+                        ? CompletableFuture.completedFuture(new QueryResult<>(List.of(), options, 0, 0L, false))
+                        : store.queryDetailedResultAsync(query, topK, options);
+            });
+        }
+
+        /**
+         * Keeps the slot marked active until the returned future completes, so the idle sweep cannot close
+         * the store under a running call. Query futures are returned as-is so that cancelling them reaches
+         * the scan.
+         */
+        private <T> CompletableFuture<T> tracked(Supplier<CompletableFuture<T>> call) {
+            CompletableFuture<T> pending;
+            try {
+                slot.beginAccess();
+            } catch (RuntimeException e) {
+                return CompletableFuture.failedFuture(e);
+            }
+            try {
+                pending = call.get();
+            } catch (RuntimeException e) {
+                slot.endAccess();
+                return CompletableFuture.failedFuture(e);
+            }
+            pending.whenComplete((value, error) -> slot.endAccess());
+            return pending;
+        }
     }
 
     /**
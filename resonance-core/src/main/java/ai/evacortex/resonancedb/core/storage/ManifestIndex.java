@@ -17,6 +17,7 @@ import java.nio.file.Path;
 import java.nio.file.StandardCopyOption;
 import java.util.*;
 import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicLong;
 import java.util.concurrent.locks.ReadWriteLock;
 import java.util.concurrent.locks.ReentrantReadWriteLock;
 
@@ -27,6 +28,9 @@ public class ManifestIndex implements Closeable {
     private final Map<String, PatternLocation> map;
     private final Set<String> knownSegments;
     private final ReadWriteLock lock = new ReentrantReadWriteLock();
+    private final AtomicLong mutations = new AtomicLong();
+    private final Object flushLock = new Object();
+    private long flushedMutations = -1L;
 
     private ManifestIndex(Path indexFile) {
         this.indexFile = indexFile;
@@ -68,6 +72,7 @@ public class ManifestIndex implements Closeable {
         try {
             map.put(id, new PatternLocation(segment, offset, phaseCenter));
             knownSegments.add(segment);
+            mutations.incrementAndGet();
         } finally {
             lock.writeLock().unlock();
         }
@@ -76,7 +81,19 @@ public class ManifestIndex implements Closeable {
     public void registerSegmentIfAbsent(String segmentName) {
         lock.writeLock().lock();
         try {
-            knownSegments.add(segmentName);
+            if (knownSegments.add(segmentName)) {
+                mutations.incrementAndGet();
+            }
+        } finally {
+            lock.writeLock().unlock();
+        }
+    }
+
+    public void unregisterSegment(String segmentName) {
+        lock.writeLock().lock();
+        try {
+            knownSegments.remove(segmentName);
+            mutations.incrementAndGet();
         } finally {
             lock.writeLock().unlock();
         }
@@ -87,6 +104,7 @@ public class ManifestIndex implements Closeable {
         try {
             if (!map.containsKey(id)) throw new PatternNotFoundException(id);
             map.remove(id);
+            mutations.incrementAndGet();
         } finally {
             lock.writeLock().unlock();
         }
@@ -105,6 +123,10 @@ public class ManifestIndex implements Closeable {
         return map.containsKey(id);
     }
 
+    public int size() {
+        return map.size();
+    }
+
     public Set<String> getAllSegmentNames() {
         lock.readLock().lock();
         try {
@@ -127,12 +149,46 @@ public class ManifestIndex implements Closeable {
         }
     }
 
-    public void flush() {
-        lock.writeLock().lock();
+    /** Entries whose record lives in one of {@code segments}, by id. */
+    public Map<String, PatternLocation> locationsIn(Set<String> segments) {
+        lock.readLock().lock();
         try {
-            persistToFile();
+            Map<String, PatternLocation> result = new HashMap<>();
+            map.forEach((id, loc) -> {
+                if (segments.contains(loc.segmentName())) {
+                    result.put(id, loc);
+                }
+            });
+            return result;
         } finally {
-            lock.writeLock().unlock();
+            lock.readLock().unlock();
+        }
+    }
+
+    /**
+     * Persists the index. Flushes are group-committed: the state is copied under the read lock and
+     * written outside it, and a caller whose changes were covered by a flush that started after them
+     * returns without writing the file again.
+     */
+    public void flush() {
+        long target = mutations.get();
+        synchronized (flushLock) {
+            if (flushedMutations >= target) {
+                return;
+            }
+            long seq;
+            List<String> segments;
+            List<Map.Entry<String, PatternLocation>> entries;
+            lock.readLock().lock();
+            try {
+                seq = mutations.get();
+                segments = new ArrayList<>(knownSegments);
+                entries = map.entrySet().stream().map(e -> Map.entry(e.getKey(), e.getValue())).toList();
+            } finally {
+                lock.readLock().unlock();
+            }
+            persistToFile(segments, entries);
+            flushedMutations = seq;
         }
     }
 
@@ -141,19 +197,18 @@ public class ManifestIndex implements Closeable {
         flush();
     }
 
-    private void persistToFile() {
-        lock.readLock().lock();
+    private void persistToFile(List<String> segments, List<Map.Entry<String, PatternLocation>> entries) {
         try {
             Files.createDirectories(indexFile.getParent());
             Path tmp = indexFile.resolveSibling(indexFile.getFileName().toString() + ".tmp");
             try (DataOutputStream out = new DataOutputStream(new BufferedOutputStream(Files.newOutputStream(tmp)))) {
-                out.writeInt(knownSegments.size());
-                for (String seg : knownSegments) {
+                out.writeInt(segments.size());
+                for (String seg : segments) {
                     out.writeUTF(seg);
                 }
 
-                out.writeInt(map.size());
-                for (Map.Entry<String, PatternLocation> e : map.entrySet()) {
+                out.writeInt(entries.size());
+                for (Map.Entry<String, PatternLocation> e : entries) {
                     out.writeUTF(e.getKey());
                     PatternLocation loc = e.getValue();
                     out.writeUTF(loc.segmentName());
@@ -171,8 +226,6 @@ public class ManifestIndex implements Closeable {
         } catch (IOException e) {
             System.err.printf("Manifest flush failed: %s%n", e);
             throw new RuntimeException("Failed to write manifest index", e);
-        } finally {
-            lock.readLock().unlock();
         }
     }
 
@@ -203,6 +256,7 @@ public class ManifestIndex implements Closeable {
             }
 
             map.put(id, new PatternLocation(newSegment, newOffset, newPhaseCenter));
+            mutations.incrementAndGet();
         } finally {
             lock.writeLock().unlock();
         }
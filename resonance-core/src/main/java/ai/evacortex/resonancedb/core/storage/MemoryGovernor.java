@@ -0,0 +1,160 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.storage;
+
+import ai.evacortex.resonancedb.core.storage.responce.MemoryStats;
+
+import java.util.*;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.LongAdder;
+import java.util.concurrent.locks.ReentrantLock;
+
+/**
+ * Process-wide byte budget for all open corpora.
+ *
+ * <p>Every open corpus, and the query scratch shared by all of them, is a {@link Tenant} that reports
+ * its {@link Footprint}: heap structures such as manifest entries, reader indexes and query caches,
+ * per-thread scan buffers, and the bytes of its mapped segments that are resident in the page cache.
+ * When the total exceeds the budget, {@link #rebalance()} reclaims the excess in cost/benefit order —
+ * tenants holding the most bytes for the longest idle time first. It trims rebuildable state before it
+ * evicts anything; only when trimming falls short are whole idle corpora closed, which unmaps their
+ * segments. A budget of {@code 0} disables reclamation but keeps the accounting.</p>
+ */
+public final class MemoryGovernor {
+
+    /** Accounted bytes of one tenant. */
+    public record Footprint(long heapBytes, long scratchBytes, long mappedBytes) {
+        public static final Footprint ZERO = new Footprint(0L, 0L, 0L);
+
+        public long total() {
+            return heapBytes + scratchBytes + mappedBytes;
+        }
+    }
+
+    public interface Tenant {
+
+        String name();
+
+        Footprint footprint();
+
+        /** Last time the tenant served a request; recently used tenants are reclaimed last. */
+        long lastAccessNanos();
+
+        /** Drops rebuildable state worth up to {@code bytes}; returns how many bytes were released. */
+        long trim(long bytes);
+
+        /** Releases everything the tenant holds; returns {@code false} if it is in use or cannot be evicted. */
+        boolean evict();
+    }
+
+    private record Candidate(Tenant tenant, double score) {}
+
+    private final long budgetBytes;
+    private final Set<Tenant> tenants = ConcurrentHashMap.newKeySet();
+    private final ReentrantLock rebalanceLock = new ReentrantLock();
+    private final LongAdder trimmedBytes = new LongAdder();
+    private final LongAdder evictions = new LongAdder();
+
+    public MemoryGovernor(long budgetBytes) {
+        this.budgetBytes = Math.max(0L, budgetBytes);
+    }
+
+    static MemoryGovernor fromSystemProperties() {
+        return new MemoryGovernor(Long.getLong("resonance.memory.budgetBytes", 0L));
+    }
+
+    public boolean enabled() {
+        return budgetBytes > 0;
+    }
+
+    public long budgetBytes() {
+        return budgetBytes;
+    }
+
+    public void register(Tenant tenant) {
+        tenants.add(Objects.requireNonNull(tenant, "tenant must not be null"));
+    }
+
+    public void unregister(Tenant tenant) {
+        tenants.remove(tenant);
+    }
+
+    /**
+     * Reclaims memory until the accounted total fits the budget or nothing more can be released;
+     * returns the bytes released. Concurrent calls are skipped rather than queued.
+     */
+    public long rebalance() {
+        if (!enabled() || !rebalanceLock.tryLock()) {
+            return 0L;
+        }
+        try {
+            long now = System.nanoTime();
+            long used = 0L;
+            List<Candidate> candidates = new ArrayList<>(tenants.size());
+            for (Tenant tenant : tenants) {
+                long bytes = tenant.footprint().total();
+                used += bytes;
+                candidates.add(new Candidate(tenant, score(bytes, now - tenant.lastAccessNanos())));
+            }
+            long excess = used - budgetBytes;
+            if (excess <= 0) {
+                return 0L;
+            }
+            candidates.sort(Comparator.comparingDouble(Candidate::score).reversed());
+
+            long released = 0L;
+            for (Candidate c : candidates) {
+                if (released >= excess) {
+                    break;
+                }
+                long freed = c.tenant().trim(excess - released);
+                if (freed > 0) {
+                    released += freed;
+                    trimmedBytes.add(freed);
+                }
+            }
+            for (Candidate c : candidates) {
+                if (released >= excess) {
+                    break;
+                }
+                long held = c.tenant().footprint().total();
+                if (held > 0 && c.tenant().evict()) {
+                    released += held;
+                    evictions.increment();
+                }
+            }
+            return released;
+        } finally {
+            rebalanceLock.unlock();
+        }
+    }
+
+    public MemoryStats stats() {
+        long heap = 0L;
+        long scratch = 0L;
+        long mapped = 0L;
+        Map<String, Long> byTenant = new TreeMap<>();
+        for (Tenant tenant : tenants) {
+            Footprint f = tenant.footprint();
+            heap += f.heapBytes();
+            scratch += f.scratchBytes();
+            mapped += f.mappedBytes();
+            if (f.total() > 0) {
+                byTenant.merge(tenant.name(), f.total(), Long::sum);
+            }
+        }
+        return new MemoryStats(budgetBytes, heap + scratch + mapped, heap, scratch, mapped,
+                Collections.unmodifiableMap(byTenant), trimmedBytes.sum(), evictions.sum());
+    }
+
+    /** Benefit of reclaiming a tenant: its bytes, weighted up by how long it has gone unused. */
+    private static double score(long bytes, long idleNanos) {
+        return bytes * (1.0 + Math.max(0L, idleNanos) / 1e9);
+    }
+}
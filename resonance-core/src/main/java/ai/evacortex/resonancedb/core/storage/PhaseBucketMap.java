@@ -0,0 +1,206 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.storage;
+
+import com.fasterxml.jackson.databind.ObjectMapper;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.nio.file.AtomicMoveNotSupportedException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.util.*;
+
+/**
+ * Persistent map from mean-phase ranges to segment groups.
+ *
+ * <p>The ranges tile {@code [-π, π]} without gaps. A fresh map reproduces the fixed
+ * {@code phase-<bucket>} layout, so existing databases keep their group names; ranges
+ * created later by {@link #split} and {@link #merge} get {@code phase-a<n>} names.</p>
+ */
+public final class PhaseBucketMap {
+
+    public record Range(double lo, double hi, String group) {
+        public double width() {
+            return hi - lo;
+        }
+    }
+
+    private record State(long nextId, List<Range> ranges) {}
+
+    private final Path file;
+    private final ObjectMapper mapper = new ObjectMapper();
+    private final NavigableMap<Double, Range> byLo = new TreeMap<>();
+    private long nextId;
+
+    private PhaseBucketMap(Path file) {
+        this.file = file;
+    }
+
+    public static PhaseBucketMap loadOrCreate(Path file, double bucketWidth) {
+        PhaseBucketMap map = new PhaseBucketMap(file);
+        if (Files.exists(file)) {
+            try (InputStream in = Files.newInputStream(file)) {
+                State state = map.mapper.readValue(in, State.class);
+                map.nextId = state.nextId();
+                for (Range r : state.ranges()) {
+                    map.byLo.put(r.lo(), r);
+                }
+                map.validate();
+                return map;
+            } catch (IOException | RuntimeException e) {
+                System.err.println("Ignoring unreadable bucket map " + file + ": " + e.getMessage());
+                map.byLo.clear();
+            }
+        }
+
+        int buckets = (int) Math.ceil((2 * Math.PI) / bucketWidth);
+        for (int i = 0; i < buckets; i++) {
+            double lo = i == 0 ? -Math.PI : -Math.PI + i * bucketWidth;
+            double hi = i == buckets - 1 ? Math.PI : -Math.PI + (i + 1) * bucketWidth;
+            map.byLo.put(lo, new Range(lo, hi, "phase-" + i));
+        }
+        map.nextId = 0;
+        return map;
+    }
+
+    public synchronized String groupFor(double phaseCenter) {
+        return rangeFor(phaseCenter).group();
+    }
+
+    public synchronized Range rangeFor(double phaseCenter) {
+        Map.Entry<Double, Range> e = byLo.floorEntry(phaseCenter);
+        return e != null ? e.getValue() : byLo.firstEntry().getValue();
+    }
+
+    public synchronized Range rangeOf(String group) {
+        for (Range r : byLo.values()) {
+            if (r.group().equals(group)) {
+                return r;
+            }
+        }
+        return null;
+    }
+
+    public synchronized List<Range> ranges() {
+        return List.copyOf(byLo.values());
+    }
+
+    /** Neighbour to the right of {@code range}, or {@code null} for the last range. */
+    public synchronized Range next(Range range) {
+        Map.Entry<Double, Range> e = byLo.higherEntry(range.lo());
+        return e != null ? e.getValue() : null;
+    }
+
+    /** Splits the range owned by {@code group} at {@code at}; returns the two new ranges. */
+    public synchronized List<Range> split(String group, double at) {
+        Range r = rangeOf(group);
+        List<Range> halves = planSplit(group, at);
+        replace(List.of(r), halves);
+        return halves;
+    }
+
+    /** Merges two adjacent ranges into one new range. */
+    public synchronized Range merge(Range left, Range right) {
+        Range merged = planMerge(List.of(left, right));
+        replace(List.of(left, right), List.of(merged));
+        return merged;
+    }
+
+    /**
+     * The two ranges {@link #split} would create, under freshly reserved group names, without changing
+     * the map; {@link #replace} installs them.
+     */
+    public synchronized List<Range> planSplit(String group, double at) {
+        Range r = rangeOf(group);
+        if (r == null || !(at > r.lo() && at < r.hi())) {
+            throw new IllegalArgumentException("Cannot split " + group + " at " + at);
+        }
+        return List.of(new Range(r.lo(), at, newGroupName()), new Range(at, r.hi(), newGroupName()));
+    }
+
+    /** The range merging the adjacent {@code run} would create, without changing the map. */
+    public synchronized Range planMerge(List<Range> run) {
+        for (int i = 0; i < run.size(); i++) {
+            Range r = run.get(i);
+            if (!r.equals(byLo.get(r.lo())) || (i > 0 && run.get(i - 1).hi() != r.lo())) {
+                throw new IllegalArgumentException("Ranges are not adjacent: " + run);
+            }
+        }
+        return new Range(run.getFirst().lo(), run.getLast().hi(), newGroupName());
+    }
+
+    /**
+     * Replaces the adjacent {@code sources} by {@code targets}, which must tile the same interval.
+     *
+     * @throws IllegalArgumentException if a source is no longer in the map or the targets leave a gap
+     */
+    public synchronized void replace(List<Range> sources, List<Range> targets) {
+        double expected = sources.getFirst().lo();
+        for (Range r : sources) {
+            if (r.lo() != expected || !r.equals(byLo.get(r.lo()))) {
+                throw new IllegalArgumentException("Ranges are not current and adjacent: " + sources);
+            }
+            expected = r.hi();
+        }
+        double end = expected;
+        expected = sources.getFirst().lo();
+        for (Range r : targets) {
+            if (r.lo() != expected || r.hi() <= r.lo()) {
+                throw new IllegalArgumentException("Ranges " + targets + " do not tile " + sources);
+            }
+            expected = r.hi();
+        }
+        if (expected != end) {
+            throw new IllegalArgumentException("Ranges " + targets + " do not tile " + sources);
+        }
+        sources.forEach(r -> byLo.remove(r.lo()));
+        targets.forEach(r -> byLo.put(r.lo(), r));
+    }
+
+    public synchronized void flush() {
+        try {
+            Files.createDirectories(file.getParent());
+            Path tmp = file.resolveSibling(file.getFileName().toString() + ".tmp");
+            try (OutputStream out = Files.newOutputStream(tmp)) {
+                mapper.writerWithDefaultPrettyPrinter().writeValue(out, new State(nextId, List.copyOf(byLo.values())));
+            }
+            try {
+                Files.move(tmp, file, StandardCopyOption.REPLACE_EXISTING, StandardCopyOption.ATOMIC_MOVE);
+            } catch (AtomicMoveNotSupportedException ex) {
+                Files.move(tmp, file, StandardCopyOption.REPLACE_EXISTING);
+            }
+        } catch (IOException e) {
+            throw new RuntimeException("Failed to write bucket map: " + file, e);
+        }
+    }
+
+    private String newGroupName() {
+        return "phase-a" + (nextId++);
+    }
+
+    private void validate() {
+        if (byLo.isEmpty()) {
+            throw new IllegalStateException("empty range map");
+        }
+        double expected = -Math.PI;
+        Set<String> groups = new HashSet<>();
+        for (Range r : byLo.values()) {
+            if (r.lo() != expected || r.hi() <= r.lo() || !groups.add(r.group())) {
+                throw new IllegalStateException("ranges do not tile [-π, π] at " + r);
+            }
+            expected = r.hi();
+        }
+        if (expected != Math.PI) {
+            throw new IllegalStateException("ranges end at " + expected);
+        }
+    }
+}
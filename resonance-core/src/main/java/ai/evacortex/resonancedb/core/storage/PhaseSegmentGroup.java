@@ -96,6 +96,23 @@ public class PhaseSegmentGroup {
             if (current != null && current.approxSize() <= MAX_SEG_BYTES) {
                 return current;
             }
+            sealCurrent();
+            current = createSegment();
+            writers.add(current);
+            return current;
+        } finally {
+            lock.unlock();
+        }
+    }
+
+    /** Current segment if {@code pattern} still fits into it, otherwise a freshly created one. */
+    public SegmentWriter writableFor(WavePattern pattern) {
+        lock.lock();
+        try {
+            if (current != null && current.approxSize() <= MAX_SEG_BYTES && !current.willOverflow(pattern)) {
+                return current;
+            }
+            sealCurrent();
             current = createSegment();
             writers.add(current);
             return current;
@@ -107,6 +124,7 @@ public class PhaseSegmentGroup {
     public SegmentWriter createAndRegisterNewSegment() {
         lock.lock();
         try {
+            sealCurrent();
             current = createSegment();
             writers.add(current);
             return current;
@@ -115,6 +133,12 @@ public class PhaseSegmentGroup {
         }
     }
 
+    private void sealCurrent() {
+        if (current != null) {
+            current.seal();
+        }
+    }
+
     public List<SegmentWriter> getAll() {
         return Collections.unmodifiableList(writers);
     }
@@ -127,6 +151,14 @@ public class PhaseSegmentGroup {
         return baseName;
     }
 
+    /**
+     * Serialises segment selection and tombstoning in this group; reentrant, so it may be held around
+     * {@link #getWritable()}. Appends themselves run outside it, see {@link SegmentWriter#write}.
+     */
+    public ReentrantLock writeLock() {
+        return lock;
+    }
+
     public void resetTo(SegmentWriter writer) {
         lock.lock();
         try {
@@ -0,0 +1,310 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.storage;
+
+import ai.evacortex.resonancedb.core.engine.QueryOptions;
+import ai.evacortex.resonancedb.core.exceptions.QueryRejectedException;
+import ai.evacortex.resonancedb.core.storage.responce.AdmissionStats;
+
+import java.util.*;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.LongAdder;
+import java.util.concurrent.locks.Condition;
+import java.util.concurrent.locks.ReentrantLock;
+
+/**
+ * Process-wide admission control for queries of all open corpora.
+ *
+ * <p>At most {@code maxInFlight} queries, with at most {@code maxInFlightBytes} of estimated segment
+ * bytes between them, run on the shared query pool. Further queries wait in one queue ordered by
+ * start-time fair queueing: each corpus advances its own virtual finish tag by
+ * {@code cost / weight}, so a corpus issuing heavy scans cannot crowd out the others, and
+ * {@link QueryOptions.Priority#INTERACTIVE} queries weigh more than batch ones. A query is shed with
+ * {@link QueryRejectedException} when the queue is full, when the predicted wait already exceeds the
+ * latency target of its class, or when it has waited that long without being admitted.</p>
+ */
+public final class QueryAdmissionController {
+
+    private final int maxInFlight;
+    private final long maxInFlightBytes;
+    private final int maxQueued;
+    private final long interactiveTargetNanos;
+    private final long batchTargetNanos;
+    private final double interactiveWeight;
+    private final double batchWeight;
+
+    private final ReentrantLock lock = new ReentrantLock();
+    private final PriorityQueue<Waiter> queue = new PriorityQueue<>(
+            Comparator.comparingDouble((Waiter w) -> w.tag).thenComparingLong(w -> w.seq));
+    private final Map<String, Double> lastFinish = new HashMap<>();
+    private final Map<String, Integer> queuedByCorpus = new HashMap<>();
+    private final int[] queuedByPriority = new int[QueryOptions.Priority.values().length];
+    private final LongAdder admitted = new LongAdder();
+    private final LongAdder rejected = new LongAdder();
+
+    private double virtualTime;
+    private long seq;
+    private int inFlight;
+    private long inFlightBytes;
+    private double serviceNanosEwma;
+
+    public QueryAdmissionController(int maxInFlight,
+                                    long maxInFlightBytes,
+                                    int maxQueued,
+                                    long interactiveTargetMillis,
+                                    long batchTargetMillis,
+                                    double interactiveWeight,
+                                    double batchWeight) {
+        if (maxInFlight <= 0 || maxInFlightBytes <= 0 || maxQueued < 0) {
+            throw new IllegalArgumentException("maxInFlight and maxInFlightBytes must be > 0, maxQueued >= 0");
+        }
+        if (!(interactiveWeight > 0.0) || !(batchWeight > 0.0)) {
+            throw new IllegalArgumentException("weights must be > 0");
+        }
+        this.maxInFlight = maxInFlight;
+        this.maxInFlightBytes = maxInFlightBytes;
+        this.maxQueued = maxQueued;
+        this.interactiveTargetNanos = TimeUnit.MILLISECONDS.toNanos(Math.max(0L, interactiveTargetMillis));
+        this.batchTargetNanos = TimeUnit.MILLISECONDS.toNanos(Math.max(0L, batchTargetMillis));
+        this.interactiveWeight = interactiveWeight;
+        this.batchWeight = batchWeight;
+    }
+
+    static QueryAdmissionController fromSystemProperties(int poolParallelism) {
+        return new QueryAdmissionController(
+                Math.max(1, Integer.getInteger("resonance.admission.maxInFlight", Math.max(2, poolParallelism * 2))),
+                Math.max(1L, Long.getLong("resonance.admission.maxInFlightBytes", 8L << 30)),
+                Math.max(0, Integer.getInteger("resonance.admission.maxQueued", 256)),
+                Long.getLong("resonance.admission.interactive.targetMillis", 500L),
+                Long.getLong("resonance.admission.batch.targetMillis", 10_000L),
+                Double.parseDouble(System.getProperty("resonance.admission.interactive.weight", "4")),
+                Double.parseDouble(System.getProperty("resonance.admission.batch.weight", "1"))
+        );
+    }
+
+    /** Released exactly once by {@link #close()}; the query's scan must finish before that. */
+    public final class Permit implements AutoCloseable {
+        private final long bytes;
+        private final long startNanos = System.nanoTime();
+        private final AtomicBoolean released = new AtomicBoolean();
+
+        private Permit(long bytes) {
+            this.bytes = bytes;
+        }
+
+        @Override
+        public void close() {
+            if (released.compareAndSet(false, true)) {
+                release(bytes, System.nanoTime() - startNanos);
+            }
+        }
+    }
+
+    private static final class Waiter {
+        final String corpus;
+        final QueryOptions.Priority priority;
+        final long bytes;
+        final double tag;
+        final long seq;
+        final Condition ready;
+        boolean granted;
+
+        Waiter(String corpus, QueryOptions.Priority priority, long bytes, double tag, long seq, Condition ready) {
+            this.corpus = corpus;
+            this.priority = priority;
+            this.bytes = bytes;
+            this.tag = tag;
+            this.seq = seq;
+            this.ready = ready;
+        }
+    }
+
+    /**
+     * Waits on the waiter's condition as a managed blocker: async queries are admitted on query-pool
+     * workers, and the pool must add a spare for each queued one so admitted scans can still fork.
+     */
+    private static final class QueueWait implements ForkJoinPool.ManagedBlocker {
+        private final Waiter waiter;
+        private long remaining;
+
+        QueueWait(Waiter waiter, long remaining) {
+            this.waiter = waiter;
+            this.remaining = remaining;
+        }
+
+        @Override
+        public boolean block() throws InterruptedException {
+            if (!isReleasable()) {
+                remaining = waiter.ready.awaitNanos(remaining);
+            }
+            return isReleasable();
+        }
+
+        @Override
+        public boolean isReleasable() {
+            return waiter.granted || remaining <= 0L;
+        }
+    }
+
+    /**
+     * Blocks until the query may run and returns its permit.
+     *
+     * @param corpus         fairness key, normally the corpus id
+     * @param estimatedBytes segment bytes the query may scan; clamped to {@code maxInFlightBytes}
+     * @throws QueryRejectedException if the query is shed
+     */
+    public Permit admit(String corpus, QueryOptions.Priority priority, long estimatedBytes) {
+        return admit(corpus, priority, estimatedBytes, 0L);
+    }
+
+    /**
+     * Like {@link #admit(String, QueryOptions.Priority, long)}, for a query that must finish by
+     * {@code deadlineNanos} ({@link System#nanoTime()} based, {@code 0} for none). Queueing counts
+     * against that deadline: the query waits at most until it passes and is shed once it has.
+     */
+    public Permit admit(String corpus, QueryOptions.Priority priority, long estimatedBytes, long deadlineNanos) {
+        Objects.requireNonNull(corpus, "corpus must not be null");
+        Objects.requireNonNull(priority, "priority must not be null");
+        long bytes = Math.max(0L, Math.min(estimatedBytes, maxInFlightBytes));
+        long target = priority == QueryOptions.Priority.INTERACTIVE ? interactiveTargetNanos : batchTargetNanos;
+        long wait = target;
+        if (deadlineNanos != 0L) {
+            long left = deadlineNanos - System.nanoTime();
+            if (left <= 0L) {
+                throw reject("query deadline passed before admission");
+            }
+            wait = Math.min(wait, left);
+        }
+
+        lock.lock();
+        try {
+            if (queue.isEmpty() && fits(bytes)) {
+                grant(bytes);
+                return new Permit(bytes);
+            }
+            if (queue.size() >= maxQueued) {
+                throw reject("admission queue is full (" + queue.size() + " queries waiting)");
+            }
+            double predicted = serviceNanosEwma * (queue.size() + 1) / maxInFlight;
+            if (predicted > target) {
+                throw reject("predicted queueing delay " + TimeUnit.NANOSECONDS.toMillis((long) predicted)
+                        + " ms exceeds the " + priority.name().toLowerCase(Locale.ROOT) + " target of "
+                        + TimeUnit.NANOSECONDS.toMillis(target) + " ms");
+            }
+
+            double cost = 1.0 + bytes / ((double) maxInFlightBytes / maxInFlight);
+            double weight = priority == QueryOptions.Priority.INTERACTIVE ? interactiveWeight : batchWeight;
+            double tag = Math.max(virtualTime, lastFinish.getOrDefault(corpus, 0.0)) + cost / weight;
+            lastFinish.put(corpus, tag);
+
+            Waiter waiter = new Waiter(corpus, priority, bytes, tag, seq++, lock.newCondition());
+            queue.add(waiter);
+            queuedByCorpus.merge(corpus, 1, Integer::sum);
+            queuedByPriority[priority.ordinal()]++;
+
+            QueueWait blocker = new QueueWait(waiter, wait);
+            boolean interrupted = false;
+            try {
+                ForkJoinPool.managedBlock(blocker);
+            } catch (InterruptedException e) {
+                interrupted = true;
+            }
+            if (waiter.granted) {
+                if (interrupted) {
+                    Thread.currentThread().interrupt();
+                }
+                return new Permit(bytes);
+            }
+
+            queue.remove(waiter);
+            dequeued(waiter);
+            dispatch();
+            if (interrupted) {
+                Thread.currentThread().interrupt();
+                throw reject("interrupted while waiting for admission");
+            }
+            if (wait < target) {
+                throw reject("query deadline passed while waiting for admission");
+            }
+            throw reject("not admitted within the " + priority.name().toLowerCase(Locale.ROOT) + " target of "
+                    + TimeUnit.NANOSECONDS.toMillis(target) + " ms");
+        } finally {
+            lock.unlock();
+        }
+    }
+
+    public AdmissionStats stats() {
+        lock.lock();
+        try {
+            return new AdmissionStats(
+                    inFlight,
+                    maxInFlight,
+                    inFlightBytes,
+                    maxInFlightBytes,
+                    queuedByPriority[QueryOptions.Priority.INTERACTIVE.ordinal()],
+                    queuedByPriority[QueryOptions.Priority.BATCH.ordinal()],
+                    Map.copyOf(queuedByCorpus),
+                    admitted.sum(),
+                    rejected.sum()
+            );
+        } finally {
+            lock.unlock();
+        }
+    }
+
+    private void release(long bytes, long serviceNanos) {
+        lock.lock();
+        try {
+            inFlight--;
+            inFlightBytes -= bytes;
+            serviceNanosEwma = serviceNanosEwma == 0.0 ? serviceNanos : 0.9 * serviceNanosEwma + 0.1 * serviceNanos;
+            dispatch();
+        } finally {
+            lock.unlock();
+        }
+    }
+
+    /** Admits waiters in tag order while the head fits; a large head is not bypassed, so it cannot starve. */
+    private void dispatch() {
+        while (!queue.isEmpty() && fits(queue.peek().bytes)) {
+            Waiter next = queue.poll();
+            dequeued(next);
+            virtualTime = Math.max(virtualTime, next.tag);
+            grant(next.bytes);
+            next.granted = true;
+            next.ready.signal();
+        }
+        if (queue.isEmpty() && inFlight == 0) {
+            lastFinish.clear();
+            virtualTime = 0.0;
+        }
+    }
+
+    private void dequeued(Waiter waiter) {
+        queuedByCorpus.computeIfPresent(waiter.corpus, (k, n) -> n > 1 ? n - 1 : null);
+        queuedByPriority[waiter.priority.ordinal()]--;
+    }
+
+    private boolean fits(long bytes) {
+        return inFlight < maxInFlight && (inFlight == 0 || inFlightBytes + bytes <= maxInFlightBytes);
+    }
+
+    private void grant(long bytes) {
+        inFlight++;
+        inFlightBytes += bytes;
+        admitted.increment();
+    }
+
+    private QueryRejectedException reject(String reason) {
+        rejected.increment();
+        return new QueryRejectedException("Query rejected: " + reason);
+    }
+}
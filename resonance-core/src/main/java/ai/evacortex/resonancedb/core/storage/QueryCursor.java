@@ -0,0 +1,51 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.storage;
+
+import java.nio.charset.StandardCharsets;
+import java.util.Base64;
+
+/**
+ * Position after the last match of a result page: the corpus version it was issued at, the query it
+ * belongs to, and the (priority, energy, id) of the last returned match. Encoded as an opaque
+ * URL-safe token.
+ */
+record QueryCursor(long version, String queryId, float priority, float energy, String id) {
+
+    private static final String PREFIX = "c1";
+
+    String encode() {
+        String raw = String.join(":",
+                PREFIX,
+                Long.toString(version),
+                queryId,
+                Integer.toHexString(Float.floatToIntBits(priority)),
+                Integer.toHexString(Float.floatToIntBits(energy)),
+                id);
+        return Base64.getUrlEncoder().withoutPadding().encodeToString(raw.getBytes(StandardCharsets.UTF_8));
+    }
+
+    static QueryCursor decode(String token) {
+        try {
+            String raw = new String(Base64.getUrlDecoder().decode(token), StandardCharsets.UTF_8);
+            String[] parts = raw.split(":", -1);
+            if (parts.length != 6 || !PREFIX.equals(parts[0])) {
+                throw new IllegalArgumentException("Malformed query cursor");
+            }
+            return new QueryCursor(
+                    Long.parseLong(parts[1]),
+                    parts[2],
+                    Float.intBitsToFloat(Integer.parseUnsignedInt(parts[3], 16)),
+                    Float.intBitsToFloat(Integer.parseUnsignedInt(parts[4], 16)),
+                    parts[5]);
+        } catch (IllegalArgumentException e) {
+            throw new IllegalArgumentException("Malformed query cursor", e);
+        }
+    }
+}
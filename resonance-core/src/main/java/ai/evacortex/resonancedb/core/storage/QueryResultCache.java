@@ -0,0 +1,113 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.storage;
+
+import ai.evacortex.resonancedb.core.engine.QueryOptions;
+import ai.evacortex.resonancedb.core.storage.responce.QueryCacheStats;
+import ai.evacortex.resonancedb.core.storage.responce.QueryResult;
+import com.github.benmanes.caffeine.cache.Cache;
+import com.github.benmanes.caffeine.cache.Caffeine;
+
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.LongAdder;
+
+/**
+ * Byte-bounded cache of complete query results for one store.
+ *
+ * <p>Entries are keyed by query content hash, {@code topK} and the effective options, and remember the
+ * corpus version they were computed at. An entry is served while the version is unchanged, or — when
+ * {@code resonance.query.cache.staleMillis} is set — for that long after it was computed even if the
+ * corpus changed in between. Partial results are never cached.</p>
+ */
+final class QueryResultCache {
+
+    private static final long ENTRY_OVERHEAD_BYTES = 256L;
+    private static final long MATCH_OVERHEAD_BYTES = 128L;
+
+    record Key(String queryId, int topK, QueryOptions options, boolean detailed) {
+        Key {
+            options = options.withTimeoutMillis(0L);
+        }
+    }
+
+    private record Entry(long version, long createdNanos, QueryResult<?> result, int weight) {}
+
+    private final Cache<Key, Entry> cache;
+    private final long maxBytes;
+    private final long staleNanos;
+    private final long bytesPerMatch;
+    private final LongAdder hits = new LongAdder();
+    private final LongAdder misses = new LongAdder();
+
+    QueryResultCache(long maxBytes, long staleMillis, int patternLen) {
+        this.maxBytes = Math.max(0L, maxBytes);
+        this.staleNanos = TimeUnit.MILLISECONDS.toNanos(Math.max(0L, staleMillis));
+        this.bytesPerMatch = MATCH_OVERHEAD_BYTES + (long) patternLen * 2 * Double.BYTES;
+        this.cache = this.maxBytes > 0
+                ? Caffeine.newBuilder()
+                        .maximumWeight(this.maxBytes)
+                        .weigher((Key k, Entry e) -> e.weight())
+                        .build()
+                : null;
+    }
+
+    static QueryResultCache fromSystemProperties(int patternLen) {
+        return new QueryResultCache(
+                Long.getLong("resonance.query.cache.maxBytes", 0L),
+                Long.getLong("resonance.query.cache.staleMillis", 0L),
+                patternLen
+        );
+    }
+
+    @SuppressWarnings("unchecked")
+    <T> QueryResult<T> get(Key key, long version) {
+        if (cache == null) {
+            return null;
+        }
+        Entry e = cache.getIfPresent(key);
+        if (e != null && (e.version() == version
+                || (staleNanos > 0 && System.nanoTime() - e.createdNanos() <= staleNanos))) {
+            hits.increment();
+            return (QueryResult<T>) e.result();
+        }
+        misses.increment();
+        return null;
+    }
+
+    void put(Key key, long version, QueryResult<?> result) {
+        if (cache == null || result.partial()) {
+            return;
+        }
+        long bytes = ENTRY_OVERHEAD_BYTES + result.matches().size() * bytesPerMatch;
+        cache.put(key, new Entry(version, System.nanoTime(), result, (int) Math.min(bytes, Integer.MAX_VALUE)));
+    }
+
+    /** Weighted size of the cached results in estimated bytes. */
+    long weightedBytes() {
+        if (cache == null) {
+            return 0L;
+        }
+        return cache.policy().eviction().map(ev -> ev.weightedSize().orElse(0L)).orElse(0L);
+    }
+
+    void invalidateAll() {
+        if (cache != null) {
+            cache.invalidateAll();
+        }
+    }
+
+    QueryCacheStats stats(long corpusVersion) {
+        long h = hits.sum();
+        long m = misses.sum();
+        long entries = cache != null ? cache.estimatedSize() : 0L;
+        long weight = weightedBytes();
+        double rate = h + m == 0 ? 0.0 : (double) h / (h + m);
+        return new QueryCacheStats(corpusVersion, h, m, rate, entries, weight, maxBytes);
+    }
+}
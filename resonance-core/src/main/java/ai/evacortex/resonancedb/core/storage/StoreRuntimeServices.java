@@ -26,6 +26,9 @@ public final class StoreRuntimeServices implements Closeable {
     private final ScheduledThreadPoolExecutor scheduler;
     private final ResonanceKernel resonanceKernel;
     private final AdaptiveIoGovernor ioGovernor;
+    private final QueryAdmissionController admission;
+    private final MemoryGovernor memory;
+    private final ScheduledFuture<?> memoryTask;
     private final boolean ownResources;
     private final boolean flushAsync;
     private final Duration flushInterval;
@@ -37,13 +40,34 @@ public final class StoreRuntimeServices implements Closeable {
                                 boolean flushAsync,
                                 Duration flushInterval,
                                 boolean ownResources) {
+        this(queryPool, scheduler, resonanceKernel, ioGovernor,
+                QueryAdmissionController.fromSystemProperties(queryPool.getParallelism()),
+                flushAsync, flushInterval, ownResources);
+    }
+
+    public StoreRuntimeServices(ForkJoinPool queryPool,
+                                ScheduledThreadPoolExecutor scheduler,
+                                ResonanceKernel resonanceKernel,
+                                AdaptiveIoGovernor ioGovernor,
+                                QueryAdmissionController admission,
+                                boolean flushAsync,
+                                Duration flushInterval,
+                                boolean ownResources) {
         this.queryPool = Objects.requireNonNull(queryPool, "queryPool must not be null");
         this.scheduler = Objects.requireNonNull(scheduler, "scheduler must not be null");
         this.resonanceKernel = Objects.requireNonNull(resonanceKernel, "resonanceKernel must not be null");
         this.ioGovernor = Objects.requireNonNull(ioGovernor, "ioGovernor must not be null");
+        this.admission = Objects.requireNonNull(admission, "admission must not be null");
         this.flushInterval = Objects.requireNonNull(flushInterval, "flushInterval must not be null");
         this.flushAsync = flushAsync;
         this.ownResources = ownResources;
+
+        this.memory = MemoryGovernor.fromSystemProperties();
+        this.memory.register(WavePatternStoreImpl.SCRATCH_TENANT);
+        long sweepMillis = Math.max(100L, Long.getLong("resonance.memory.sweepMillis", 5_000L));
+        this.memoryTask = memory.enabled()
+                ? scheduler.scheduleAtFixedRate(this::rebalanceMemory, sweepMillis, sweepMillis, TimeUnit.MILLISECONDS)
+                : null;
     }
 
     public static StoreRuntimeServices fromSystemProperties() {
@@ -108,6 +132,14 @@ public final class StoreRuntimeServices implements Closeable {
         return ioGovernor;
     }
 
+    public QueryAdmissionController admission() {
+        return admission;
+    }
+
+    public MemoryGovernor memory() {
+        return memory;
+    }
+
     public boolean flushAsync() {
         return flushAsync;
     }
@@ -118,6 +150,9 @@ public final class StoreRuntimeServices implements Closeable {
 
     @Override
     public void close() {
+        if (memoryTask != null) {
+            memoryTask.cancel(false);
+        }
         if (!ownResources) {
             return;
         }
@@ -145,6 +180,14 @@ public final class StoreRuntimeServices implements Closeable {
         }
     }
 
+    private void rebalanceMemory() {
+        try {
+            memory.rebalance();
+        } catch (Throwable t) {
+            System.err.println("[runtime] memory rebalance failed: " + t.getMessage());
+        }
+    }
+
     private static ResonanceKernel createKernel(boolean useNativeKernel) {
         if (!useNativeKernel) {
             return new JavaKernel();
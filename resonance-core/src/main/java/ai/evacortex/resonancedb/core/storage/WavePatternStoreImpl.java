@@ -9,6 +9,7 @@
 package ai.evacortex.resonancedb.core.storage;
 
 import ai.evacortex.resonancedb.core.ResonanceStore;
+import ai.evacortex.resonancedb.core.engine.QueryOptions;
 import ai.evacortex.resonancedb.core.engine.ResonanceKernel;
 import ai.evacortex.resonancedb.core.exceptions.DuplicatePatternException;
 import ai.evacortex.resonancedb.core.exceptions.InvalidWavePatternException;
@@ -16,33 +17,56 @@ import ai.evacortex.resonancedb.core.exceptions.PatternNotFoundException;
 import ai.evacortex.resonancedb.core.exceptions.SegmentOverflowException;
 import ai.evacortex.resonancedb.core.math.ResonanceZone;
 import ai.evacortex.resonancedb.core.math.ResonanceZoneClassifier;
+import ai.evacortex.resonancedb.core.math.SignSketch;
 import ai.evacortex.resonancedb.core.math.WavePatternUtils;
 import ai.evacortex.resonancedb.core.metadata.PatternMetaStore;
 import ai.evacortex.resonancedb.core.sharding.PhaseShardSelector;
+import ai.evacortex.resonancedb.core.sharding.SegmentPhaseHistogram;
 import ai.evacortex.resonancedb.core.storage.compactor.DefaultSegmentCompactor;
 import ai.evacortex.resonancedb.core.storage.compactor.SegmentCompactor;
 import ai.evacortex.resonancedb.core.storage.io.CachedReader;
 import ai.evacortex.resonancedb.core.storage.io.SegmentCache;
+import ai.evacortex.resonancedb.core.storage.io.SegmentReader;
+import ai.evacortex.resonancedb.core.storage.io.SegmentSummary;
 import ai.evacortex.resonancedb.core.storage.io.SegmentWriter;
+import ai.evacortex.resonancedb.core.storage.io.SegmentIdIndex;
+import ai.evacortex.resonancedb.core.storage.io.SummarySidecar;
 import ai.evacortex.resonancedb.core.storage.responce.ComparisonResult;
+import ai.evacortex.resonancedb.core.storage.responce.CorpusMatch;
 import ai.evacortex.resonancedb.core.storage.responce.InterferenceEntry;
 import ai.evacortex.resonancedb.core.storage.responce.InterferenceMap;
+import ai.evacortex.resonancedb.core.storage.responce.QueryCacheStats;
+import ai.evacortex.resonancedb.core.storage.responce.QueryPage;
+import ai.evacortex.resonancedb.core.storage.responce.QueryResult;
 import ai.evacortex.resonancedb.core.storage.responce.ResonanceMatch;
 import ai.evacortex.resonancedb.core.storage.responce.ResonanceMatchDetailed;
+import ai.evacortex.resonancedb.core.storage.responce.ThresholdResult;
 import ai.evacortex.resonancedb.core.storage.util.AutoLock;
 import ai.evacortex.resonancedb.core.storage.util.HashingUtil;
 import ai.evacortex.resonancedb.core.storage.util.NoOpTracer;
+import ai.evacortex.resonancedb.core.storage.util.ResidencyScheduler;
+import ai.evacortex.resonancedb.core.storage.util.SingleFlight;
+import com.github.benmanes.caffeine.cache.Cache;
+import com.github.benmanes.caffeine.cache.Caffeine;
 
 import java.io.Closeable;
+import java.io.IOException;
 import java.lang.reflect.Method;
+import java.nio.file.Files;
 import java.nio.file.Path;
 import java.util.*;
 import java.util.concurrent.*;
 import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
 import java.util.concurrent.atomic.AtomicReference;
+import java.util.concurrent.atomic.LongAdder;
 import java.util.concurrent.locks.ReadWriteLock;
+import java.util.concurrent.locks.ReentrantLock;
 import java.util.concurrent.locks.ReentrantReadWriteLock;
+import java.util.function.Consumer;
 import java.util.function.Function;
+import java.util.function.Supplier;
 import java.util.stream.Stream;
 
 @SuppressWarnings("resource")
@@ -51,7 +75,6 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
     private static final int DEFAULT_PATTERN_LEN = 1536;
     private static final int BATCH_SIZE_BASE = Integer.getInteger("resonance.query.batchSize", 1024);
     private static final int OVERFETCH_FACTOR_BASE = Integer.getInteger("resonance.query.overfetch", 4);
-    private static final double READ_EPSILON = 0.1;
     private static final float EXACT_MATCH_EPS = 1e-6f;
 
     private static final int BUCKETS =
@@ -65,17 +88,59 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
             Integer.getInteger("resonance.phase.neighbors.max",
                     Math.max(8, (int) Math.ceil(Math.PI / BUCKET_WIDTH_RAD)));
 
+    private static final int BUCKET_SPLIT_RECORDS = Integer.getInteger("resonance.bucket.split.records", 50_000);
+    private static final int BUCKET_MERGE_RECORDS =
+            Integer.getInteger("resonance.bucket.merge.records", BUCKET_SPLIT_RECORDS / 8);
+    private static final double BUCKET_MIN_WIDTH_RAD =
+            Double.parseDouble(System.getProperty("resonance.bucket.minWidthRad", "0.001"));
+    private static final long BUCKET_REBALANCE_MINUTES = Long.getLong("resonance.bucket.rebalanceMinutes", 5L);
+
+    private static final int SKETCH_MIN_RECORDS = Integer.getInteger("resonance.query.sketch.minRecords", 4096);
+    private static final int SKETCH_CANDIDATES = Integer.getInteger("resonance.query.sketch.candidates", 1024);
+    private static final int BOUND_BATCH = Integer.getInteger("resonance.query.bound.batch", 256);
+    private static final int MORSEL_RECORDS = Math.max(64, Integer.getInteger("resonance.query.morselRecords", 2048));
+    private static final int SEGMENTS_PER_TASK = Math.max(1, Integer.getInteger("resonance.query.segmentsPerTask", 1));
+    private static final double PREFIX_FLOAT_TOLERANCE = 1e-6;
+    private static final double BOUND_SLACK = 1e-4;
+    private static final int CURSOR_PREFETCH_PAGES = Math.max(1, Integer.getInteger("resonance.query.cursor.prefetchPages", 4));
+    private static final long CURSOR_TTL_MILLIS = Long.getLong("resonance.query.cursor.ttlMillis", 60_000L);
+    private static final int CURSOR_CACHE_ENTRIES = Integer.getInteger("resonance.query.cursor.maxEntries", 1024);
+    private static final boolean COALESCE_QUERIES =
+            Boolean.parseBoolean(System.getProperty("resonance.query.coalesce", "true"));
+    /** Rough heap cost of one manifest or metadata entry: map node, hex id string and value. */
+    private static final long INDEX_ENTRY_BYTES = 160L;
+    private static final long MATCH_OVERHEAD_BYTES = 128L;
+    private static final boolean WARMUP_PREFETCH =
+            Boolean.parseBoolean(System.getProperty("resonance.corpus.warmup.prefetch", "true"));
+
     private final int patternLen;
     private final Path rootDir;
+    private final String corpusKey;
 
     private final ManifestIndex manifest;
     private final PatternMetaStore metaStore;
     private final Map<String, PhaseSegmentGroup> segmentGroups;
+    private final PhaseBucketMap bucketMap;
 
     private final ReadWriteLock globalLock = new ReentrantReadWriteLock();
-    private final AtomicReference<PhaseShardSelector> shardSelectorRef;
+    /** Serialises {@link #rebalanceBuckets}, whose copy phase runs outside {@link #globalLock}. */
+    private final ReentrantLock rebalanceLock = new ReentrantLock();
+    private final Object snapshotLock = new Object();
+    private final AtomicReference<CorpusSnapshot> snapshotRef = new AtomicReference<>();
+    private final ConcurrentMap<String, SegmentPhaseHistogram> phaseHistograms = new ConcurrentHashMap<>();
+    /** Segments written since the last snapshot; {@link #publishChanges} re-reads only these. */
+    private final Set<String> unpublished = ConcurrentHashMap.newKeySet();
+    private final Set<String> pendingIds = ConcurrentHashMap.newKeySet();
 
     private final SegmentCache readerCache;
+    private final QueryResultCache resultCache;
+    private final Cache<String, PageEntry> pageCache = Caffeine.newBuilder()
+            .expireAfterWrite(Math.max(1L, CURSOR_TTL_MILLIS), TimeUnit.MILLISECONDS)
+            .maximumSize(Math.max(0, CURSOR_CACHE_ENTRIES))
+            .build();
+    private final AtomicLong corpusVersion = new AtomicLong();
+    private final SingleFlight<FlightKey, QueryResult<ResonanceMatch>> matchFlights = new SingleFlight<>();
+    private final SingleFlight<FlightKey, QueryResult<ResonanceMatchDetailed>> detailedFlights = new SingleFlight<>();
     private final SegmentCompactor compactor;
     private final ResonanceTracer tracer;
 
@@ -86,18 +151,250 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
     private final Method compareManyFlatMethod;
 
     private final ScheduledFuture<?> compactionTask;
+    private final ScheduledFuture<?> rebalanceTask;
     private final AtomicBoolean closed = new AtomicBoolean(false);
+    private final CompletableFuture<Void> warmup;
+    private final AtomicInteger warmedSegments = new AtomicInteger();
+    private volatile int warmupSegments;
 
     private record HeapItem(ResonanceMatch match, float priority) {}
     private record HeapItemDetailed(ResonanceMatchDetailed match, double priority) {}
     private record SegmentWriteResult(SegmentWriter writer, long offset, long version) {}
+    private record PrefixView(int len, double[] re, double[] im, double energy, double restEnergy) {}
+    private record Routing(List<SegmentWriter> writers, double epsilon) {}
+    private record BatchHit(int query, HeapItem item) {}
+    /** A live record copied into a staged group, with the manifest entry it was copied from. */
+    private record StagedRecord(ManifestIndex.PatternLocation from, SegmentWriter writer, long offset) {}
+    private record MatchScan(List<HeapItem> items, Routing routing) {}
+    private record Shard(int member, WavePatternStoreImpl store, QueryProfile profile, SegmentWriter writer) {}
+    private record ShardHit(int member, HeapItem item) {}
+    private record PageEntry(List<HeapItem> items, boolean complete) {}
+    /** Identity of an in-flight ranked query; the corpus version keeps later arrivals off results computed before a mutation. */
+    private record FlightKey(String queryId, int topK, QueryOptions options, long version) {}
+
+    private static final Comparator<HeapItem> MATCH_ORDER = Comparator
+            .comparingDouble(HeapItem::priority).reversed()
+            .thenComparing((HeapItem h) -> h.match().energy(), Comparator.reverseOrder())
+            .thenComparing(h -> h.match().id());
+    private static final Comparator<ShardHit> SHARD_ORDER = Comparator
+            .comparing(ShardHit::item, MATCH_ORDER)
+            .thenComparingInt(ShardHit::member);
+    private static final Comparator<HeapItemDetailed> DETAILED_ORDER = Comparator
+            .comparingDouble(HeapItemDetailed::priority).reversed()
+            .thenComparing((HeapItemDetailed h) -> h.match().energy(), Comparator.reverseOrder())
+            .thenComparing(h -> h.match().id());
+
+    /** One range change of a rebalance: the ranges it replaces, their successors, and the groups staged for them. */
+    private record Rebalance(List<PhaseBucketMap.Range> sources,
+                             List<PhaseBucketMap.Range> targets,
+                             List<PhaseSegmentGroup> groups,
+                             Map<String, StagedRecord> copies) {
+
+        Rebalance(List<PhaseBucketMap.Range> sources, List<PhaseBucketMap.Range> targets) {
+            this(sources, targets, new ArrayList<>(), new HashMap<>());
+        }
+
+        /** Index of the target range holding {@code phase}, clamped like {@link PhaseBucketMap#rangeFor}. */
+        int targetOf(double phase) {
+            for (int i = targets.size() - 1; i > 0; i--) {
+                if (phase >= targets.get(i).lo()) {
+                    return i;
+                }
+            }
+            return 0;
+        }
+    }
+
+    private static final class QueryProfile {
+        final CorpusSnapshot snapshot;
+        final WavePattern query;
+        final String queryId;
+        final QueryOptions options;
+        final HeapItem after;
+        final long[] sketch;
+        final double energy;
+        private volatile PrefixView prefix;
+        private volatile double[] absAmplitude;
+        private final AtomicInteger floorBits;
+        private final AtomicLong candidateBudget;
+        private final AtomicLong scored;
+        private final AtomicInteger segmentsScanned;
+        private final long deadlineNanos;
+        private final Future<?> origin;
+        private volatile boolean expired;
+
+        QueryProfile(CorpusSnapshot snapshot, WavePattern query, QueryOptions options, long deadlineNanos) {
+            this(snapshot, query, options, null, deadlineNanos);
+        }
+
+        /**
+         * {@code after}: when set, only matches ranked strictly after it are collected.
+         * {@code deadlineNanos}: from {@link #deadlineOf}, taken before the query queued for admission.
+         */
+        QueryProfile(CorpusSnapshot snapshot, WavePattern query, QueryOptions options, HeapItem after,
+                     long deadlineNanos) {
+            this.snapshot = snapshot;
+            this.query = query;
+            this.queryId = HashingUtil.computeContentHash(query);
+            this.options = options;
+            this.after = after;
+            this.sketch = options.sketchPrefilter() ? SignSketch.of(query) : null;
+            this.energy = energyOf(query);
+            this.floorBits = new AtomicInteger(Float.floatToIntBits(Float.NEGATIVE_INFINITY));
+            this.candidateBudget = new AtomicLong(options.maxCandidates() > 0 ? options.maxCandidates() : Long.MAX_VALUE);
+            this.scored = new AtomicLong();
+            this.segmentsScanned = new AtomicInteger();
+            this.deadlineNanos = deadlineNanos;
+            this.origin = ASYNC_ORIGIN.get();
+        }
+
+        /**
+         * The same query over another corpus: shares the top-K floor, candidate budget, counters and
+         * deadline of {@code shared}, so several corpora prune and stop as one scan.
+         */
+        QueryProfile(CorpusSnapshot snapshot, QueryProfile shared) {
+            this.snapshot = snapshot;
+            this.query = shared.query;
+            this.queryId = shared.queryId;
+            this.options = shared.options;
+            this.after = shared.after;
+            this.sketch = shared.sketch;
+            this.energy = shared.energy;
+            this.floorBits = shared.floorBits;
+            this.candidateBudget = shared.candidateBudget;
+            this.scored = shared.scored;
+            this.segmentsScanned = shared.segmentsScanned;
+            this.deadlineNanos = shared.deadlineNanos;
+            this.origin = shared.origin;
+        }
+
+        /** True once the query deadline has passed or its async future was cancelled; sticky, so callers may poll it cheaply. */
+        boolean expired() {
+            if (expired) {
+                return true;
+            }
+            if ((deadlineNanos != 0L && System.nanoTime() - deadlineNanos >= 0)
+                    || (origin != null && origin.isCancelled())) {
+                expired = true;
+            }
+            return expired;
+        }
+
+        boolean stopped() {
+            return exhausted() || expired();
+        }
+
+        /** Stops the query as if its deadline had passed, e.g. when a streaming consumer fails. */
+        void cancel() {
+            expired = true;
+        }
+
+        /** Reserves up to {@code n} candidates from the per-query budget; returns how many may be scored. */
+        int admit(int n) {
+            long cur;
+            int take;
+            do {
+                cur = candidateBudget.get();
+                if (cur <= 0) {
+                    return 0;
+                }
+                take = (int) Math.min(n, cur);
+            } while (!candidateBudget.compareAndSet(cur, cur - take));
+            scored.addAndGet(take);
+            return take;
+        }
+
+        boolean exhausted() {
+            return candidateBudget.get() <= 0;
+        }
+
+        /** Lowest priority of a full top-K found in any single segment so far; a lower bound for the result. */
+        float floor() {
+            return Float.intBitsToFloat(floorBits.get());
+        }
+
+        void raiseFloor(float priority) {
+            int cur;
+            do {
+                cur = floorBits.get();
+                if (Float.intBitsToFloat(cur) >= priority) {
+                    return;
+                }
+            } while (!floorBits.compareAndSet(cur, Float.floatToIntBits(priority)));
+        }
+
+        double[] absAmplitude() {
+            double[] abs = absAmplitude;
+            if (abs == null) {
+                abs = Arrays.stream(query.amplitude()).map(Math::abs).toArray();
+                absAmplitude = abs;
+            }
+            return abs;
+        }
+
+        PrefixView prefix(int len) {
+            PrefixView view = prefix;
+            if (view != null && view.len() == len) {
+                return view;
+            }
+            double[] amp = query.amplitude();
+            double[] phase = query.phase();
+            double[] re = new double[len];
+            double[] im = new double[len];
+            double e = 0.0;
+            for (int k = 0; k < len; k++) {
+                re[k] = amp[k] * Math.cos(phase[k]);
+                im[k] = amp[k] * Math.sin(phase[k]);
+                e += amp[k] * amp[k];
+            }
+            view = new PrefixView(len, re, im, e, Math.max(0.0, energy - e));
+            prefix = view;
+            return view;
+        }
+    }
 
     private final Adaptive tune = new Adaptive();
 
     private static final ThreadLocal<FlatBuffers> TL_FLAT =
             ThreadLocal.withInitial(FlatBuffers::new);
+    private static final AtomicLong SCRATCH_BYTES = new AtomicLong();
+    private static final AtomicInteger SCRATCH_EPOCH = new AtomicInteger();
+
+    /** Scan buffers of all threads and stores, accounted and released as one memory governor tenant. */
+    static final MemoryGovernor.Tenant SCRATCH_TENANT = new MemoryGovernor.Tenant() {
+        @Override
+        public String name() {
+            return "scratch";
+        }
+
+        @Override
+        public MemoryGovernor.Footprint footprint() {
+            return new MemoryGovernor.Footprint(0L, SCRATCH_BYTES.get(), 0L);
+        }
+
+        @Override
+        public long lastAccessNanos() {
+            return System.nanoTime();
+        }
+
+        /** Retires every thread's buffers at once; each thread allocates fresh ones on its next scan. */
+        @Override
+        public long trim(long bytes) {
+            SCRATCH_EPOCH.incrementAndGet();
+            return SCRATCH_BYTES.getAndSet(0L);
+        }
+
+        @Override
+        public boolean evict() {
+            return false;
+        }
+    };
+
+    /** Future of the async call running on this thread; query profiles created under it stop when it is cancelled. */
+    private static final ThreadLocal<Future<?>> ASYNC_ORIGIN = new ThreadLocal<>();
 
     private static final class FlatBuffers {
+        final int epoch = SCRATCH_EPOCH.get();
         double[] ampFlat;
         double[] phaseFlat;
         String[] ids;
@@ -105,15 +402,35 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
         void ensure(int len, int batch) {
             int need = len * batch;
             if (ampFlat == null || ampFlat.length < need) {
+                grown(ampFlat == null ? 0 : ampFlat.length, need);
                 ampFlat = new double[need];
             }
             if (phaseFlat == null || phaseFlat.length < need) {
+                grown(phaseFlat == null ? 0 : phaseFlat.length, need);
                 phaseFlat = new double[need];
             }
             if (ids == null || ids.length < batch) {
+                grown(ids == null ? 0 : ids.length, batch);
                 ids = new String[batch];
             }
         }
+
+        /** Accounts an array grown from {@code from} to {@code to} 8-byte slots, unless these buffers were retired. */
+        private void grown(int from, int to) {
+            if (epoch == SCRATCH_EPOCH.get()) {
+                SCRATCH_BYTES.addAndGet(8L * (to - from));
+            }
+        }
+    }
+
+    /** This thread's scan buffers; replaced after the memory governor retired them. */
+    private static FlatBuffers flatBuffers() {
+        FlatBuffers fb = TL_FLAT.get();
+        if (fb.epoch != SCRATCH_EPOCH.get()) {
+            fb = new FlatBuffers();
+            TL_FLAT.set(fb);
+        }
+        return fb;
     }
 
     private static final class Adaptive {
@@ -208,6 +525,7 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
 
         this.patternLen = patternLen;
         this.rootDir = dbRoot.toAbsolutePath().normalize();
+        this.corpusKey = String.valueOf(rootDir.getFileName());
         this.runtime = runtime;
         this.ownRuntime = ownRuntime;
 
@@ -215,6 +533,7 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
         this.manifest.ensureFileExists();
         this.metaStore = PatternMetaStore.loadOrCreate(this.rootDir.resolve("metadata/pattern-meta.json"));
         this.readerCache = new SegmentCache(this.rootDir.resolve("segments"));
+        this.resultCache = QueryResultCache.fromSystemProperties(patternLen);
         this.compactor = new DefaultSegmentCompactor(
                 manifest,
                 metaStore,
@@ -222,6 +541,7 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
                 globalLock
         );
         this.segmentGroups = new ConcurrentHashMap<>();
+        this.bucketMap = PhaseBucketMap.loadOrCreate(this.rootDir.resolve("index/buckets.json"), BUCKET_WIDTH_RAD);
         this.tracer = new NoOpTracer();
 
         this.queryPool = runtime.queryPool();
@@ -230,44 +550,59 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
 
         loadAllWritersFromManifest();
         verifyPatternLengthOnOpen();
-        this.shardSelectorRef = new AtomicReference<>(createShardSelector());
+        this.warmup = CompletableFuture.runAsync(this::warmUp, queryPool);
 
         this.compactionTask = runtime.scheduler().scheduleAtFixedRate(
                 this::safeCompactSweep,
                 10, 5, TimeUnit.MINUTES
         );
+        this.rebalanceTask = runtime.scheduler().scheduleWithFixedDelay(
+                this::safeRebalanceSweep,
+                BUCKET_REBALANCE_MINUTES, BUCKET_REBALANCE_MINUTES, TimeUnit.MINUTES
+        );
     }
 
     @Override
     public String insert(WavePattern psi, Map<String, String> metadata)
             throws DuplicatePatternException, InvalidWavePatternException {
 
-        ensureOpen();
+        ensureWritable();
         validateWavePatternLen(psi);
         Map<String, String> safeMetadata = metadata == null ? Map.of() : metadata;
 
         String idKey = HashingUtil.computeContentHash(psi);
         HashingUtil.parseAndValidateMd5(idKey);
 
-        try (AutoLock ignored = AutoLock.write(globalLock)) {
-            if (manifest.contains(idKey)) {
-                throw new DuplicatePatternException(idKey);
+        double phaseCenter = Arrays.stream(psi.phase()).average().orElse(0.0);
+        try (AutoLock ignored = AutoLock.read(globalLock)) {
+            PhaseSegmentGroup group = getOrCreateGroup(bucketMap.groupFor(phaseCenter));
+            try (AutoLock groupGuard = AutoLock.of(group.writeLock())) {
+                if (manifest.contains(idKey) || !pendingIds.add(idKey)) {
+                    throw new DuplicatePatternException(idKey);
+                }
+                boolean phaseOverflow = Math.abs(phaseCenter - group.getAvgPhase()) > 0.15;
+                if (phaseOverflow) {
+                    group.createAndRegisterNewSegment();
+                }
             }
-
-            int bucket = computePhaseBucket(psi);
-            String base = "phase-" + bucket;
-
-            PhaseSegmentGroup group = getOrCreateGroup(base);
-            double phaseCenter = Arrays.stream(psi.phase()).average().orElse(0.0);
-            double existingCenter = group.getAvgPhase();
-
-            boolean phaseOverflow = Math.abs(phaseCenter - existingCenter) > 0.15;
-            SegmentWriter writer = group.getWritable();
-            if (writer == null || writer.willOverflow(psi) || phaseOverflow) {
-                writer = group.createAndRegisterNewSegment();
+            try {
+                return insertClaimed(idKey, psi, safeMetadata, phaseCenter, group);
+            } finally {
+                pendingIds.remove(idKey);
             }
-            group.registerIfAbsent(writer);
+        }
+    }
 
+    /**
+     * Insert body; caller holds the global read lock and has claimed {@code idKey} in {@link #pendingIds}.
+     * Runs outside the group lock so that inserts into one group append to its segment in parallel.
+     */
+    private String insertClaimed(String idKey,
+                                WavePattern psi,
+                                Map<String, String> safeMetadata,
+                                double phaseCenter,
+                                PhaseSegmentGroup group) {
+        try {
             SegmentWriteResult result = writeToSegment(idKey, psi, group);
 
             manifest.add(idKey, result.writer().getSegmentName(), result.offset(), phaseCenter);
@@ -279,7 +614,8 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
             }
 
             group.updatePhaseStats(phaseCenter);
-            rebuildShardSelector();
+            histogramFor(result.writer().getSegmentName()).add(phaseCenter, energyOf(psi));
+            publishChanges(result.writer().getSegmentName());
             return idKey;
 
         } catch (SegmentOverflowException |
@@ -296,6 +632,7 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
             try {
                 if (metaStore.contains(idKey)) {
                     metaStore.remove(idKey);
+                    metaStore.flush();
                 }
             } catch (Throwable ignored) {
             }
@@ -305,28 +642,38 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
 
     @Override
     public void delete(String idKey) throws PatternNotFoundException {
-        ensureOpen();
+        ensureWritable();
         Objects.requireNonNull(idKey, "idKey must not be null");
         HashingUtil.parseAndValidateMd5(idKey);
 
-        try (AutoLock ignored = AutoLock.write(globalLock)) {
-            ManifestIndex.PatternLocation loc = manifest.get(idKey);
-            if (loc == null) {
-                throw new PatternNotFoundException(idKey);
-            }
+        try (AutoLock ignored = AutoLock.read(globalLock)) {
+            while (true) {
+                ManifestIndex.PatternLocation loc = manifest.get(idKey);
+                if (loc == null) {
+                    throw new PatternNotFoundException(idKey);
+                }
 
-            SegmentWriter writer = getOrCreateWriter(loc.segmentName());
-            writer.markDeleted(loc.offset());
-            long newVersion = writer.flush();
-            writer.sync();
-            readerCache.updateVersion(writer.getSegmentName(), newVersion);
+                try (AutoLock groupGuard = AutoLock.of(groupOwning(loc.segmentName()).writeLock())) {
+                    if (!loc.equals(manifest.get(idKey))) {
+                        continue;
+                    }
 
-            manifest.remove(idKey);
-            metaStore.remove(idKey);
-            manifest.flush();
-            metaStore.flush();
+                    SegmentWriter writer = getOrCreateWriter(loc.segmentName());
+                    writer.markDeleted(loc.offset());
+                    long newVersion = writer.flush();
+                    writer.sync();
+                    readerCache.advanceVersion(writer.getSegmentName(), newVersion);
+
+                    manifest.remove(idKey);
+                    metaStore.remove(idKey);
+                    manifest.flush();
+                    metaStore.flush();
 
-            rebuildShardSelector();
+                    histogramFor(loc.segmentName()).remove(loc.phaseCenter());
+                    publishChanges(loc.segmentName());
+                    return;
+                }
+            }
         }
     }
 
@@ -334,7 +681,7 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
     public String replace(String oldId, WavePattern newPattern, Map<String, String> newMetadata)
             throws PatternNotFoundException, InvalidWavePatternException, DuplicatePatternException {
 
-        ensureOpen();
+        ensureWritable();
         validateWavePatternLen(newPattern);
         Map<String, String> safeMetadata = newMetadata == null ? Map.of() : newMetadata;
 
@@ -342,272 +689,1199 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
         String newId = HashingUtil.computeContentHash(newPattern);
         HashingUtil.parseAndValidateMd5(newId);
 
-        try (AutoLock ignored = AutoLock.write(globalLock)) {
-            ManifestIndex.PatternLocation oldLoc = manifest.get(oldId);
-            if (oldLoc == null) {
-                throw new PatternNotFoundException(oldId);
-            }
+        double phaseCenter = Arrays.stream(newPattern.phase()).average().orElse(0.0);
+        try (AutoLock ignored = AutoLock.read(globalLock)) {
+            PhaseSegmentGroup group = getOrCreateGroup(bucketMap.groupFor(phaseCenter));
+            while (true) {
+                ManifestIndex.PatternLocation oldLoc = manifest.get(oldId);
+                if (oldLoc == null) {
+                    throw new PatternNotFoundException(oldId);
+                }
 
-            if (!oldId.equals(newId) && manifest.contains(newId)) {
-                throw new DuplicatePatternException("Replacement would collide: " + newId);
+                // Both groups are locked in name order so that replaces crossing groups cannot deadlock.
+                PhaseSegmentGroup oldGroup = groupOwning(oldLoc.segmentName());
+                boolean oldFirst = oldGroup.getBaseName().compareTo(group.getBaseName()) <= 0;
+                try (AutoLock first = AutoLock.of((oldFirst ? oldGroup : group).writeLock());
+                     AutoLock second = AutoLock.of((oldFirst ? group : oldGroup).writeLock())) {
+                    if (!oldLoc.equals(manifest.get(oldId))) {
+                        continue;
+                    }
+                    boolean claimed = !oldId.equals(newId);
+                    if (claimed && !pendingIds.add(newId)) {
+                        throw new DuplicatePatternException("Replacement would collide: " + newId);
+                    }
+                    try {
+                        return replaceLocked(oldId, oldLoc, newId, newPattern, safeMetadata, phaseCenter, group);
+                    } finally {
+                        if (claimed) {
+                            pendingIds.remove(newId);
+                        }
+                    }
+                }
             }
+        }
+    }
 
-            int bucket = computePhaseBucket(newPattern);
-            String base = "phase-" + bucket;
-            PhaseSegmentGroup group = getOrCreateGroup(base);
-            double phaseCenter = Arrays.stream(newPattern.phase()).average().orElse(0.0);
+    /** Replace body; caller holds the global read lock and the write locks of both affected groups. */
+    private String replaceLocked(String oldId,
+                                 ManifestIndex.PatternLocation oldLoc,
+                                 String newId,
+                                 WavePattern newPattern,
+                                 Map<String, String> safeMetadata,
+                                 double phaseCenter,
+                                 PhaseSegmentGroup group) {
+        if (!oldId.equals(newId) && manifest.contains(newId)) {
+            throw new DuplicatePatternException("Replacement would collide: " + newId);
+        }
 
-            SegmentWriteResult result = writeToSegment(newId, newPattern, group);
+        SegmentWriteResult result = writeToSegment(newId, newPattern, group);
 
-            try {
-                SegmentWriter oldWriter = null;
-                long oldVersion = -1L;
-
-                if (!oldLoc.segmentName().equals(result.writer().getSegmentName())
-                        || oldLoc.offset() != result.offset()) {
-                    oldWriter = getOrCreateWriter(oldLoc.segmentName());
-                    oldWriter.markDeleted(oldLoc.offset());
-                    oldVersion = oldWriter.flush();
-                    oldWriter.sync();
-                }
+        try {
+            SegmentWriter oldWriter = null;
+            long oldVersion = -1L;
+
+            if (!oldLoc.segmentName().equals(result.writer().getSegmentName())
+                    || oldLoc.offset() != result.offset()) {
+                oldWriter = getOrCreateWriter(oldLoc.segmentName());
+                oldWriter.markDeleted(oldLoc.offset());
+                oldVersion = oldWriter.flush();
+                oldWriter.sync();
+            }
 
-                if (oldId.equals(newId)) {
-                    manifest.replace(
-                            oldId,
-                            oldLoc.segmentName(),
-                            oldLoc.offset(),
-                            result.writer().getSegmentName(),
-                            result.offset(),
-                            phaseCenter
-                    );
-                } else {
-                    manifest.replace(
-                            oldId,
-                            newId,
-                            result.writer().getSegmentName(),
-                            result.offset(),
-                            phaseCenter
-                    );
-                }
+            if (oldId.equals(newId)) {
+                manifest.replace(
+                        oldId,
+                        oldLoc.segmentName(),
+                        oldLoc.offset(),
+                        result.writer().getSegmentName(),
+                        result.offset(),
+                        phaseCenter
+                );
+            } else {
+                manifest.replace(
+                        oldId,
+                        newId,
+                        result.writer().getSegmentName(),
+                        result.offset(),
+                        phaseCenter
+                );
+            }
 
-                if (!oldId.equals(newId) && metaStore.contains(oldId)) {
-                    metaStore.remove(oldId);
-                }
+            if (!oldId.equals(newId) && metaStore.contains(oldId)) {
+                metaStore.remove(oldId);
+            }
 
-                if (!safeMetadata.isEmpty()) {
-                    metaStore.put(newId, safeMetadata);
-                }
+            if (!safeMetadata.isEmpty()) {
+                metaStore.put(newId, safeMetadata);
+            }
 
-                manifest.flush();
-                metaStore.flush();
+            manifest.flush();
+            metaStore.flush();
 
-                group.updatePhaseStats(phaseCenter);
-                readerCache.updateVersion(result.writer().getSegmentName(), result.version());
+            group.updatePhaseStats(phaseCenter);
+            histogramFor(oldLoc.segmentName()).remove(oldLoc.phaseCenter());
+            histogramFor(result.writer().getSegmentName()).add(phaseCenter, energyOf(newPattern));
+            readerCache.advanceVersion(result.writer().getSegmentName(), result.version());
 
-                if (oldWriter != null) {
-                    readerCache.updateVersion(oldWriter.getSegmentName(), oldVersion);
-                }
+            if (oldWriter != null) {
+                readerCache.advanceVersion(oldWriter.getSegmentName(), oldVersion);
+            }
 
-                rebuildShardSelector();
-                return newId;
+            publishChanges(oldLoc.segmentName(), result.writer().getSegmentName());
+            return newId;
 
-            } catch (Exception rollbackEx) {
-                try {
-                    SegmentWriter writer = result.writer();
-                    writer.markDeleted(result.offset());
-                    long rollbackVersion = writer.flush();
-                    writer.sync();
-                    readerCache.updateVersion(writer.getSegmentName(), rollbackVersion);
-                } catch (Exception i) {
-                    System.err.println("Failed to rollback written pattern " + newId);
-                }
-                throw new RuntimeException("Replace failed after write: " + newId, rollbackEx);
+        } catch (Exception rollbackEx) {
+            try {
+                SegmentWriter writer = result.writer();
+                writer.markDeleted(result.offset());
+                long rollbackVersion = writer.flush();
+                writer.sync();
+                readerCache.advanceVersion(writer.getSegmentName(), rollbackVersion);
+            } catch (Exception i) {
+                System.err.println("Failed to rollback written pattern " + newId);
             }
+            throw new RuntimeException("Replace failed after write: " + newId, rollbackEx);
         }
     }
 
     @Override
     public List<ResonanceMatch> query(WavePattern query, int topK) {
+        return query(query, topK, QueryOptions.defaultOptions());
+    }
+
+    @Override
+    public List<ResonanceMatch> query(WavePattern query, int topK, QueryOptions options) {
+        return queryResult(query, topK, options).matches();
+    }
+
+    @Override
+    public QueryResult<ResonanceMatch> queryResult(WavePattern query, int topK, QueryOptions options) {
         ensureOpen();
         validateWavePatternLen(query);
+        Objects.requireNonNull(options, "options must not be null");
+        QueryOptions effective = effectiveOptions(options, topK);
         if (topK <= 0) {
-            return List.of();
+            return new QueryResult<>(List.of(), effective, 0, 0L, false);
+        }
+        if (!COALESCE_QUERIES) {
+            return rankMatches(query, topK, effective);
         }
+        FlightKey key = new FlightKey(HashingUtil.computeContentHash(query), topK, effective, corpusVersion.get());
+        return matchFlights.execute(key, () -> rankMatches(query, topK, effective), WavePatternStoreImpl::asyncCancelled);
+    }
 
-        try (AutoLock ignored = AutoLock.read(globalLock)) {
-            String queryId = HashingUtil.computeContentHash(query);
+    private QueryResult<ResonanceMatch> rankMatches(WavePattern query, int topK, QueryOptions effective) {
+        long deadline = deadlineOf(effective);
+        try (CorpusSnapshot snapshot = pinSnapshot()) {
+            long version = snapshot.version();
+            QueryResultCache.Key cacheKey = new QueryResultCache.Key(
+                    HashingUtil.computeContentHash(query), topK, effective, false);
+            QueryResult<ResonanceMatch> cached = resultCache.get(cacheKey, version);
+            if (cached != null) {
+                return cached;
+            }
+            return rankMatchesAdmitted(snapshot, query, topK, effective, cacheKey, deadline);
+        }
+    }
 
-            Comparator<HeapItem> order = Comparator
-                    .comparingDouble(HeapItem::priority).reversed()
-                    .thenComparing((HeapItem h) -> h.match().energy(), Comparator.reverseOrder())
-                    .thenComparing(h -> h.match().id());
+    private QueryResult<ResonanceMatch> rankMatchesAdmitted(CorpusSnapshot snapshot, WavePattern query, int topK,
+                                                            QueryOptions effective, QueryResultCache.Key cacheKey,
+                                                            long deadline) {
+        try (QueryAdmissionController.Permit admission = admit(effective.priority(), snapshot, deadline)) {
+            QueryProfile profile = new QueryProfile(snapshot, query, effective, deadline);
+            long version = snapshot.version();
 
-            List<SegmentWriter> writers = selectWritersForQuery(query);
-            int threshold = Math.max(4, writers.size() / Math.max(1, tune.poolParallelism));
+            MatchScan scan = scanMatches(profile, topK);
+            List<ResonanceMatch> prelim = deduplicateTopK(scan.items(), h -> h.match().id(), MATCH_ORDER, topK)
+                    .stream()
+                    .map(HeapItem::match)
+                    .toList();
 
-            List<HeapItem> collected = queryPool.invoke(
-                    new MatchQueryTask(writers, query, queryId, topK, 0, writers.size(), threshold)
+            QueryResult<ResonanceMatch> result = new QueryResult<>(
+                    project(snapshot, prelim, effective.projection()),
+                    effective.withPhaseEpsilon(scan.routing().epsilon()),
+                    profile.segmentsScanned.get(),
+                    profile.scored.get(),
+                    profile.expired
             );
+            resultCache.put(cacheKey, version, result);
+            return result;
+        }
+    }
 
-            if (collected.size() < topK) {
-                Set<String> seen = new HashSet<>();
-                for (SegmentWriter writer : writers) {
-                    seen.add(writer.getSegmentName());
+    /**
+     * Ranks {@code query} over several corpora as one scan. Every store routes the query as usual, but the
+     * routed segments of all stores form a single task set on the shared query pool and prune against one
+     * top-K floor, candidate budget and deadline, so latency approaches that of one corpus holding all the
+     * segments rather than the sum of separate queries. The scan takes one admission permit, queued fairly
+     * against other queries over the same set of corpora; its result is neither cached nor coalesced.
+     * {@code maxSegments} still applies per corpus.
+     *
+     * <p>The result does not depend on the order of {@code stores}: members are visited by corpus id, which
+     * also breaks ties between equally ranked matches of different corpora, and an adaptive overfetch is
+     * the largest any member would choose.</p>
+     *
+     * @param stores open stores by corpus id; they must share one {@link StoreRuntimeServices}
+     */
+    public static QueryResult<CorpusMatch> queryMany(Map<String, WavePatternStoreImpl> stores,
+                                                     WavePattern query,
+                                                     int topK,
+                                                     QueryOptions options) {
+        Objects.requireNonNull(stores, "stores must not be null");
+        Objects.requireNonNull(options, "options must not be null");
+        if (stores.isEmpty()) {
+            return new QueryResult<>(List.of(), options, 0, 0L, false);
+        }
+        List<String> corpusIds = stores.keySet().stream().sorted().toList();
+        List<WavePatternStoreImpl> members = corpusIds.stream().map(stores::get).toList();
+        WavePatternStoreImpl first = members.getFirst();
+        for (WavePatternStoreImpl store : members) {
+            if (store.runtime != first.runtime) {
+                throw new IllegalArgumentException("Stores of a federated query must share one runtime");
+            }
+            store.ensureOpen();
+            store.validateWavePatternLen(query);
+        }
+        QueryOptions resolved = options;
+        if (options.overfetch() == 0) {
+            int overfetch = 0;
+            for (WavePatternStoreImpl store : members) {
+                overfetch = Math.max(overfetch, store.tune.overfetchForTopK(topK));
+            }
+            resolved = options.withOverfetch(overfetch);
+        }
+        QueryOptions effective = first.effectiveOptions(resolved, topK);
+        if (topK <= 0) {
+            return new QueryResult<>(List.of(), effective, 0, 0L, false);
+        }
+
+        long deadline = deadlineOf(effective);
+        long bytes = 0L;
+        for (WavePatternStoreImpl store : members) {
+            bytes += scanEstimate(store.snapshotRef.get());
+        }
+        int n = members.size();
+        CorpusSnapshot[] snapshots = new CorpusSnapshot[n];
+        try (QueryAdmissionController.Permit admission = first.runtime.admission()
+                .admit(String.join(",", corpusIds), effective.priority(), bytes, deadline)) {
+            QueryProfile[] profiles = new QueryProfile[n];
+            Routing[] routings = new Routing[n];
+            List<Shard> routed = new ArrayList<>();
+            double epsilon = 0.0;
+            for (int i = 0; i < n; i++) {
+                WavePatternStoreImpl store = members.get(i);
+                snapshots[i] = store.pinSnapshot();
+                profiles[i] = i == 0
+                        ? new QueryProfile(snapshots[i], query, effective, deadline)
+                        : new QueryProfile(snapshots[i], profiles[0]);
+                routings[i] = store.routeQuery(profiles[i]);
+                epsilon = Math.max(epsilon, routings[i].epsilon());
+                for (SegmentWriter writer : routings[i].writers()) {
+                    routed.add(new Shard(i, store, profiles[i], writer));
                 }
+            }
 
-                List<SegmentWriter> rest = getAllWritersStream()
-                        .filter(w -> !seen.contains(w.getSegmentName()))
-                        .toList();
-
+            List<ShardHit> hits = invokeShards(first.queryPool, routed, topK);
+            if (hits.size() < topK && !profiles[0].expired()) {
+                List<Shard> rest = new ArrayList<>();
+                for (int i = 0; i < n; i++) {
+                    for (SegmentWriter writer : remainingWriters(snapshots[i], routings[i].writers(), effective.maxSegments())) {
+                        rest.add(new Shard(i, members.get(i), profiles[i], writer));
+                    }
+                }
                 if (!rest.isEmpty()) {
-                    List<HeapItem> extra = queryPool.invoke(
-                            new MatchQueryTask(rest, query, queryId, topK, 0, rest.size(), threshold)
-                    );
-                    collected.addAll(extra);
+                    hits.addAll(invokeShards(first.queryPool, rest, topK));
                 }
             }
 
-            List<ResonanceMatch> prelim = deduplicateTopK(collected, h -> h.match().id(), order, topK)
-                    .stream()
-                    .map(HeapItem::match)
-                    .toList();
+            List<ShardHit> top = first.deduplicateTopK(hits,
+                    h -> h.member() + ":" + h.item().match().id(), SHARD_ORDER, topK);
+            List<List<ResonanceMatch>> byMember = new ArrayList<>(n);
+            for (int i = 0; i < n; i++) {
+                byMember.add(new ArrayList<>());
+            }
+            for (ShardHit hit : top) {
+                byMember.get(hit.member()).add(hit.item().match());
+            }
+            List<Iterator<ResonanceMatch>> projected = new ArrayList<>(n);
+            for (int i = 0; i < n; i++) {
+                projected.add(members.get(i).project(snapshots[i], byMember.get(i), effective.projection()).iterator());
+            }
+            List<CorpusMatch> matches = new ArrayList<>(top.size());
+            for (ShardHit hit : top) {
+                matches.add(CorpusMatch.of(corpusIds.get(hit.member()), projected.get(hit.member()).next()));
+            }
 
-            return materializePatterns(prelim);
+            QueryProfile shared = profiles[0];
+            return new QueryResult<>(matches, effective.withPhaseEpsilon(epsilon),
+                    shared.segmentsScanned.get(), shared.scored.get(), shared.expired());
+        } finally {
+            for (CorpusSnapshot snapshot : snapshots) {
+                if (snapshot != null) {
+                    snapshot.close();
+                }
+            }
         }
     }
 
     @Override
-    public List<ResonanceMatchDetailed> queryDetailed(WavePattern query, int topK) {
+    public QueryPage<ResonanceMatch> queryPage(WavePattern query, int pageSize, String cursor, QueryOptions options) {
         ensureOpen();
         validateWavePatternLen(query);
-        if (topK <= 0) {
-            return List.of();
+        Objects.requireNonNull(options, "options must not be null");
+        QueryOptions effective = effectiveOptions(options, Math.max(1, pageSize));
+        QueryCursor from = cursor != null ? QueryCursor.decode(cursor) : null;
+        if (pageSize <= 0) {
+            return new QueryPage<>(List.of(), cursor, effective, corpusVersion.get(), false);
         }
 
-        try (AutoLock ignored = AutoLock.read(globalLock)) {
+        long deadline = deadlineOf(effective);
+        try (QueryAdmissionController.Permit admission = admit(effective.priority(), deadline);
+             CorpusSnapshot snapshot = pinSnapshot()) {
+            long version = snapshot.version();
             String queryId = HashingUtil.computeContentHash(query);
+            if (from != null && !from.queryId().equals(queryId)) {
+                throw new IllegalArgumentException("Cursor was issued for a different query");
+            }
 
-            Comparator<HeapItemDetailed> order = Comparator
-                    .comparingDouble(HeapItemDetailed::priority).reversed()
-                    .thenComparing((HeapItemDetailed h) -> h.match().energy(), Comparator.reverseOrder())
-                    .thenComparing(h -> h.match().id());
-
-            List<SegmentWriter> writers = selectWritersForQuery(query);
-            int threshold = Math.max(4, writers.size() / Math.max(1, tune.poolParallelism));
-
-            List<HeapItemDetailed> collected = queryPool.invoke(
-                    new DetailedMatchQueryTask(writers, query, queryId, topK, 0, writers.size(), threshold)
-            );
-
-            if (collected.size() < topK) {
-                Set<String> seen = new HashSet<>();
-                for (SegmentWriter writer : writers) {
-                    seen.add(writer.getSegmentName());
-                }
+            PageEntry entry = from != null && from.version() == version ? pageCache.getIfPresent(cursor) : null;
+            boolean partial = false;
+            if (entry == null || (entry.items().size() < pageSize && !entry.complete())) {
+                int depth = (int) Math.min(Integer.MAX_VALUE, (long) pageSize * CURSOR_PREFETCH_PAGES);
+                HeapItem after = from != null
+                        ? new HeapItem(new ResonanceMatch(from.id(), from.energy(), null), from.priority())
+                        : null;
+                QueryProfile profile = new QueryProfile(snapshot, query, effective, after, deadline);
+                List<HeapItem> ranked = deduplicateTopK(scanMatches(profile, depth).items(),
+                        h -> h.match().id(), MATCH_ORDER, depth);
+                partial = profile.expired;
+                entry = new PageEntry(ranked, ranked.size() < depth && !profile.stopped());
+            }
+            if (cursor != null) {
+                pageCache.invalidate(cursor);
+            }
 
-                List<SegmentWriter> rest = getAllWritersStream()
-                        .filter(w -> !seen.contains(w.getSegmentName()))
-                        .toList();
+            List<HeapItem> items = entry.items();
+            List<HeapItem> page = items.subList(0, Math.min(pageSize, items.size()));
+            List<HeapItem> rest = items.subList(page.size(), items.size());
 
+            String next = null;
+            if (page.size() == pageSize && !(rest.isEmpty() && entry.complete())) {
+                HeapItem last = page.getLast();
+                next = new QueryCursor(version, queryId, last.priority(), last.match().energy(), last.match().id()).encode();
                 if (!rest.isEmpty()) {
-                    List<HeapItemDetailed> extra = queryPool.invoke(
-                            new DetailedMatchQueryTask(rest, query, queryId, topK, 0, rest.size(), threshold)
-                    );
-                    collected.addAll(extra);
+                    pageCache.put(next, new PageEntry(List.copyOf(rest), entry.complete()));
                 }
             }
 
-            return deduplicateTopK(collected, h -> h.match().id(), order, topK)
-                    .stream()
-                    .map(HeapItemDetailed::match)
-                    .toList();
+            List<ResonanceMatch> matches = page.stream().map(HeapItem::match).toList();
+            return new QueryPage<>(project(snapshot, matches, effective.projection()), next, effective, version, partial);
         }
     }
 
     @Override
-    public InterferenceMap queryInterference(WavePattern query, int topK) {
-        ensureOpen();
-        return new InterferenceMap(query, queryDetailed(query, topK));
+    public List<ResonanceMatchDetailed> queryDetailed(WavePattern query, int topK) {
+        return queryDetailed(query, topK, QueryOptions.defaultOptions());
     }
 
     @Override
-    public List<InterferenceEntry> queryInterferenceMap(WavePattern query, int topK) {
-        ensureOpen();
-        return queryDetailed(query, topK).stream()
-                .map(m -> new InterferenceEntry(
-                        m.id(),
-                        m.energy(),
-                        m.phaseDelta(),
-                        m.zone(),
-                        m.pattern()
-                ))
-                .toList();
+    public List<ResonanceMatchDetailed> queryDetailed(WavePattern query, int topK, QueryOptions options) {
+        return queryDetailedResult(query, topK, options).matches();
     }
 
     @Override
-    public List<ResonanceMatch> queryComposite(List<WavePattern> patterns, List<Double> weights, int topK) {
+    public QueryResult<ResonanceMatchDetailed> queryDetailedResult(WavePattern query, int topK, QueryOptions options) {
         ensureOpen();
-        Objects.requireNonNull(patterns, "patterns must not be null");
-        if (patterns.isEmpty()) {
-            throw new InvalidWavePatternException("Empty pattern list in composite query");
+        validateWavePatternLen(query);
+        Objects.requireNonNull(options, "options must not be null");
+        QueryOptions effective = effectiveOptions(options, topK);
+        if (topK <= 0) {
+            return new QueryResult<>(List.of(), effective, 0, 0L, false);
         }
-        patterns.forEach(this::validateWavePatternLen);
+        if (!COALESCE_QUERIES) {
+            return rankDetailed(query, topK, effective);
+        }
+        FlightKey key = new FlightKey(HashingUtil.computeContentHash(query), topK, effective, corpusVersion.get());
+        return detailedFlights.execute(key, () -> rankDetailed(query, topK, effective), WavePatternStoreImpl::asyncCancelled);
+    }
 
-        WavePattern superposed = WavePatternUtils.superpose(patterns, weights);
-        return query(superposed, topK);
+    private QueryResult<ResonanceMatchDetailed> rankDetailed(WavePattern query, int topK, QueryOptions effective) {
+        long deadline = deadlineOf(effective);
+        try (CorpusSnapshot snapshot = pinSnapshot()) {
+            long version = snapshot.version();
+            QueryResultCache.Key cacheKey = new QueryResultCache.Key(
+                    HashingUtil.computeContentHash(query), topK, effective, true);
+            QueryResult<ResonanceMatchDetailed> cached = resultCache.get(cacheKey, version);
+            if (cached != null) {
+                return cached;
+            }
+            return rankDetailedAdmitted(snapshot, query, topK, effective, cacheKey, deadline);
+        }
+    }
+
+    private QueryResult<ResonanceMatchDetailed> rankDetailedAdmitted(CorpusSnapshot snapshot, WavePattern query,
+                                                                     int topK, QueryOptions effective,
+                                                                     QueryResultCache.Key cacheKey, long deadline) {
+        try (QueryAdmissionController.Permit admission = admit(effective.priority(), snapshot, deadline)) {
+            QueryProfile profile = new QueryProfile(snapshot, query, effective, deadline);
+            long version = snapshot.version();
+
+            // Phase 1: plain energy top-K over an overfetched pool; phase 2: phase delta and zones for survivors only.
+            int pool = (int) Math.min(Integer.MAX_VALUE, (long) topK * Math.max(1, effective.overfetch()));
+            MatchScan scan = scanMatches(profile, pool);
+            List<HeapItem> survivors = deduplicateTopK(scan.items(), h -> h.match().id(), MATCH_ORDER, pool);
+            List<HeapItemDetailed> refined = refineDetailed(profile, survivors);
+
+            if (effective.exact() && survivors.size() >= pool && !profile.expired()
+                    && !refinementCovers(refined, survivors, topK)) {
+                QueryProfile full = new QueryProfile(snapshot, query, effective, deadline);
+                refined = scanDetailed(full, topK, scan.routing());
+                profile = full;
+            }
+
+            List<ResonanceMatchDetailed> matches = refined.stream()
+                    .sorted(DETAILED_ORDER)
+                    .limit(topK)
+                    .map(HeapItemDetailed::match)
+                    .toList();
+            QueryResult<ResonanceMatchDetailed> result = new QueryResult<>(
+                    projectDetailed(matches, effective.projection()),
+                    effective.withPhaseEpsilon(scan.routing().epsilon()),
+                    profile.segmentsScanned.get(),
+                    profile.scored.get(),
+                    profile.expired
+            );
+            resultCache.put(cacheKey, version, result);
+            return result;
+        }
     }
 
     @Override
-    public List<ResonanceMatchDetailed> queryCompositeDetailed(List<WavePattern> patterns, List<Double> weights, int topK) {
+    public List<List<ResonanceMatch>> queryBatch(List<WavePattern> queries, int topK) {
         ensureOpen();
-        Objects.requireNonNull(patterns, "patterns must not be null");
-        if (patterns.isEmpty()) {
-            throw new InvalidWavePatternException("Empty pattern list in composite query");
+        Objects.requireNonNull(queries, "queries must not be null");
+        queries.forEach(this::validateWavePatternLen);
+        if (queries.isEmpty()) {
+            return List.of();
         }
-        patterns.forEach(this::validateWavePatternLen);
+        if (topK <= 0) {
+            return Collections.nCopies(queries.size(), List.of());
+        }
+
+        QueryOptions options = effectiveOptions(QueryOptions.defaultOptions(), topK)
+                .withScanMode(QueryOptions.ScanMode.FULL)
+                .withSketchPrefilter(false)
+                .withMaxCandidates(0);
+        long deadline = deadlineOf(options);
+        try (QueryAdmissionController.Permit admission = admit(QueryOptions.Priority.BATCH, deadline);
+             CorpusSnapshot snapshot = pinSnapshot()) {
+            QueryProfile[] profiles = new QueryProfile[queries.size()];
+            List<List<SegmentWriter>> routedWriters = new ArrayList<>(profiles.length);
+            Map<String, SegmentWriter> byName = new HashMap<>();
+            Map<String, List<Integer>> routes = new LinkedHashMap<>();
+            for (int q = 0; q < profiles.length; q++) {
+                profiles[q] = new QueryProfile(snapshot, queries.get(q), options, deadline);
+                List<SegmentWriter> writers = routeQuery(profiles[q]).writers();
+                routedWriters.add(writers);
+                addRoutes(routes, byName, writers, q);
+            }
 
-        WavePattern superposed = WavePatternUtils.superpose(patterns, weights);
-        return queryDetailed(superposed, topK);
+            List<List<HeapItem>> collected = runBatch(routes, byName, profiles, topK);
+
+            Map<String, List<Integer>> fallback = new LinkedHashMap<>();
+            for (int q = 0; q < profiles.length; q++) {
+                if (collected.get(q).size() < topK && !profiles[q].expired()) {
+                    addRoutes(fallback, byName,
+                            remainingWriters(snapshot, routedWriters.get(q), options.maxSegments()), q);
+                }
+            }
+            if (!fallback.isEmpty()) {
+                List<List<HeapItem>> extra = runBatch(fallback, byName, profiles, topK);
+                for (int q = 0; q < profiles.length; q++) {
+                    collected.get(q).addAll(extra.get(q));
+                }
+            }
+
+            List<List<ResonanceMatch>> results = new ArrayList<>(profiles.length);
+            for (List<HeapItem> items : collected) {
+                List<ResonanceMatch> prelim = deduplicateTopK(items, h -> h.match().id(), MATCH_ORDER, topK)
+                        .stream()
+                        .map(HeapItem::match)
+                        .toList();
+                results.add(materializePatterns(snapshot, prelim));
+            }
+            return results;
+        }
     }
 
     @Override
-    public float compare(WavePattern a, WavePattern b) {
-        ensureOpen();
-        validateWavePatternLen(a);
-        validateWavePatternLen(b);
-        return resonanceKernel.compare(a, b);
+    public CompletableFuture<String> insertAsync(WavePattern psi, Map<String, String> metadata) {
+        return submitAsync(() -> insert(psi, metadata), true);
     }
 
-    public PhaseShardSelector getShardSelector() {
-        return shardSelectorRef.get();
+    @Override
+    public CompletableFuture<Void> deleteAsync(String id) {
+        return submitAsync(() -> {
+            delete(id);
+            return null;
+        }, true);
     }
 
-    public void compactPhase(String baseName) {
-        PhaseSegmentGroup group = segmentGroups.get(baseName);
-        if (group != null && group.maybeCompact()) {
-            rebuildShardSelector();
-        }
+    @Override
+    public CompletableFuture<String> replaceAsync(String id, WavePattern psi, Map<String, String> metadata) {
+        return submitAsync(() -> replace(id, psi, metadata), true);
     }
 
-    public boolean containsExactPattern(WavePattern pattern) {
-        ensureOpen();
-        validateWavePatternLen(pattern);
-        return manifest.contains(HashingUtil.computeContentHash(pattern));
+    @Override
+    public CompletableFuture<List<ResonanceMatch>> queryAsync(WavePattern query, int topK, QueryOptions options) {
+        return submitAsync(() -> query(query, topK, options), false);
     }
 
     @Override
-    public void close() {
-        if (!closed.compareAndSet(false, true)) {
-            return;
-        }
+    public CompletableFuture<QueryResult<ResonanceMatch>> queryResultAsync(WavePattern query, int topK, QueryOptions options) {
+        return submitAsync(() -> queryResult(query, topK, options), false);
+    }
 
-        try (AutoLock ignored = AutoLock.write(globalLock)) {
-            compactionTask.cancel(false);
-            readerCache.close();
-            segmentGroups.values().forEach(group -> group.getAll().forEach(this::safeClose));
-            manifest.flush();
-            metaStore.flush();
-        } finally {
+    @Override
+    public CompletableFuture<List<List<ResonanceMatch>>> queryBatchAsync(List<WavePattern> queries, int topK) {
+        return submitAsync(() -> queryBatch(queries, topK), false);
+    }
+
+    @Override
+    public CompletableFuture<QueryResult<ResonanceMatchDetailed>> queryDetailedResultAsync(WavePattern query,
+                                                                                          int topK,
+                                                                                          QueryOptions options) {
+        return submitAsync(() -> queryDetailedResult(query, topK, options), false);
+    }
+
+    /**
+     * Runs {@code call} as a query-pool task and completes the returned future with its outcome. Scans
+     * fork into the same pool instead of parking the caller in {@link ForkJoinPool#invoke}; a future
+     * cancelled before the task starts never runs, and one cancelled later stops its scans through
+     * {@link QueryProfile#expired()}. Mutations ({@code blocking}) wait on locks and fsync, so they run
+     * as managed blockers and the pool compensates with a spare worker.
+     */
+    private <T> CompletableFuture<T> submitAsync(Supplier<T> call, boolean blocking) {
+        return submitAsync(queryPool, call, blocking);
+    }
+
+    static <T> CompletableFuture<T> submitAsync(ForkJoinPool pool, Supplier<T> call, boolean blocking) {
+        CompletableFuture<T> future = new CompletableFuture<>();
+        Runnable task = () -> {
+            if (future.isDone()) {
+                return;
+            }
+            Future<?> outer = ASYNC_ORIGIN.get();
+            ASYNC_ORIGIN.set(future);
+            try {
+                future.complete(blocking ? managedBlock(call) : call.get());
+            } catch (Throwable t) {
+                future.completeExceptionally(t);
+            } finally {
+                if (outer == null) {
+                    ASYNC_ORIGIN.remove();
+                } else {
+                    ASYNC_ORIGIN.set(outer);
+                }
+            }
+        };
+        try {
+            pool.execute(task);
+        } catch (RejectedExecutionException e) {
+            future.completeExceptionally(e);
+        }
+        return future;
+    }
+
+    /** True when the async call running on this thread was cancelled, so whatever it computed may be cut short. */
+    private static boolean asyncCancelled() {
+        Future<?> origin = ASYNC_ORIGIN.get();
+        return origin != null && origin.isCancelled();
+    }
+
+    private static <T> T managedBlock(Supplier<T> call) throws InterruptedException {
+        final class Blocker implements ForkJoinPool.ManagedBlocker {
+            private T value;
+            private boolean done;
+
+            @Override
+            public boolean block() {
+                value = call.get();
+                done = true;
+                return true;
+            }
+
+            @Override
+            public boolean isReleasable() {
+                return done;
+            }
+        }
+        Blocker blocker = new Blocker();
+        ForkJoinPool.managedBlock(blocker);
+        return blocker.value;
+    }
+
+    private static void addRoutes(Map<String, List<Integer>> routes,
+                                  Map<String, SegmentWriter> byName,
+                                  List<SegmentWriter> writers,
+                                  int query) {
+        for (SegmentWriter writer : writers) {
+            byName.putIfAbsent(writer.getSegmentName(), writer);
+            routes.computeIfAbsent(writer.getSegmentName(), k -> new ArrayList<>()).add(query);
+        }
+    }
+
+    private List<List<HeapItem>> runBatch(Map<String, List<Integer>> routes,
+                                          Map<String, SegmentWriter> byName,
+                                          QueryProfile[] profiles,
+                                          int topK) {
+        List<SegmentWriter> writers = new ArrayList<>(routes.size());
+        Map<String, int[]> targets = new HashMap<>();
+        routes.forEach((name, queries) -> {
+            writers.add(byName.get(name));
+            targets.put(name, queries.stream().mapToInt(Integer::intValue).toArray());
+        });
+        int threshold = SEGMENTS_PER_TASK;
+
+        List<BatchHit> hits = invokeByResidency(profiles[0].snapshot, writers,
+                part -> new BatchQueryTask(part, targets, profiles, topK, 0, part.size(), threshold));
+
+        List<List<HeapItem>> out = new ArrayList<>(profiles.length);
+        for (int q = 0; q < profiles.length; q++) {
+            out.add(new ArrayList<>());
+        }
+        for (BatchHit hit : hits) {
+            out.get(hit.query()).add(hit.item());
+        }
+        return out;
+    }
+
+    /** Runs the tasks for {@code writers} on the query pool, page-cache resident and cold segments side by side. */
+    private <T> List<T> invokeByResidency(CorpusSnapshot snapshot,
+                                          List<SegmentWriter> writers,
+                                          Function<List<SegmentWriter>, QueryTask<T>> taskFor) {
+        return ResidencyScheduler.invoke(queryPool, writers,
+                writer -> isResident(snapshot, writer),
+                writer -> snapshot.reader(writer.getSegmentName()).prefetch(),
+                taskFor);
+    }
+
+    /** Federated counterpart of {@link #invokeByResidency}, splitting the segments of every store by residency. */
+    private static List<ShardHit> invokeShards(ForkJoinPool pool, List<Shard> shards, int topK) {
+        return ResidencyScheduler.invoke(pool, shards,
+                shard -> isResident(shard.profile().snapshot, shard.writer()),
+                shard -> shard.profile().snapshot.reader(shard.writer().getSegmentName()).prefetch(),
+                wave -> new FederatedMatchTask(wave, topK, 0, wave.size()));
+    }
+
+    /** Segments without a pinned reader count as resident: there is nothing to read ahead. */
+    private static boolean isResident(CorpusSnapshot snapshot, SegmentWriter writer) {
+        CachedReader reader = writer == null ? null : snapshot.reader(writer.getSegmentName());
+        return reader == null || reader.isResident();
+    }
+
+    /** Resolves adaptive values; exact mode clears every option that could drop a candidate. */
+    private QueryOptions effectiveOptions(QueryOptions options, int topK) {
+        QueryOptions effective = options.overfetch() > 0
+                ? options
+                : options.withOverfetch(tune.overfetchForTopK(topK));
+        if (effective.exact()) {
+            effective = effective.withSketchPrefilter(false).withMaxSegments(0).withMaxCandidates(0);
+        }
+        return effective;
+    }
+
+    private MatchScan scanMatches(QueryProfile profile, int topK) {
+        Routing routing = routeQuery(profile);
+        List<SegmentWriter> writers = routing.writers();
+        int threshold = SEGMENTS_PER_TASK;
+
+        List<HeapItem> collected = invokeByResidency(profile.snapshot, writers,
+                part -> new MatchQueryTask(part, profile, topK, 0, part.size(), threshold));
+
+        if (collected.size() < topK && !profile.expired()) {
+            List<SegmentWriter> rest = remainingWriters(profile.snapshot, writers, profile.options.maxSegments());
+            if (!rest.isEmpty()) {
+                List<HeapItem> extra = invokeByResidency(profile.snapshot, rest,
+                        part -> new MatchQueryTask(part, profile, topK, 0, part.size(), threshold));
+                collected.addAll(extra);
+            }
+        }
+        return new MatchScan(collected, routing);
+    }
+
+    /** Single-pass detailed scan that compares every candidate with phase delta; the exact-mode fallback. */
+    private List<HeapItemDetailed> scanDetailed(QueryProfile profile, int topK, Routing routing) {
+        List<SegmentWriter> writers = routing.writers();
+        int threshold = SEGMENTS_PER_TASK;
+        return deduplicateTopK(
+                invokeByResidency(profile.snapshot, writers,
+                        part -> new DetailedMatchQueryTask(part, profile, topK, 0, part.size(), threshold)),
+                h -> h.match().id(), DETAILED_ORDER, topK);
+    }
+
+    private List<HeapItemDetailed> refineDetailed(QueryProfile profile, List<HeapItem> survivors) {
+        final WavePattern query = profile.query;
+        final int len = query.amplitude().length;
+        List<HeapItemDetailed> out = new ArrayList<>(survivors.size());
+        for (HeapItem item : survivors) {
+            String id = item.match().id();
+            WavePattern cand = item.match().pattern();
+            if (cand == null) {
+                cand = readPattern(profile.snapshot, id);
+            }
+            if (cand == null || cand.amplitude().length != len) {
+                continue;
+            }
+            out.add(detailedItem(id, cand, resonanceKernel.compareWithPhaseDelta(query, cand), profile.queryId));
+        }
+        return out;
+    }
+
+    /**
+     * True when no candidate outside the energy pool can outrank the refined top-K: a skipped record has
+     * plain priority at most the pool's last one, and its zone can add no more than the zone reached at that energy.
+     */
+    private static boolean refinementCovers(List<HeapItemDetailed> refined, List<HeapItem> survivors, int topK) {
+        if (refined.size() < topK) {
+            return false;
+        }
+        double cut = survivors.getLast().priority();
+        double ceiling = cut + zoneScore(ResonanceZoneClassifier.classify((float) Math.min(cut, 1.0), 0.0));
+        double kth = refined.stream()
+                .sorted(DETAILED_ORDER)
+                .skip(topK - 1)
+                .findFirst()
+                .map(HeapItemDetailed::priority)
+                .orElse(Double.NEGATIVE_INFINITY);
+        return kth >= ceiling;
+    }
+
+    private static HeapItemDetailed detailedItem(String id, WavePattern cand, ComparisonResult result, String queryId) {
+        float energy = result.energy();
+        double phaseShift = result.phaseDelta();
+        ResonanceZone zone = ResonanceZoneClassifier.classify(energy, phaseShift);
+        double zoneScore = zoneScore(zone);
+
+        boolean idEq = id.equals(queryId);
+        boolean exactEq = energy > 1.0f - EXACT_MATCH_EPS;
+        double priority = zoneScore + energy + (idEq ? 1.0 : 0.0) + (exactEq ? 0.5 : 0.0);
+
+        return new HeapItemDetailed(
+                new ResonanceMatchDetailed(id, energy, cand, phaseShift, zone, zoneScore),
+                priority
+        );
+    }
+
+    private static double zoneScore(ResonanceZone zone) {
+        return switch (zone) {
+            case CORE -> 2.0;
+            case FRINGE -> 1.0;
+            case SHADOW -> 0.0;
+        };
+    }
+
+    @Override
+    public ThresholdResult queryThreshold(WavePattern query,
+                                          float minEnergy,
+                                          QueryOptions options,
+                                          Consumer<? super ResonanceMatch> sink) {
+        ensureOpen();
+        validateWavePatternLen(query);
+        Objects.requireNonNull(options, "options must not be null");
+        Objects.requireNonNull(sink, "sink must not be null");
+        if (Float.isNaN(minEnergy)) {
+            throw new IllegalArgumentException("minEnergy must not be NaN");
+        }
+        QueryOptions effective = effectiveOptions(options, 1).withSketchPrefilter(false);
+
+        long deadline = deadlineOf(effective);
+        try (QueryAdmissionController.Permit admission = admit(effective.priority(), deadline);
+             CorpusSnapshot snapshot = pinSnapshot()) {
+            QueryProfile profile = new QueryProfile(snapshot, query, effective, deadline);
+            List<SegmentWriter> writers = thresholdWriters(profile, minEnergy);
+            int threshold = SEGMENTS_PER_TASK;
+
+            LongAdder emitted = new LongAdder();
+            Object sinkLock = new Object();
+            Consumer<List<ResonanceMatch>> emit = hits -> {
+                synchronized (sinkLock) {
+                    try {
+                        for (ResonanceMatch m : hits) {
+                            sink.accept(m);
+                            emitted.increment();
+                        }
+                    } catch (RuntimeException e) {
+                        profile.cancel();
+                        throw e;
+                    }
+                }
+            };
+
+            invokeByResidency(snapshot, writers,
+                    part -> new ThresholdQueryTask(part, profile, minEnergy, emit, 0, part.size(), threshold));
+            return new ThresholdResult(
+                    emitted.sum(),
+                    effective,
+                    profile.segmentsScanned.get(),
+                    profile.scored.get(),
+                    profile.stopped()
+            );
+        }
+    }
+
+    /** Segments whose energy bound reaches {@code minEnergy}, best bound first, capped by {@code maxSegments}. */
+    private List<SegmentWriter> thresholdWriters(QueryProfile profile, float minEnergy) {
+        int maxSegments = profile.options.maxSegments();
+        Stream<SegmentWriter> eligible = profile.snapshot.writers().stream()
+                .map(w -> Map.entry(w, segmentEnergyBound(profile.snapshot, w.getSegmentName(), profile.energy)))
+                .filter(e -> e.getValue() >= minEnergy)
+                .sorted(Map.Entry.<SegmentWriter, Double>comparingByValue().reversed())
+                .map(Map.Entry::getKey);
+        return (maxSegments > 0 ? eligible.limit(maxSegments) : eligible).toList();
+    }
+
+    /**
+     * Upper bound on the energy of any record in a segment. With a fully aligned cross term
+     * {@code C = √(eA·eB)} the score is {@code (1 + f)·f / 2} for amplitude factor {@code f}.
+     */
+    private static double segmentEnergyBound(CorpusSnapshot snapshot, String segmentName, double queryEnergy) {
+        SegmentPhaseHistogram histogram = snapshot.histogram(segmentName);
+        double f = histogram != null ? histogram.maxAmplitudeFactor(queryEnergy) : 1.0;
+        return 0.5 * (1.0 + f) * f + BOUND_SLACK;
+    }
+
+    private void collectThresholdFromWriter(SegmentWriter writer,
+                                            QueryProfile profile,
+                                            float minEnergy,
+                                            Consumer<List<ResonanceMatch>> emit) {
+        if (writer == null || profile.stopped()) {
+            return;
+        }
+        final CachedReader reader = profile.snapshot.reader(writer.getSegmentName());
+        if (reader == null) {
+            return;
+        }
+        profile.segmentsScanned.incrementAndGet();
+
+        final int len = profile.query.amplitude().length;
+        final int batchSize = tune.batchSizeForLen(len, activeTasksEstimate());
+        final int total = reader.liveCount();
+        final long[] order = orderByBound(reader, profile, null, total, len);
+        scanMorsels(total, (from, to) -> {
+            scanThresholdMorsel(reader, profile, minEnergy, emit, len, batchSize, order, from, to);
+            return List.of();
+        });
+    }
+
+    /** Streams every candidate of {@code [from, to)} at or above {@code minEnergy}; {@code order} is ascending by bound. */
+    private void scanThresholdMorsel(CachedReader reader,
+                                     QueryProfile profile,
+                                     float minEnergy,
+                                     Consumer<List<ResonanceMatch>> emit,
+                                     int len,
+                                     int batchSize,
+                                     long[] order,
+                                     int from,
+                                     int to) {
+        final boolean useFlat = compareManyFlatMethod != null;
+        final FlatBuffers fb = flatBuffers();
+        fb.ensure(len, batchSize);
+
+        int inBatch = 0;
+        if (order != null) {
+            for (int j = to - 1; j >= from && !profile.stopped(); j--) {
+                if (Float.intBitsToFloat((int) (order[j] >>> 32)) < minEnergy) {
+                    break;
+                }
+                fb.ids[inBatch++] = reader.idAt((int) order[j]);
+                if (inBatch == batchSize) {
+                    processThresholdBatch(reader, profile, minEnergy, len, inBatch, useFlat, fb, emit);
+                    inBatch = 0;
+                }
+            }
+        } else {
+            for (int i = from; i < to && !profile.stopped(); i++) {
+                fb.ids[inBatch++] = reader.idAt(i);
+                if (inBatch == batchSize) {
+                    processThresholdBatch(reader, profile, minEnergy, len, inBatch, useFlat, fb, emit);
+                    inBatch = 0;
+                }
+            }
+        }
+        if (inBatch > 0) {
+            processThresholdBatch(reader, profile, minEnergy, len, inBatch, useFlat, fb, emit);
+        }
+    }
+
+    private void processThresholdBatch(CachedReader reader,
+                                       QueryProfile profile,
+                                       float minEnergy,
+                                       int len,
+                                       int requested,
+                                       boolean useFlat,
+                                       FlatBuffers fb,
+                                       Consumer<List<ResonanceMatch>> emit) {
+        final int count = profile.expired() ? 0 : profile.admit(requested);
+        if (count == 0) {
+            return;
+        }
+        final QueryOptions.Projection projection = profile.options.projection();
+        final boolean full = projection == QueryOptions.Projection.FULL;
+        final List<String> ids = new ArrayList<>();
+        final List<Float> energies = new ArrayList<>();
+        final List<WavePattern> patterns = new ArrayList<>();
+
+        final List<String> idBatch = useFlat ? null : new ArrayList<>(count);
+        final List<WavePattern> candBatch = useFlat ? null : new ArrayList<>(count);
+        final int ready;
+        boolean permit = acquireIoPermit(reader);
+        try {
+            ready = useFlat
+                    ? fillFlatBatch(reader, fb, len, count)
+                    : fillObjectBatch(reader, fb.ids, count, idBatch, candBatch, len);
+        } finally {
+            releaseIoPermit(permit);
+        }
+
+        if (useFlat) {
+            float[] scores = ready > 0 ? scoreFlat(profile.query, fb, len, ready) : new float[0];
+            for (int i = 0; i < ready; i++) {
+                if (scores[i] >= minEnergy) {
+                    ids.add(fb.ids[i]);
+                    energies.add(scores[i]);
+                    patterns.add(full
+                            ? new WavePattern(Arrays.copyOfRange(fb.ampFlat, i * len, (i + 1) * len),
+                                              Arrays.copyOfRange(fb.phaseFlat, i * len, (i + 1) * len))
+                            : null);
+                }
+            }
+        } else {
+            float[] scores = ready > 0 ? resonanceKernel.compareMany(profile.query, candBatch) : new float[0];
+            for (int i = 0; i < ready; i++) {
+                if (scores[i] >= minEnergy) {
+                    ids.add(idBatch.get(i));
+                    energies.add(scores[i]);
+                    patterns.add(full ? candBatch.get(i) : null);
+                }
+            }
+        }
+
+        if (ids.isEmpty()) {
+            return;
+        }
+        boolean withMetadata = projection == QueryOptions.Projection.IDS_SCORES_METADATA;
+        List<ResonanceMatch> hits = new ArrayList<>(ids.size());
+        for (int i = 0; i < ids.size(); i++) {
+            String id = ids.get(i);
+            hits.add(new ResonanceMatch(id, energies.get(i), patterns.get(i), withMetadata ? metadataOf(id) : null));
+        }
+        emit.accept(hits);
+    }
+
+    @Override
+    public InterferenceMap queryInterference(WavePattern query, int topK) {
+        ensureOpen();
+        return new InterferenceMap(query, queryDetailed(query, topK));
+    }
+
+    @Override
+    public List<InterferenceEntry> queryInterferenceMap(WavePattern query, int topK) {
+        ensureOpen();
+        return queryDetailed(query, topK).stream()
+                .map(m -> new InterferenceEntry(
+                        m.id(),
+                        m.energy(),
+                        m.phaseDelta(),
+                        m.zone(),
+                        m.pattern()
+                ))
+                .toList();
+    }
+
+    @Override
+    public List<ResonanceMatch> queryComposite(List<WavePattern> patterns, List<Double> weights, int topK) {
+        ensureOpen();
+        Objects.requireNonNull(patterns, "patterns must not be null");
+        if (patterns.isEmpty()) {
+            throw new InvalidWavePatternException("Empty pattern list in composite query");
+        }
+        patterns.forEach(this::validateWavePatternLen);
+
+        WavePattern superposed = WavePatternUtils.superpose(patterns, weights);
+        return query(superposed, topK);
+    }
+
+    @Override
+    public List<ResonanceMatchDetailed> queryCompositeDetailed(List<WavePattern> patterns, List<Double> weights, int topK) {
+        ensureOpen();
+        Objects.requireNonNull(patterns, "patterns must not be null");
+        if (patterns.isEmpty()) {
+            throw new InvalidWavePatternException("Empty pattern list in composite query");
+        }
+        patterns.forEach(this::validateWavePatternLen);
+
+        WavePattern superposed = WavePatternUtils.superpose(patterns, weights);
+        return queryDetailed(superposed, topK);
+    }
+
+    @Override
+    public float compare(WavePattern a, WavePattern b) {
+        ensureOpen();
+        validateWavePatternLen(a);
+        validateWavePatternLen(b);
+        return resonanceKernel.compare(a, b);
+    }
+
+    @Override
+    public QueryCacheStats queryCacheStats() {
+        return resultCache.stats(corpusVersion.get());
+    }
+
+    /** Estimated heap structures and page-cache-resident segment bytes of this store. */
+    MemoryGovernor.Footprint memoryFootprint() {
+        if (closed.get()) {
+            return MemoryGovernor.Footprint.ZERO;
+        }
+        long heap = ((long) manifest.size() + metaStore.size()) * INDEX_ENTRY_BYTES
+                + resultCache.weightedBytes() + cursorPageBytes();
+        long mapped = 0L;
+        CorpusSnapshot snapshot = snapshotRef.get();
+        if (snapshot != null && snapshot.retain()) {
+            try {
+                for (CachedReader reader : snapshot.readers()) {
+                    heap += reader.heapBytes();
+                    mapped += reader.residentBytes();
+                }
+            } finally {
+                snapshot.close();
+            }
+        }
+        return new MemoryGovernor.Footprint(heap, 0L, mapped);
+    }
+
+    /**
+     * Drops rebuildable state until about {@code bytes} are released, cheapest to rebuild first: cursor
+     * pages, then cached results. Returns the estimated bytes released.
+     */
+    long trimMemory(long bytes) {
+        if (closed.get()) {
+            return 0L;
+        }
+        long released = cursorPageBytes();
+        pageCache.invalidateAll();
+        if (released < bytes) {
+            released += resultCache.weightedBytes();
+            resultCache.invalidateAll();
+        }
+        return released;
+    }
+
+    private long cursorPageBytes() {
+        long perMatch = MATCH_OVERHEAD_BYTES + (long) patternLen * 2 * Double.BYTES;
+        long items = 0L;
+        for (PageEntry entry : pageCache.asMap().values()) {
+            items += entry.items().size();
+        }
+        return items * perMatch;
+    }
+
+    /** Monotonic counter bumped by every insert, delete, replace, compaction and bucket rebalance. */
+    public long corpusVersion() {
+        return corpusVersion.get();
+    }
+
+    /** True once every segment reader is open and the first snapshot is published. */
+    public boolean isReady() {
+        return warmup.isDone() && !warmup.isCompletedExceptionally();
+    }
+
+    /** True if warm-up failed; every operation then fails with the warm-up error. */
+    public boolean isWarmupFailed() {
+        return warmup.isCompletedExceptionally();
+    }
+
+    public int warmedSegments() {
+        return warmedSegments.get();
+    }
+
+    public int warmupSegments() {
+        return warmupSegments;
+    }
+
+    public PhaseShardSelector getShardSelector() {
+        ensureOpen();
+        return snapshotRef.get().selector();
+    }
+
+    public void compactPhase(String baseName) {
+        PhaseSegmentGroup group = segmentGroups.get(baseName);
+        if (group != null && group.maybeCompact()) {
+            try (AutoLock ignored = AutoLock.write(globalLock)) {
+                rebuildPhaseHistograms();
+                publishSnapshot();
+            }
+        }
+    }
+
+    /**
+     * Rebalances the phase range map: groups holding more than {@code resonance.bucket.split.records}
+     * live records are split at the median record phase, and adjacent ranges that together hold fewer
+     * than {@code resonance.bucket.merge.records} are merged. Records of replaced groups are moved into
+     * the new groups and the old segments are removed.
+     *
+     * <p>The records are copied into the new groups without the global lock, so writes continue meanwhile;
+     * the write lock is held only to catch up on what changed during the copy and to swap the manifest,
+     * range map and group table.</p>
+     *
+     * @return {@code true} if the range map changed
+     */
+    public boolean rebalanceBuckets() {
+        ensureOpen();
+        try (AutoLock ignored = AutoLock.of(rebalanceLock)) {
+            List<Rebalance> plans = planRebalance();
+            if (plans.isEmpty()) {
+                return false;
+            }
+            // Persist the reserved group names first, so a crash while staging cannot hand them out again.
+            bucketMap.flush();
+
+            try (CorpusSnapshot snapshot = pinSnapshot()) {
+                for (Rebalance plan : plans) {
+                    stageCopies(plan, snapshot);
+                }
+            } catch (RuntimeException e) {
+                plans.forEach(this::discardStaged);
+                throw e;
+            }
+
+            try (AutoLock swap = AutoLock.write(globalLock)) {
+                if (closed.get()) {
+                    plans.forEach(this::discardStaged);
+                    return false;
+                }
+                swapRebalanced(plans);
+            }
+            return true;
+        } catch (IOException e) {
+            throw new RuntimeException("Bucket rebalance failed", e);
+        }
+    }
+
+    @Override
+    public WavePattern getPattern(String id) throws PatternNotFoundException {
+        ensureOpen();
+        Objects.requireNonNull(id, "id must not be null");
+        HashingUtil.parseAndValidateMd5(id);
+
+        try (CorpusSnapshot snapshot = pinSnapshot()) {
+            WavePattern pattern = readPattern(snapshot, id);
+            if (pattern == null) {
+                throw new PatternNotFoundException(id);
+            }
+            return pattern;
+        }
+    }
+
+    @Override
+    public Map<String, String> getMetadata(String id) throws PatternNotFoundException {
+        ensureOpen();
+        Objects.requireNonNull(id, "id must not be null");
+        HashingUtil.parseAndValidateMd5(id);
+
+        if (!manifest.contains(id)) {
+            throw new PatternNotFoundException(id);
+        }
+        return metadataOf(id);
+    }
+
+    public boolean containsExactPattern(WavePattern pattern) {
+        ensureOpen();
+        validateWavePatternLen(pattern);
+        return manifest.contains(HashingUtil.computeContentHash(pattern));
+    }
+
+    @Override
+    public void close() {
+        if (!closed.compareAndSet(false, true)) {
+            return;
+        }
+        warmup.exceptionally(t -> null).join();
+
+        try (AutoLock ignored = AutoLock.write(globalLock)) {
+            compactionTask.cancel(false);
+            rebalanceTask.cancel(false);
+            CorpusSnapshot current = snapshotRef.get();
+            if (current != null) {
+                current.close();
+            }
+            readerCache.close();
+            resultCache.invalidateAll();
+            pageCache.invalidateAll();
+            segmentGroups.values().forEach(group -> group.getAll().forEach(this::safeClose));
+            manifest.flush();
+            metaStore.flush();
+        } finally {
             if (ownRuntime) {
                 runtime.close();
             }
@@ -625,16 +1899,295 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
         }
     }
 
+    /** Fails on a closed store and waits for warm-up, so no operation sees a partially opened corpus. */
     private void ensureOpen() {
         if (closed.get()) {
             throw new IllegalStateException("WavePatternStoreImpl is already closed");
         }
+        if (!warmup.isDone() || warmup.isCompletedExceptionally()) {
+            try {
+                warmup.join();
+            } catch (CompletionException e) {
+                throw new IllegalStateException("Corpus warm-up failed: " + corpusKey, e.getCause());
+            }
+        }
     }
 
-    private void safeCompactSweep() {
+    /**
+     * Mutations need only the manifest and the segment writers, which the constructor loads, so they
+     * do not wait for warm-up; they fail only once the store is closed or warm-up has failed.
+     */
+    private void ensureWritable() {
+        if (closed.get()) {
+            throw new IllegalStateException("WavePatternStoreImpl is already closed");
+        }
+        if (warmup.isCompletedExceptionally()) {
+            ensureOpen();
+        }
+    }
+
+    /**
+     * Opens the reader of every segment in parallel, optionally prefetching its pages, then takes the
+     * energy ranges from the summaries and publishes the first snapshot. Runs on the query pool once
+     * the constructor has returned; the last step holds the global write lock, so mutations that ran
+     * during warm-up are neither lost from nor counted twice in the rebuilt histograms.
+     */
+    private void warmUp() {
+        List<SegmentWriter> writers = getAllWritersStream().toList();
+        warmupSegments = writers.size();
+        writers.parallelStream().forEach(writer -> {
+            if (!closed.get()) {
+                CachedReader reader = readerCache.get(writer.getSegmentName());
+                if (reader != null && WARMUP_PREFETCH) {
+                    reader.prefetch();
+                }
+            }
+            warmedSegments.incrementAndGet();
+        });
         if (closed.get()) {
             return;
         }
+        try (AutoLock ignored = AutoLock.write(globalLock)) {
+            rebuildPhaseHistograms();
+            publishSnapshot(true);
+        }
+    }
+
+    private void safeRebalanceSweep() {
+        if (closed.get() || !isReady()) {
+            return;
+        }
+        try {
+            rebalanceBuckets();
+        } catch (Throwable t) {
+            System.err.println("Bucket rebalance failed: " + t.getMessage());
+        }
+    }
+
+    private Map<String, List<Double>> phasesByGroup() {
+        Map<String, String> groupOfSegment = new HashMap<>();
+        segmentGroups.forEach((name, group) ->
+                group.getAll().forEach(w -> groupOfSegment.put(w.getSegmentName(), name)));
+
+        Map<String, List<Double>> out = new HashMap<>();
+        for (ManifestIndex.PatternLocation loc : manifest.getAllLocations()) {
+            String group = groupOfSegment.get(loc.segmentName());
+            if (group != null) {
+                out.computeIfAbsent(group, k -> new ArrayList<>()).add(loc.phaseCenter());
+            }
+        }
+        return out;
+    }
+
+    /** Splits and merges the current range map calls for, with the new ranges named but not yet installed. */
+    private List<Rebalance> planRebalance() {
+        Map<String, List<Double>> phases = phasesByGroup();
+        List<Rebalance> plans = new ArrayList<>();
+        Set<String> splitting = new HashSet<>();
+        for (PhaseBucketMap.Range range : bucketMap.ranges()) {
+            List<Double> groupPhases = phases.getOrDefault(range.group(), List.of());
+            if (groupPhases.size() <= BUCKET_SPLIT_RECORDS || range.width() < 2 * BUCKET_MIN_WIDTH_RAD) {
+                continue;
+            }
+            double at = splitPoint(groupPhases, range);
+            if (Double.isNaN(at)) {
+                continue;
+            }
+            plans.add(new Rebalance(List.of(range), bucketMap.planSplit(range.group(), at)));
+            splitting.add(range.group());
+        }
+        for (List<PhaseBucketMap.Range> run : mergeRuns(phases, splitting)) {
+            plans.add(new Rebalance(run, List.of(bucketMap.planMerge(run))));
+        }
+        return plans;
+    }
+
+    private static double splitPoint(List<Double> phases, PhaseBucketMap.Range range) {
+        double[] sorted = phases.stream()
+                .mapToDouble(p -> Math.max(range.lo(), Math.min(range.hi(), p)))
+                .sorted()
+                .toArray();
+        double at = sorted[sorted.length / 2];
+        if (at - range.lo() < BUCKET_MIN_WIDTH_RAD || range.hi() - at < BUCKET_MIN_WIDTH_RAD) {
+            return Double.NaN;
+        }
+        return at;
+    }
+
+    /**
+     * Maximal runs of adjacent ranges whose records together stay below {@link #BUCKET_MERGE_RECORDS};
+     * each run of two or more ranges is merged and redistributed once. Ranges being split end a run.
+     */
+    private List<List<PhaseBucketMap.Range>> mergeRuns(Map<String, List<Double>> phases, Set<String> splitting) {
+        List<List<PhaseBucketMap.Range>> runs = new ArrayList<>();
+        List<PhaseBucketMap.Range> run = new ArrayList<>();
+        int runCount = 0;
+        for (PhaseBucketMap.Range range : bucketMap.ranges()) {
+            int count = phases.getOrDefault(range.group(), List.of()).size();
+            boolean mergeable = !splitting.contains(range.group());
+            if (mergeable && !run.isEmpty() && runCount + count > 0 && runCount + count < BUCKET_MERGE_RECORDS) {
+                run.add(range);
+                runCount += count;
+                continue;
+            }
+            if (run.size() > 1) {
+                runs.add(run);
+            }
+            run = new ArrayList<>();
+            if (mergeable) {
+                run.add(range);
+            }
+            runCount = count;
+        }
+        if (run.size() > 1) {
+            runs.add(run);
+        }
+        return runs;
+    }
+
+    /**
+     * Copies the live records of the plan's source groups, as {@code snapshot} sees them, into newly
+     * created groups for its target ranges. Runs without the global lock while writers keep changing the
+     * sources; {@link #swapRebalanced} moves only the copies that are still current.
+     */
+    private void stageCopies(Rebalance plan, CorpusSnapshot snapshot) {
+        for (PhaseBucketMap.Range target : plan.targets()) {
+            plan.groups().add(new PhaseSegmentGroup(target.group(), rootDir.resolve("segments"), compactor));
+        }
+        for (PhaseBucketMap.Range source : plan.sources()) {
+            PhaseSegmentGroup group = segmentGroups.get(source.group());
+            if (group == null) {
+                continue;
+            }
+            for (SegmentWriter old : group.getAll()) {
+                CachedReader reader = snapshot.reader(old.getSegmentName());
+                if (reader == null) {
+                    continue;
+                }
+                reader.lazyStream().forEach(entry -> {
+                    ManifestIndex.PatternLocation loc = manifest.get(entry.id());
+                    if (loc != null
+                            && loc.segmentName().equals(old.getSegmentName())
+                            && loc.offset() == entry.offset()) {
+                        plan.copies().put(entry.id(), stage(plan, entry.id(), entry.pattern(), loc));
+                    }
+                });
+            }
+        }
+    }
+
+    /** Appends one record to the staged group whose range holds its phase. */
+    private StagedRecord stage(Rebalance plan, String id, WavePattern pattern, ManifestIndex.PatternLocation from) {
+        PhaseSegmentGroup group = plan.groups().get(plan.targetOf(from.phaseCenter()));
+        while (true) {
+            SegmentWriter writer = group.writableFor(pattern);
+            try {
+                return new StagedRecord(from, writer, writer.write(id, pattern));
+            } catch (SegmentOverflowException ignored) {
+                // writableFor rolls over on the next attempt
+            }
+        }
+    }
+
+    /**
+     * Installs staged rebalances; caller holds the global write lock. Copies whose source entry is unchanged
+     * are taken over as they are; records written, replaced or compacted since staging are copied now, and
+     * stale copies are tombstoned. Then the range map and group table are swapped and the old segments removed.
+     */
+    private void swapRebalanced(List<Rebalance> plans) throws IOException {
+        List<SegmentWriter> retired = new ArrayList<>();
+        Set<SegmentWriter> dirty = new LinkedHashSet<>();
+
+        for (Rebalance plan : plans) {
+            Map<String, SegmentWriter> sources = new HashMap<>();
+            for (PhaseBucketMap.Range range : plan.sources()) {
+                PhaseSegmentGroup group = segmentGroups.remove(range.group());
+                if (group != null) {
+                    group.getAll().forEach(w -> sources.put(w.getSegmentName(), w));
+                }
+            }
+
+            Map<String, SegmentReader> readers = new HashMap<>();
+            try {
+                for (SegmentWriter old : sources.values()) {
+                    old.flush();
+                }
+                for (Map.Entry<String, ManifestIndex.PatternLocation> e : manifest.locationsIn(sources.keySet()).entrySet()) {
+                    String id = e.getKey();
+                    ManifestIndex.PatternLocation loc = e.getValue();
+                    StagedRecord copy = plan.copies().remove(id);
+                    if (copy == null || !copy.from().equals(loc)) {
+                        if (copy != null) {
+                            copy.writer().markDeleted(copy.offset());
+                        }
+                        SegmentReader reader = readers.computeIfAbsent(loc.segmentName(),
+                                name -> new SegmentReader(sources.get(name).getPath()));
+                        copy = stage(plan, id, reader.readWithId(loc.offset()).pattern(), loc);
+                    }
+                    manifest.replace(id, loc.segmentName(), loc.offset(),
+                            copy.writer().getSegmentName(), copy.offset(), loc.phaseCenter());
+                    plan.groups().get(plan.targetOf(loc.phaseCenter())).updatePhaseStats(loc.phaseCenter());
+                    dirty.add(copy.writer());
+                }
+            } finally {
+                for (SegmentReader reader : readers.values()) {
+                    reader.close();
+                }
+            }
+            // Records deleted while they were being copied.
+            for (StagedRecord stale : plan.copies().values()) {
+                stale.writer().markDeleted(stale.offset());
+                dirty.add(stale.writer());
+            }
+
+            bucketMap.replace(plan.sources(), plan.targets());
+            plan.groups().forEach(group -> segmentGroups.put(group.getBaseName(), group));
+            retired.addAll(sources.values());
+        }
+
+        for (SegmentWriter writer : dirty) {
+            writer.flush();
+            writer.sync();
+            registerSegment(writer);
+        }
+
+        // Persist the new layout before the retired segments disappear, as the compactor does.
+        for (SegmentWriter old : retired) {
+            manifest.unregisterSegment(old.getSegmentName());
+        }
+        manifest.flush();
+        bucketMap.flush();
+        for (SegmentWriter old : retired) {
+            safeClose(old);
+            readerCache.evict(old.getSegmentName());
+            Files.deleteIfExists(old.getPath());
+            Files.deleteIfExists(SummarySidecar.pathFor(old.getPath()));
+            Files.deleteIfExists(SegmentIdIndex.pathFor(old.getPath()));
+        }
+        rebuildPhaseHistograms();
+        publishSnapshot();
+    }
+
+    /** Removes the groups staged for a rebalance that is not installed; their segments never reached the manifest. */
+    private void discardStaged(Rebalance plan) {
+        for (PhaseSegmentGroup group : plan.groups()) {
+            for (SegmentWriter writer : group.getAll()) {
+                safeClose(writer);
+                try {
+                    Files.deleteIfExists(writer.getPath());
+                    Files.deleteIfExists(SummarySidecar.pathFor(writer.getPath()));
+                    Files.deleteIfExists(SegmentIdIndex.pathFor(writer.getPath()));
+                } catch (IOException e) {
+                    System.err.println("Failed to remove staged segment: " + writer.getSegmentName());
+                }
+            }
+        }
+    }
+
+    private void safeCompactSweep() {
+        if (closed.get() || !isReady()) {
+            return;
+        }
         try {
             segmentGroups.keySet().forEach(this::compactPhase);
         } catch (Throwable t) {
@@ -642,133 +2195,391 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
         }
     }
 
-    private List<HeapItem> collectMatchesFromWriter(SegmentWriter writer,
-                                                    WavePattern query,
-                                                    String queryId,
-                                                    int topK) {
-        if (writer == null) {
+    private List<HeapItem> collectMatchesFromWriter(SegmentWriter writer, QueryProfile profile, int topK) {
+        if (writer == null || profile.expired()) {
             return List.of();
         }
-
-        final Comparator<HeapItem> cmp = Comparator.comparingDouble(HeapItem::priority);
-        final CachedReader reader = readerCache.get(writer.getSegmentName());
+        final CachedReader reader = profile.snapshot.reader(writer.getSegmentName());
         if (reader == null) {
             return List.of();
         }
+        profile.segmentsScanned.incrementAndGet();
 
-        final int len = query.amplitude().length;
+        final int len = profile.query.amplitude().length;
         final int batchSize = tune.batchSizeForLen(len, activeTasksEstimate());
+
+        final int[] selected = selectBySketch(reader, profile, topK);
+        final int total = selected != null ? selected.length : reader.liveCount();
+        final long[] order = total > topK ? orderByBound(reader, profile, selected, total, len) : null;
+
+        return scanMorsels(total,
+                (from, to) -> scanMatchMorsel(reader, profile, topK, len, batchSize, selected, order, from, to));
+    }
+
+    /**
+     * Scores candidates {@code [from, to)} of one segment into a local top-K heap. With a bound
+     * {@code order} the range is walked from its highest bound down and stops once no candidate can enter.
+     */
+    private List<HeapItem> scanMatchMorsel(CachedReader reader,
+                                           QueryProfile profile,
+                                           int topK,
+                                           int len,
+                                           int batchSize,
+                                           int[] selected,
+                                           long[] order,
+                                           int from,
+                                           int to) {
+        final Comparator<HeapItem> cmp = MATCH_ORDER.reversed();
         final int localCap = Math.max(topK, 8);
         final boolean useFlat = compareManyFlatMethod != null;
 
         final PriorityQueue<HeapItem> heap = new PriorityQueue<>(localCap, cmp);
-        final FlatBuffers fb = TL_FLAT.get();
+        final FlatBuffers fb = flatBuffers();
         fb.ensure(len, batchSize);
 
-        int inBatch = 0;
-        for (String id : reader.allIds()) {
-            fb.ids[inBatch++] = id;
-            if (inBatch == batchSize) {
-                processMatchBatch(reader, query, queryId, topK, len, inBatch, useFlat, fb, heap, cmp);
-                inBatch = 0;
+        if (order != null) {
+            int step = Math.max(1, Math.min(batchSize, BOUND_BATCH));
+            int inBatch = 0;
+            for (int j = to - 1; j >= from; j--) {
+                float bound = Float.intBitsToFloat((int) (order[j] >>> 32));
+                if ((heap.size() >= topK && bound < heap.peek().priority())
+                        || bound < profile.floor() || profile.stopped()) {
+                    break;
+                }
+                fb.ids[inBatch++] = reader.idAt((int) order[j]);
+                if (inBatch == step) {
+                    processMatchBatch(reader, profile, topK, len, inBatch, useFlat, fb, heap, cmp);
+                    inBatch = 0;
+                }
+            }
+            if (inBatch > 0) {
+                processMatchBatch(reader, profile, topK, len, inBatch, useFlat, fb, heap, cmp);
+            }
+        } else {
+            int inBatch = 0;
+            for (int i = from; i < to && !profile.stopped(); i++) {
+                fb.ids[inBatch++] = reader.idAt(selected != null ? selected[i] : i);
+                if (inBatch == batchSize) {
+                    processMatchBatch(reader, profile, topK, len, inBatch, useFlat, fb, heap, cmp);
+                    inBatch = 0;
+                }
+            }
+            if (inBatch > 0) {
+                processMatchBatch(reader, profile, topK, len, inBatch, useFlat, fb, heap, cmp);
             }
         }
 
-        if (inBatch > 0) {
-            processMatchBatch(reader, query, queryId, topK, len, inBatch, useFlat, fb, heap, cmp);
+        if (heap.size() >= topK) {
+            profile.raiseFloor(heap.peek().priority());
         }
-
         return new ArrayList<>(heap);
     }
 
+    /** Decodes each block of the segment once and scores it against every query in {@code targets}. */
+    private List<BatchHit> collectBatchFromWriter(SegmentWriter writer,
+                                                  int[] targets,
+                                                  QueryProfile[] profiles,
+                                                  int topK) {
+        if (writer == null || targets == null || allExpired(profiles, targets)) {
+            return List.of();
+        }
+        final CachedReader reader = profiles[targets[0]].snapshot.reader(writer.getSegmentName());
+        if (reader == null) {
+            return List.of();
+        }
+        for (int q : targets) {
+            profiles[q].segmentsScanned.incrementAndGet();
+        }
+
+        final int len = profiles[targets[0]].query.amplitude().length;
+        final int batchSize = tune.batchSizeForLen(len, activeTasksEstimate());
+        return scanMorsels(reader.liveCount(),
+                (from, to) -> scanBatchMorsel(reader, targets, profiles, topK, len, batchSize, from, to));
+    }
+
+    private List<BatchHit> scanBatchMorsel(CachedReader reader,
+                                           int[] targets,
+                                           QueryProfile[] profiles,
+                                           int topK,
+                                           int len,
+                                           int batchSize,
+                                           int from,
+                                           int to) {
+        final Comparator<HeapItem> cmp = MATCH_ORDER.reversed();
+        final boolean useFlat = compareManyFlatMethod != null;
+        final FlatBuffers fb = flatBuffers();
+        fb.ensure(len, batchSize);
+
+        List<PriorityQueue<HeapItem>> heaps = new ArrayList<>(targets.length);
+        for (int t = 0; t < targets.length; t++) {
+            heaps.add(new PriorityQueue<>(Math.max(topK, 8), cmp));
+        }
+
+        for (int start = from; start < to && !allExpired(profiles, targets); start += batchSize) {
+            int count = Math.min(batchSize, to - start);
+            for (int i = 0; i < count; i++) {
+                fb.ids[i] = reader.idAt(start + i);
+            }
+
+            List<String> idBatch = useFlat ? null : new ArrayList<>(count);
+            List<WavePattern> candBatch = useFlat ? null : new ArrayList<>(count);
+            int ready;
+            boolean permit = acquireIoPermit(reader);
+            try {
+                ready = useFlat
+                        ? fillFlatBatch(reader, fb, len, count)
+                        : fillObjectBatch(reader, fb.ids, count, idBatch, candBatch, len);
+            } finally {
+                releaseIoPermit(permit);
+            }
+
+            for (int t = 0; t < targets.length && ready > 0; t++) {
+                QueryProfile p = profiles[targets[t]];
+                if (p.expired()) {
+                    continue;
+                }
+                if (useFlat) {
+                    scoreAndMergeFlat(p.query, p.queryId, null, fb, len, ready, heaps.get(t), cmp, topK);
+                } else {
+                    scoreAndMergeObject(p.query, p.queryId, null, idBatch, candBatch, heaps.get(t), cmp, topK);
+                }
+                p.scored.addAndGet(ready);
+            }
+        }
+
+        List<BatchHit> out = new ArrayList<>(targets.length * topK);
+        for (int t = 0; t < targets.length; t++) {
+            for (HeapItem item : heaps.get(t)) {
+                out.add(new BatchHit(targets[t], item));
+            }
+        }
+        return out;
+    }
+
+    private static boolean allExpired(QueryProfile[] profiles, int[] targets) {
+        for (int q : targets) {
+            if (!profiles[q].expired()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Returns candidate indices packed with an upper bound of their heap priority
+     * ({@code bound bits << 32 | index}), sorted ascending by bound, or {@code null}
+     * when the scan mode has no usable bound for this segment.
+     *
+     * <p>Both bounds only loosen the interference term {@code C = Σ A_q·A_c·cos Δφ}; the score is
+     * monotone in {@code C} for fixed energies, so scoring with the loosened term can only overestimate.</p>
+     */
+    private long[] orderByBound(CachedReader reader, QueryProfile profile, int[] selected, int total, int len) {
+        return switch (profile.options.scanMode()) {
+            case SPECTRAL_PREFIX -> orderByPrefixBound(reader, profile, selected, total, len);
+            case AMPLITUDE_CASCADE -> orderByAmplitudeBound(reader, profile, selected, total, len);
+            case FULL -> null;
+        };
+    }
+
+    /** Prefix cross term plus a Cauchy–Schwarz bound on the residual: {@code C ≤ C_prefix + √(eA_rest · eB_rest)}. */
+    private long[] orderByPrefixBound(CachedReader reader, QueryProfile profile, int[] selected, int total, int len) {
+        SegmentSummary summary = reader.summary();
+        if (summary == null || summary.count() != reader.liveCount()
+                || summary.patternLen() != len || summary.prefixLen() == 0) {
+            return null;
+        }
+
+        PrefixView view = profile.prefix(summary.prefixLen());
+        double eA = profile.energy;
+        long[] order = new long[total];
+
+        for (int j = 0; j < total; j++) {
+            int idx = selected != null ? selected[j] : j;
+            float bound;
+            if (reader.idEquals(idx, profile.queryId)) {
+                bound = Float.MAX_VALUE;
+            } else {
+                double eB = summary.energy(idx);
+                double eBp = summary.prefixEnergy(idx);
+                double cross = summary.prefixCross(idx, view.re(), view.im())
+                        + PREFIX_FLOAT_TOLERANCE * Math.sqrt(view.energy() * eBp);
+                double rest = Math.sqrt(view.restEnergy() * Math.max(0.0, eB - eBp));
+                bound = priorityBound(eA, eB, cross + rest);
+            }
+            order[j] = ((long) Float.floatToIntBits(bound) << 32) | (idx & 0xFFFF_FFFFL);
+        }
+        Arrays.sort(order);
+        return order;
+    }
+
+    /** Amplitude-only interference: {@code C ≤ Σ |A_q|·|A_c|}, read from the amplitude block without trig. */
+    private long[] orderByAmplitudeBound(CachedReader reader, QueryProfile profile, int[] selected, int total, int len) {
+        double[] qAbs = profile.absAmplitude();
+        double eA = profile.energy;
+        double[] stats = new double[2];
+        long[] order = new long[total];
+
+        boolean permit = acquireIoPermit(reader);
+        try {
+            for (int j = 0; j < total; j++) {
+                int idx = selected != null ? selected[j] : j;
+                float bound;
+                if (reader.idEquals(idx, profile.queryId)) {
+                    bound = Float.MAX_VALUE;
+                } else if (reader.amplitudeProducts(idx, qAbs, stats)) {
+                    bound = priorityBound(eA, stats[1], stats[0]);
+                } else {
+                    bound = 0.0f;
+                }
+                order[j] = ((long) Float.floatToIntBits(bound) << 32) | (idx & 0xFFFF_FFFFL);
+            }
+        } finally {
+            releaseIoPermit(permit);
+        }
+        Arrays.sort(order);
+        return order;
+    }
+
+    private static float priorityBound(double eA, double eB, double crossBound) {
+        if (eA <= 0.0 || eB <= 0.0) {
+            return (float) BOUND_SLACK;
+        }
+        double c = Math.min(crossBound, Math.sqrt(eA * eB));
+        double denom = eA + eB;
+        double ampF = 2.0 * Math.sqrt(eA * eB) / denom;
+        double ub = 0.5 * (denom + 2.0 * c) / denom * ampF + BOUND_SLACK;
+        if (ub > 1.0 - EXACT_MATCH_EPS) {
+            ub += 0.5;
+        }
+        return Math.nextUp((float) ub);
+    }
+
+    private int[] selectBySketch(CachedReader reader, QueryProfile profile, int topK) {
+        final long[] querySketch = profile.sketch;
+        if (querySketch == null) {
+            return null;
+        }
+        SegmentSummary summary = reader.summary();
+        int n = reader.liveCount();
+        if (summary == null || n < SKETCH_MIN_RECORDS
+                || summary.count() != n || summary.words() != querySketch.length) {
+            return null;
+        }
+        int keep = Math.max(SKETCH_CANDIDATES, topK * profile.options.overfetch());
+        if (keep >= n) {
+            return null;
+        }
+
+        int[] dist = resonanceKernel.hammingMany(querySketch, summary.sketches(), summary.words(),
+                summary.sketchStride(), summary.recordCount());
+        int maxDist = summary.words() * Long.SIZE;
+        int[] hist = new int[maxDist + 1];
+        for (int i = 0; i < n; i++) {
+            hist[dist[summary.ordinal(i)]]++;
+        }
+
+        int cutoff = 0;
+        int accepted = hist[0];
+        while (accepted < keep && cutoff < maxDist) {
+            accepted += hist[++cutoff];
+        }
+
+        int[] out = new int[accepted];
+        int k = 0;
+        for (int i = 0; i < n; i++) {
+            if (dist[summary.ordinal(i)] <= cutoff) {
+                out[k++] = i;
+            }
+        }
+        return out;
+    }
+
     private void processMatchBatch(CachedReader reader,
-                                   WavePattern query,
-                                   String queryId,
+                                   QueryProfile profile,
                                    int topK,
                                    int len,
-                                   int count,
+                                   int requested,
                                    boolean useFlat,
                                    FlatBuffers fb,
                                    PriorityQueue<HeapItem> heap,
                                    Comparator<HeapItem> cmp) {
-        acquireIoPermitBatch();
+        final int count = profile.expired() ? 0 : profile.admit(requested);
+        if (count == 0) {
+            return;
+        }
+        final WavePattern query = profile.query;
+        final String queryId = profile.queryId;
+        final List<String> idBatch = useFlat ? null : new ArrayList<>(count);
+        final List<WavePattern> candBatch = useFlat ? null : new ArrayList<>(count);
+        final int ready;
+        boolean permit = acquireIoPermit(reader);
         try {
-            if (useFlat) {
-                int ready = fillFlatBatch(reader, fb, len, count);
-                if (ready > 0) {
-                    scoreAndMergeFlat(query, queryId, fb, len, ready, heap, cmp, topK);
-                }
-            } else {
-                List<String> idBatch = new ArrayList<>(count);
-                List<WavePattern> candBatch = new ArrayList<>(count);
-                int ready = fillObjectBatch(reader, fb.ids, count, idBatch, candBatch, len);
-                if (ready > 0) {
-                    scoreAndMergeObject(query, queryId, idBatch, candBatch, heap, cmp, topK);
-                }
-            }
+            ready = useFlat
+                    ? fillFlatBatch(reader, fb, len, count)
+                    : fillObjectBatch(reader, fb.ids, count, idBatch, candBatch, len);
         } finally {
-            releaseIoPermitBatch();
+            releaseIoPermit(permit);
+        }
+        if (ready == 0) {
+            return;
+        }
+        if (useFlat) {
+            scoreAndMergeFlat(query, queryId, profile.after, fb, len, ready, heap, cmp, topK);
+        } else {
+            scoreAndMergeObject(query, queryId, profile.after, idBatch, candBatch, heap, cmp, topK);
         }
     }
 
-    private List<HeapItemDetailed> collectDetailedFromWriter(SegmentWriter writer,
-                                                             WavePattern query,
-                                                             String queryId,
-                                                             int topK) {
-        if (writer == null) {
+    private List<HeapItemDetailed> collectDetailedFromWriter(SegmentWriter writer, QueryProfile profile, int topK) {
+        if (writer == null || profile.expired()) {
             return List.of();
         }
-
-        final Comparator<HeapItemDetailed> cmp = Comparator.comparingDouble(HeapItemDetailed::priority);
-        final CachedReader reader = readerCache.get(writer.getSegmentName());
+        final CachedReader reader = profile.snapshot.reader(writer.getSegmentName());
         if (reader == null) {
             return List.of();
         }
+        profile.segmentsScanned.incrementAndGet();
+        return scanMorsels(reader.liveCount(), (from, to) -> scanDetailedMorsel(reader, profile, topK, from, to));
+    }
 
+    private List<HeapItemDetailed> scanDetailedMorsel(CachedReader reader, QueryProfile profile, int topK, int from, int to) {
+        final Comparator<HeapItemDetailed> cmp = DETAILED_ORDER.reversed();
+        final WavePattern query = profile.query;
+        final String queryId = profile.queryId;
         final int len = query.amplitude().length;
-        final int overfetch = tune.overfetchForTopK(topK);
-        final int localCap = Math.max(Math.max(topK, 8), topK * overfetch);
+        final int localCap = Math.max(Math.max(topK, 8), topK * profile.options.overfetch());
+        final int batchSize = tune.batchSizeForLen(len, activeTasksEstimate());
 
         final PriorityQueue<HeapItemDetailed> heap = new PriorityQueue<>(localCap, cmp);
 
-        acquireIoPermitBatch();
-        try {
-            for (String id : reader.allIds()) {
-                WavePattern cand = readNoSemaphore(reader, id);
-                if (cand == null || cand.amplitude().length != len) {
-                    continue;
-                }
-
-                ComparisonResult result = resonanceKernel.compareWithPhaseDelta(query, cand);
-                float energy = result.energy();
-                double phaseShift = result.phaseDelta();
-                ResonanceZone zone = ResonanceZoneClassifier.classify(energy, phaseShift);
-                double zoneScore = switch (zone) {
-                    case CORE -> 2.0;
-                    case FRINGE -> 1.0;
-                    case SHADOW -> 0.0;
-                };
-
-                boolean idEq = id.equals(queryId);
-                boolean exactEq = energy > 1.0f - EXACT_MATCH_EPS;
-                double priority = zoneScore + energy + (idEq ? 1.0 : 0.0) + (exactEq ? 0.5 : 0.0);
-
-                HeapItemDetailed item = new HeapItemDetailed(
-                        new ResonanceMatchDetailed(id, energy, cand, phaseShift, zone, zoneScore),
-                        priority
-                );
-
-                if (heap.size() < localCap) {
-                    heap.add(item);
-                } else if (cmp.compare(item, heap.peek()) > 0) {
-                    heap.poll();
-                    heap.add(item);
+        for (int start = from; start < to && !profile.expired(); start += batchSize) {
+            int count = profile.admit(Math.min(batchSize, to - start));
+            if (count == 0) {
+                break;
+            }
+            boolean permit = acquireIoPermit(reader);
+            try {
+                for (int i = start; i < start + count && !profile.expired(); i++) {
+                    String id = reader.idAt(i);
+                    WavePattern cand = readNoSemaphore(reader, id);
+                    if (cand == null || cand.amplitude().length != len) {
+                        continue;
+                    }
+
+                    HeapItemDetailed item = detailedItem(id, cand, resonanceKernel.compareWithPhaseDelta(query, cand), queryId);
+
+                    if (heap.size() < localCap) {
+                        heap.add(item);
+                    } else if (cmp.compare(item, heap.peek()) > 0) {
+                        heap.poll();
+                        heap.add(item);
+                    }
                 }
+            } finally {
+                releaseIoPermit(permit);
             }
-            return new ArrayList<>(heap);
-        } finally {
-            releaseIoPermitBatch();
         }
+        return new ArrayList<>(heap);
     }
 
     private int fillFlatBatch(CachedReader reader, FlatBuffers fb, int len, int count) {
@@ -810,6 +2621,7 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
 
     private void scoreAndMergeObject(WavePattern query,
                                      String queryId,
+                                     HeapItem after,
                                      List<String> ids,
                                      List<WavePattern> cands,
                                      PriorityQueue<HeapItem> heap,
@@ -828,6 +2640,9 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
 
             tracer.trace(id, query, cand, energy);
             HeapItem item = new HeapItem(new ResonanceMatch(id, energy, cand), priority);
+            if (after != null && MATCH_ORDER.compare(item, after) <= 0) {
+                continue;
+            }
 
             if (heap.size() < topK) {
                 heap.add(item);
@@ -840,6 +2655,7 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
 
     private void scoreAndMergeFlat(WavePattern query,
                                    String queryId,
+                                   HeapItem after,
                                    FlatBuffers fb,
                                    int len,
                                    int count,
@@ -847,24 +2663,7 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
                                    Comparator<HeapItem> cmp,
                                    int topK) {
 
-        float[] scores;
-        try {
-            Object res = compareManyFlatMethod.invoke(
-                    resonanceKernel,
-                    query.amplitude(), query.phase(),
-                    fb.ampFlat, fb.phaseFlat,
-                    len, count
-            );
-            scores = (float[]) res;
-        } catch (ReflectiveOperationException e) {
-            List<WavePattern> cands = new ArrayList<>(count);
-            for (int i = 0; i < count; i++) {
-                double[] a = Arrays.copyOfRange(fb.ampFlat, i * len, (i + 1) * len);
-                double[] p = Arrays.copyOfRange(fb.phaseFlat, i * len, (i + 1) * len);
-                cands.add(new WavePattern(a, p));
-            }
-            scores = resonanceKernel.compareMany(query, cands);
-        }
+        float[] scores = scoreFlat(query, fb, len, count);
 
         for (int i = 0; i < count; i++) {
             String id = fb.ids[i];
@@ -875,6 +2674,9 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
             float priority = energy + (idEq ? 1.0f : 0.0f) + (exactEq ? 0.5f : 0.0f);
 
             HeapItem item = new HeapItem(new ResonanceMatch(id, energy, null), priority);
+            if (after != null && MATCH_ORDER.compare(item, after) <= 0) {
+                continue;
+            }
 
             if (heap.size() < topK) {
                 heap.add(item);
@@ -885,10 +2687,40 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
         }
     }
 
-    private List<SegmentWriter> selectWritersForQuery(WavePattern query) {
-        PhaseShardSelector selector = shardSelectorRef.get();
+    private float[] scoreFlat(WavePattern query, FlatBuffers fb, int len, int count) {
+        try {
+            Object res = compareManyFlatMethod.invoke(
+                    resonanceKernel,
+                    query.amplitude(), query.phase(),
+                    fb.ampFlat, fb.phaseFlat,
+                    len, count
+            );
+            return (float[]) res;
+        } catch (ReflectiveOperationException e) {
+            List<WavePattern> cands = new ArrayList<>(count);
+            for (int i = 0; i < count; i++) {
+                double[] a = Arrays.copyOfRange(fb.ampFlat, i * len, (i + 1) * len);
+                double[] p = Arrays.copyOfRange(fb.phaseFlat, i * len, (i + 1) * len);
+                cands.add(new WavePattern(a, p));
+            }
+            return resonanceKernel.compareMany(query, cands);
+        }
+    }
+
+    private Routing routeQuery(QueryProfile profile) {
+        CorpusSnapshot snapshot = profile.snapshot;
+        WavePattern query = profile.query;
+        QueryOptions options = profile.options;
+        PhaseShardSelector selector = snapshot.selector();
+
+        if (options.exact()) {
+            List<SegmentWriter> writers =
+                    new ArrayList<>(resolveWriters(snapshot, selector.getRelevantShards(query, Math.PI)));
+            writers.addAll(remainingWriters(snapshot, writers, 0));
+            return new Routing(writers, Math.PI);
+        }
 
-        double eps = READ_EPSILON;
+        double eps = options.phaseEpsilon();
         List<String> shardNames = selector.getRelevantShards(query, eps);
 
         int tries = 0;
@@ -898,17 +2730,44 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
             tries++;
         }
 
-        Set<String> allowed = new LinkedHashSet<>(shardNames);
-        List<SegmentWriter> writers = getAllWritersStream()
-                .filter(w -> allowed.contains(w.getSegmentName()))
-                .toList();
-
+        List<SegmentWriter> writers = resolveWriters(snapshot, shardNames);
         if (writers.isEmpty()) {
-            writers = getAllWritersStream().toList();
+            writers = snapshot.writers();
+        }
+        if (options.maxSegments() > 0 && writers.size() > options.maxSegments()) {
+            writers = List.copyOf(writers.subList(0, options.maxSegments()));
+        }
+        return new Routing(writers, eps);
+    }
+
+    private static List<SegmentWriter> resolveWriters(CorpusSnapshot snapshot, List<String> shardNames) {
+        Map<String, SegmentWriter> byName = new HashMap<>();
+        snapshot.writers().forEach(w -> byName.putIfAbsent(w.getSegmentName(), w));
+        List<SegmentWriter> writers = new ArrayList<>(shardNames.size());
+        for (String name : new LinkedHashSet<>(shardNames)) {
+            SegmentWriter w = byName.get(name);
+            if (w != null) {
+                writers.add(w);
+            }
         }
         return writers;
     }
 
+    /** Writers not in {@code scanned}, limited so that at most {@code maxSegments} are scanned in total. */
+    private static List<SegmentWriter> remainingWriters(CorpusSnapshot snapshot,
+                                                        List<SegmentWriter> scanned,
+                                                        int maxSegments) {
+        Set<String> seen = new HashSet<>();
+        for (SegmentWriter writer : scanned) {
+            seen.add(writer.getSegmentName());
+        }
+        Stream<SegmentWriter> rest = snapshot.writers().stream().filter(w -> seen.add(w.getSegmentName()));
+        if (maxSegments > 0) {
+            rest = rest.limit(Math.max(0, maxSegments - scanned.size()));
+        }
+        return rest.toList();
+    }
+
     private SegmentWriter getOrCreateWriter(String segmentName) {
         String groupKey = base(segmentName);
 
@@ -930,15 +2789,197 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
         return writer;
     }
 
-    private PhaseShardSelector createShardSelector() {
-        List<ManifestIndex.PatternLocation> locations = manifest.getAllLocations();
-        return locations.isEmpty()
-                ? PhaseShardSelector.emptyFallback()
-                : PhaseShardSelector.fromManifest(locations, READ_EPSILON);
+    private SegmentPhaseHistogram histogramFor(String segmentName) {
+        return phaseHistograms.computeIfAbsent(segmentName, k -> new SegmentPhaseHistogram());
     }
 
-    private void rebuildShardSelector() {
-        shardSelectorRef.set(createShardSelector());
+    /**
+     * Rebuilds all segment histograms from the manifest; energy ranges are taken from
+     * the segment summaries where available.
+     */
+    private void rebuildPhaseHistograms() {
+        Map<String, SegmentPhaseHistogram> fresh = new HashMap<>();
+        for (ManifestIndex.PatternLocation loc : manifest.getAllLocations()) {
+            fresh.computeIfAbsent(loc.segmentName(), k -> new SegmentPhaseHistogram())
+                    .add(loc.phaseCenter(), Double.NaN);
+        }
+
+        for (Map.Entry<String, SegmentPhaseHistogram> e : fresh.entrySet()) {
+            CachedReader reader = readerCache.get(e.getKey());
+            SegmentSummary summary = reader != null ? reader.summary() : null;
+            if (summary == null || summary.count() == 0) {
+                continue;
+            }
+            double min = Double.POSITIVE_INFINITY;
+            double max = Double.NEGATIVE_INFINITY;
+            for (int i = 0; i < summary.count(); i++) {
+                double energy = summary.energy(i);
+                min = Math.min(min, energy);
+                max = Math.max(max, energy);
+            }
+            e.getValue().setEnergyRange(min, max);
+        }
+
+        phaseHistograms.clear();
+        phaseHistograms.putAll(fresh);
+    }
+
+    private static double energyOf(WavePattern pattern) {
+        double e = 0.0;
+        for (double a : pattern.amplitude()) {
+            e += a * a;
+        }
+        return e;
+    }
+
+    /**
+     * Publishes a snapshot in which every segment is re-read, after a change to the segment layout or to
+     * all histograms. Queries that pinned the previous snapshot keep reading it until they close it.
+     */
+    private void publishSnapshot() {
+        publishSnapshot(false);
+    }
+
+    /**
+     * @param first whether this is warm-up's first publication; until it happens, mutations leave
+     *              publishing to warm-up, whose snapshot already covers them
+     */
+    private void publishSnapshot(boolean first) {
+        synchronized (snapshotLock) {
+            if (!first && snapshotRef.get() == null) {
+                return;
+            }
+            publishLocked(true);
+        }
+    }
+
+    /**
+     * Publishes a write to {@code segments}; every other segment keeps the reader and histogram it was
+     * last published with. The written segments' readers are brought up to date before publication is
+     * serialised, so writers of different phase groups do that in parallel, and an append costs a walk
+     * over the appended records ({@link CachedReader#extend}) rather than a reopen.
+     */
+    private void publishChanges(String... segments) {
+        if (snapshotRef.get() == null) {
+            return;
+        }
+        for (String segment : segments) {
+            readerCache.get(segment);
+            unpublished.add(segment);
+        }
+        synchronized (snapshotLock) {
+            if (snapshotRef.get() != null) {
+                publishLocked(false);
+            }
+        }
+    }
+
+    /** Builds and swaps in the next snapshot; caller holds {@link #snapshotLock}. */
+    private void publishLocked(boolean all) {
+        Set<String> changed = new HashSet<>();
+        for (Iterator<String> it = unpublished.iterator(); it.hasNext(); ) {
+            changed.add(it.next());
+            it.remove();
+        }
+        CorpusSnapshot prev = snapshotRef.get();
+        if (!all && changed.isEmpty()) {
+            return; // a concurrent publication already covered these changes
+        }
+
+        List<SegmentWriter> writers = getAllWritersStream().toList();
+        Map<String, CachedReader> readers = new HashMap<>();
+        Map<String, SegmentPhaseHistogram> histograms = new HashMap<>();
+        for (SegmentWriter writer : writers) {
+            String name = writer.getSegmentName();
+            CachedReader reader;
+            SegmentPhaseHistogram histogram;
+            if (all || prev == null || changed.contains(name)) {
+                reader = pinReader(name);
+                SegmentPhaseHistogram live = phaseHistograms.get(name);
+                histogram = live != null ? live.copy() : null;
+            } else {
+                reader = prev.reader(name);
+                if (reader != null) {
+                    reader.retain();
+                }
+                histogram = prev.histogram(name);
+            }
+            if (reader != null) {
+                readers.put(name, reader);
+            }
+            if (histogram != null) {
+                histograms.put(name, histogram);
+            }
+        }
+
+        PhaseShardSelector selector = PhaseShardSelector.fromFrozenHistograms(
+                histograms, QueryOptions.defaultOptions().phaseEpsilon());
+        CorpusSnapshot next = new CorpusSnapshot(
+                corpusVersion.incrementAndGet(), writers, readers, histograms, selector);
+        snapshotRef.set(next);
+        if (prev != null) {
+            prev.close();
+        }
+    }
+
+    /**
+     * Waits for a slot in the shared admission controller. The scan estimate is every committed byte
+     * of the current corpus, an upper bound for what routing may select.
+     */
+    private QueryAdmissionController.Permit admit(QueryOptions.Priority priority, long deadline) {
+        return admit(priority, snapshotRef.get(), deadline);
+    }
+
+    /** Admits a query that already pinned {@code snapshot}, charging the bytes of that snapshot. */
+    private QueryAdmissionController.Permit admit(QueryOptions.Priority priority, CorpusSnapshot snapshot,
+                                                  long deadline) {
+        return runtime.admission().admit(corpusKey, priority, scanEstimate(snapshot), deadline);
+    }
+
+    /** The {@link System#nanoTime()} deadline of a query starting now, or {@code 0} if it has no timeout. */
+    private static long deadlineOf(QueryOptions options) {
+        return options.timeoutMillis() > 0
+                ? System.nanoTime() + TimeUnit.MILLISECONDS.toNanos(options.timeoutMillis())
+                : 0L;
+    }
+
+    private static long scanEstimate(CorpusSnapshot current) {
+        long bytes = 0L;
+        if (current != null) {
+            for (SegmentWriter writer : current.writers()) {
+                bytes += writer.getWriteOffset();
+            }
+        }
+        return bytes;
+    }
+
+    /** Acquires the current reader of a segment, retrying if the cache evicts it in between. */
+    private CachedReader pinReader(String segmentName) {
+        for (int attempt = 0; attempt < 3; attempt++) {
+            CachedReader reader = readerCache.get(segmentName);
+            if (reader == null) {
+                return null;
+            }
+            try {
+                reader.acquire();
+                return reader;
+            } catch (IllegalStateException evicted) {
+                // closed by the cache after lookup; the next get reopens it
+            }
+        }
+        return null;
+    }
+
+    /** Pins the current snapshot for a query; the caller closes it when done. */
+    private CorpusSnapshot pinSnapshot() {
+        while (true) {
+            ensureOpen();
+            CorpusSnapshot snapshot = snapshotRef.get();
+            if (snapshot.retain()) {
+                return snapshot;
+            }
+            Thread.onSpinWait();
+        }
     }
 
     private String base(String segmentName) {
@@ -952,6 +2993,20 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
         return raw;
     }
 
+    /** Group whose writer list holds {@code segmentName}; falls back to the group named by the segment. */
+    private PhaseSegmentGroup groupOwning(String segmentName) {
+        PhaseSegmentGroup named = segmentGroups.get(base(segmentName));
+        if (named != null && named.containsSegment(segmentName)) {
+            return named;
+        }
+        for (PhaseSegmentGroup group : segmentGroups.values()) {
+            if (group.containsSegment(segmentName)) {
+                return group;
+            }
+        }
+        return getOrCreateGroup(base(segmentName));
+    }
+
     private PhaseSegmentGroup getOrCreateGroup(String baseName) {
         return segmentGroups.computeIfAbsent(
                 baseName,
@@ -982,43 +3037,18 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
                 .distinct();
     }
 
-    private int computePhaseBucket(WavePattern psi) {
-        double phaseCenter = Arrays.stream(psi.phase()).average().orElse(0.0);
-        return normBucketIndex((int) Math.floor((phaseCenter + Math.PI) / BUCKET_WIDTH_RAD));
-    }
-
-    private int normBucketIndex(int idx) {
-        int maxIdx = maxBucketIndex();
-        if (idx < 0) {
-            return 0;
-        }
-        if (idx > maxIdx) {
-            return maxIdx;
-        }
-        return idx;
-    }
-
-    private int maxBucketIndex() {
-        return (int) Math.ceil((2 * Math.PI) / BUCKET_WIDTH_RAD) - 1;
-    }
-
     private SegmentWriteResult writeToSegment(String id, WavePattern psi, PhaseSegmentGroup group) {
-        SegmentWriter writer = group.getWritable();
-        if (writer == null || writer.willOverflow(psi)) {
-            writer = group.createAndRegisterNewSegment();
-        }
-        group.registerIfAbsent(writer);
-
         while (true) {
+            SegmentWriter writer = group.writableFor(psi);
             try {
                 long offset = writer.write(id, psi);
                 long version = writer.flush();
                 writer.sync();
-                registerSegment(writer);
+                manifest.registerSegmentIfAbsent(writer.getSegmentName());
+                readerCache.advanceVersion(writer.getSegmentName(), version);
                 return new SegmentWriteResult(writer, offset, version);
             } catch (SegmentOverflowException ignored) {
-                writer = group.createAndRegisterNewSegment();
-                group.registerIfAbsent(writer);
+                // another appender filled the segment after selection; writableFor rolls over
             }
         }
     }
@@ -1038,12 +3068,19 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
                 .toList();
     }
 
-    private void acquireIoPermitBatch() {
+    /** Takes an I/O permit only when the reader's pages are not already in the page cache. */
+    private boolean acquireIoPermit(CachedReader reader) {
+        if (reader.isResident()) {
+            return false;
+        }
         runtime.ioGovernor().acquire();
+        return true;
     }
 
-    private void releaseIoPermitBatch() {
-        runtime.ioGovernor().release();
+    private void releaseIoPermit(boolean acquired) {
+        if (acquired) {
+            runtime.ioGovernor().release();
+        }
     }
 
     private WavePattern readNoSemaphore(CachedReader reader, String id) {
@@ -1054,7 +3091,59 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
         }
     }
 
-    private List<ResonanceMatch> materializePatterns(List<ResonanceMatch> matches) {
+    /**
+     * Reads {@code id} from the snapshot: from the segment the manifest names, or, if the record has since
+     * been moved by a compaction or rebalance, from whichever pinned segment still holds it.
+     */
+    private WavePattern readPattern(CorpusSnapshot snapshot, String id) {
+        ManifestIndex.PatternLocation loc = manifest.get(id);
+        CachedReader reader = loc != null ? snapshot.reader(loc.segmentName()) : null;
+        WavePattern pattern = reader != null ? readNoSemaphore(reader, id) : null;
+        if (pattern != null) {
+            return pattern;
+        }
+        for (CachedReader candidate : snapshot.readers()) {
+            if (candidate.contains(id) && (pattern = readNoSemaphore(candidate, id)) != null) {
+                return pattern;
+            }
+        }
+        return null;
+    }
+
+    private List<ResonanceMatch> project(CorpusSnapshot snapshot,
+                                         List<ResonanceMatch> matches,
+                                         QueryOptions.Projection projection) {
+        if (projection == QueryOptions.Projection.FULL) {
+            return materializePatterns(snapshot, matches);
+        }
+        boolean withMetadata = projection == QueryOptions.Projection.IDS_SCORES_METADATA;
+        List<ResonanceMatch> out = new ArrayList<>(matches.size());
+        for (ResonanceMatch m : matches) {
+            out.add(new ResonanceMatch(m.id(), m.energy(), null, withMetadata ? metadataOf(m.id()) : null));
+        }
+        return out;
+    }
+
+    private List<ResonanceMatchDetailed> projectDetailed(List<ResonanceMatchDetailed> matches,
+                                                         QueryOptions.Projection projection) {
+        if (projection == QueryOptions.Projection.FULL) {
+            return matches;
+        }
+        boolean withMetadata = projection == QueryOptions.Projection.IDS_SCORES_METADATA;
+        List<ResonanceMatchDetailed> out = new ArrayList<>(matches.size());
+        for (ResonanceMatchDetailed m : matches) {
+            out.add(new ResonanceMatchDetailed(m.id(), m.energy(), null, m.phaseDelta(), m.zone(), m.zoneScore(),
+                    withMetadata ? metadataOf(m.id()) : null));
+        }
+        return out;
+    }
+
+    private Map<String, String> metadataOf(String id) {
+        Map<String, String> metadata = metaStore.getMetadata(id);
+        return metadata != null ? metadata : Map.of();
+    }
+
+    private List<ResonanceMatch> materializePatterns(CorpusSnapshot snapshot, List<ResonanceMatch> matches) {
         boolean needMaterialization = false;
         for (ResonanceMatch match : matches) {
             if (match.pattern() == null) {
@@ -1074,16 +3163,7 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
             }
 
             String id = match.id();
-            WavePattern pattern = null;
-            ManifestIndex.PatternLocation loc = manifest.get(id);
-            if (loc != null) {
-                CachedReader reader = readerCache.get(loc.segmentName());
-                if (reader != null) {
-                    pattern = readNoSemaphore(reader, id);
-                }
-            }
-
-            out.add(new ResonanceMatch(id, match.energy(), pattern));
+            out.add(new ResonanceMatch(id, match.energy(), readPattern(snapshot, id)));
         }
         return out;
     }
@@ -1116,42 +3196,23 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
         }
     }
 
+    /** Checks the first record of every segment; reads one length field per file instead of opening readers. */
     private void verifyPatternLengthOnOpen() {
-        Set<String> segments = manifest.getAllSegmentNames();
-        if (segments.isEmpty()) {
-            return;
-        }
-
-        for (String seg : segments) {
-            CachedReader reader = readerCache.get(seg);
-            if (reader == null) {
-                continue;
-            }
-
-            OptionalInt sample = samplePatternLength(reader);
+        getAllWritersStream().forEach(writer -> {
+            OptionalInt sample = writer.firstRecordLength();
             if (sample.isEmpty()) {
-                continue;
+                return;
             }
 
             int len = sample.getAsInt();
             if (len != patternLen) {
                 throw new InvalidWavePatternException(
                         "DB pattern length mismatch on open: expected=" + patternLen +
-                                ", got=" + len + " in segment=" + seg +
+                                ", got=" + len + " in segment=" + writer.getSegmentName() +
                                 ". Set -Dresonance.pattern.len=" + len + " to open this DB, or rebuild the DB."
                 );
             }
-        }
-    }
-
-    private OptionalInt samplePatternLength(CachedReader reader) {
-        try {
-            return reader.lazyStream()
-                    .mapToInt(p -> p.pattern().amplitude().length)
-                    .findFirst();
-        } catch (RuntimeException e) {
-            return OptionalInt.empty();
-        }
+        });
     }
 
     private void safeClose(SegmentWriter writer) {
@@ -1162,6 +3223,54 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
         }
     }
 
+    /** Scans candidates {@code [from, to)} of one segment; must be safe to call from several workers at once. */
+    @FunctionalInterface
+    private interface MorselScan<T> {
+        List<T> scan(int from, int to);
+    }
+
+    /**
+     * Runs {@code scan} over {@code count} candidates, split into {@link #MORSEL_RECORDS}-sized morsels that
+     * idle pool workers steal, so one large segment is not bound to a single core. Each morsel keeps its own
+     * local top-K; the lists are concatenated and merged by the caller like per-segment results.
+     */
+    private static <T> List<T> scanMorsels(int count, MorselScan<T> scan) {
+        if (count <= MORSEL_RECORDS || !ForkJoinTask.inForkJoinPool()) {
+            return scan.scan(0, count);
+        }
+        return new MorselTask<>(scan, 0, count).invoke();
+    }
+
+    private static final class MorselTask<T> extends RecursiveTask<List<T>> {
+        private final MorselScan<T> scan;
+        private final int from;
+        private final int to;
+
+        private MorselTask(MorselScan<T> scan, int from, int to) {
+            this.scan = scan;
+            this.from = from;
+            this.to = to;
+        }
+
+        @Override
+        protected List<T> compute() {
+            int morsels = (to - from + MORSEL_RECORDS - 1) / MORSEL_RECORDS;
+            if (morsels <= 1) {
+                return scan.scan(from, to);
+            }
+            int mid = from + (morsels / 2) * MORSEL_RECORDS;
+            MorselTask<T> left = new MorselTask<>(scan, from, mid);
+            left.fork();
+            List<T> rightResult = new MorselTask<>(scan, mid, to).compute();
+            List<T> leftResult = left.join();
+
+            List<T> merged = new ArrayList<>(leftResult.size() + rightResult.size());
+            merged.addAll(leftResult);
+            merged.addAll(rightResult);
+            return merged;
+        }
+    }
+
     private abstract static class QueryTask<T> extends RecursiveTask<List<T>> {
         final List<SegmentWriter> writers;
         private final int from;
@@ -1172,17 +3281,22 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
             this.writers = writers;
             this.from = from;
             this.to = to;
-            this.threshold = Math.max(2, threshold);
+            this.threshold = Math.max(1, threshold);
         }
 
         protected abstract List<T> process(SegmentWriter writer);
 
+        /** Polled between segments and before forking; subtasks stop early once it returns true. */
+        protected boolean cancelled() {
+            return false;
+        }
+
         @Override
         protected List<T> compute() {
             int span = to - from;
-            if (span <= threshold) {
+            if (span <= threshold || cancelled()) {
                 List<T> results = new ArrayList<>(Math.max(span * 2, 4));
-                for (int i = from; i < to; i++) {
+                for (int i = from; i < to && !cancelled(); i++) {
                     results.addAll(process(writers.get(i)));
                 }
                 return results;
@@ -1206,60 +3320,180 @@ public class WavePatternStoreImpl implements ResonanceStore, Closeable {
     }
 
     private final class MatchQueryTask extends QueryTask<HeapItem> {
-        private final WavePattern query;
-        private final String queryId;
+        private final QueryProfile profile;
         private final int topK;
 
         private MatchQueryTask(List<SegmentWriter> writers,
-                               WavePattern query,
-                               String queryId,
+                               QueryProfile profile,
                                int topK,
                                int from,
                                int to,
                                int threshold) {
             super(writers, from, to, threshold);
-            this.query = query;
-            this.queryId = queryId;
+            this.profile = profile;
             this.topK = topK;
         }
 
         @Override
         protected List<HeapItem> process(SegmentWriter writer) {
-            return collectMatchesFromWriter(writer, query, queryId, topK);
+            return collectMatchesFromWriter(writer, profile, topK);
+        }
+
+        @Override
+        protected boolean cancelled() {
+            return profile.expired();
         }
 
         @Override
         protected QueryTask<HeapItem> cloneFor(int from, int to, int threshold) {
-            return new MatchQueryTask(this.writers, query, queryId, topK, from, to, threshold);
+            return new MatchQueryTask(this.writers, profile, topK, from, to, threshold);
+        }
+    }
+
+    /** Segments of several stores split like a {@link QueryTask}; all shards share one top-K floor. */
+    private static final class FederatedMatchTask extends RecursiveTask<List<ShardHit>> {
+        private final List<Shard> shards;
+        private final int topK;
+        private final int from;
+        private final int to;
+
+        private FederatedMatchTask(List<Shard> shards, int topK, int from, int to) {
+            this.shards = shards;
+            this.topK = topK;
+            this.from = from;
+            this.to = to;
+        }
+
+        @Override
+        protected List<ShardHit> compute() {
+            int span = to - from;
+            if (span <= SEGMENTS_PER_TASK) {
+                List<ShardHit> results = new ArrayList<>(Math.max(span * 2, 4));
+                for (int i = from; i < to; i++) {
+                    Shard shard = shards.get(i);
+                    if (shard.profile().expired()) {
+                        break;
+                    }
+                    for (HeapItem item : shard.store().collectMatchesFromWriter(shard.writer(), shard.profile(), topK)) {
+                        results.add(new ShardHit(shard.member(), item));
+                    }
+                }
+                return results;
+            }
+            int mid = (from + to) >>> 1;
+            FederatedMatchTask left = new FederatedMatchTask(shards, topK, from, mid);
+            left.fork();
+            List<ShardHit> rightResult = new FederatedMatchTask(shards, topK, mid, to).compute();
+            List<ShardHit> leftResult = left.join();
+            leftResult.addAll(rightResult);
+            return leftResult;
+        }
+    }
+
+    private final class BatchQueryTask extends QueryTask<BatchHit> {
+        private final Map<String, int[]> targets;
+        private final QueryProfile[] profiles;
+        private final int topK;
+
+        private BatchQueryTask(List<SegmentWriter> writers,
+                               Map<String, int[]> targets,
+                               QueryProfile[] profiles,
+                               int topK,
+                               int from,
+                               int to,
+                               int threshold) {
+            super(writers, from, to, threshold);
+            this.targets = targets;
+            this.profiles = profiles;
+            this.topK = topK;
+        }
+
+        @Override
+        protected List<BatchHit> process(SegmentWriter writer) {
+            return writer == null
+                    ? List.of()
+                    : collectBatchFromWriter(writer, targets.get(writer.getSegmentName()), profiles, topK);
+        }
+
+        @Override
+        protected boolean cancelled() {
+            for (QueryProfile profile : profiles) {
+                if (!profile.expired()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        @Override
+        protected QueryTask<BatchHit> cloneFor(int from, int to, int threshold) {
+            return new BatchQueryTask(this.writers, targets, profiles, topK, from, to, threshold);
+        }
+    }
+
+    private final class ThresholdQueryTask extends QueryTask<ResonanceMatch> {
+        private final QueryProfile profile;
+        private final float minEnergy;
+        private final Consumer<List<ResonanceMatch>> emit;
+
+        private ThresholdQueryTask(List<SegmentWriter> writers,
+                                   QueryProfile profile,
+                                   float minEnergy,
+                                   Consumer<List<ResonanceMatch>> emit,
+                                   int from,
+                                   int to,
+                                   int threshold) {
+            super(writers, from, to, threshold);
+            this.profile = profile;
+            this.minEnergy = minEnergy;
+            this.emit = emit;
+        }
+
+        @Override
+        protected List<ResonanceMatch> process(SegmentWriter writer) {
+            collectThresholdFromWriter(writer, profile, minEnergy, emit);
+            return List.of();
+        }
+
+        @Override
+        protected boolean cancelled() {
+            return profile.stopped();
+        }
+
+        @Override
+        protected QueryTask<ResonanceMatch> cloneFor(int from, int to, int threshold) {
+            return new ThresholdQueryTask(this.writers, profile, minEnergy, emit, from, to, threshold);
         }
     }
 
     private final class DetailedMatchQueryTask extends QueryTask<HeapItemDetailed> {
-        private final WavePattern query;
-        private final String queryId;
+        private final QueryProfile profile;
         private final int topK;
 
         private DetailedMatchQueryTask(List<SegmentWriter> writers,
-                                       WavePattern query,
-                                       String queryId,
+                                       QueryProfile profile,
                                        int topK,
                                        int from,
                                        int to,
                                        int threshold) {
             super(writers, from, to, threshold);
-            this.query = query;
-            this.queryId = queryId;
+            this.profile = profile;
             this.topK = topK;
         }
 
         @Override
         protected List<HeapItemDetailed> process(SegmentWriter writer) {
-            return collectDetailedFromWriter(writer, query, queryId, topK);
+            return collectDetailedFromWriter(writer, profile, topK);
+        }
+
+        @Override
+        protected boolean cancelled() {
+            return profile.expired();
         }
 
         @Override
         protected QueryTask<HeapItemDetailed> cloneFor(int from, int to, int threshold) {
-            return new DetailedMatchQueryTask(this.writers, query, queryId, topK, from, to, threshold);
+            return new DetailedMatchQueryTask(this.writers, profile, topK, from, to, threshold);
         }
     }
 }
\ No newline at end of file
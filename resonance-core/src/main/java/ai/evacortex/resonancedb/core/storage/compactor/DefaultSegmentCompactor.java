@@ -13,6 +13,8 @@ import ai.evacortex.resonancedb.core.storage.ManifestIndex;
 import ai.evacortex.resonancedb.core.storage.PhaseSegmentGroup;
 import ai.evacortex.resonancedb.core.storage.io.SegmentReader;
 import ai.evacortex.resonancedb.core.storage.io.SegmentWriter;
+import ai.evacortex.resonancedb.core.storage.io.SegmentIdIndex;
+import ai.evacortex.resonancedb.core.storage.io.SummarySidecar;
 
 import java.io.IOException;
 import java.nio.file.Files;
@@ -79,6 +81,12 @@ public class DefaultSegmentCompactor implements SegmentCompactor {
             tmpWriter.flush();
             tmpWriter.close();
             safeMoveWithRetry(tmpPath, finalPath);
+            if (Files.exists(SummarySidecar.pathFor(tmpPath))) {
+                safeMoveWithRetry(SummarySidecar.pathFor(tmpPath), SummarySidecar.pathFor(finalPath));
+            }
+            if (Files.exists(SegmentIdIndex.pathFor(tmpPath))) {
+                safeMoveWithRetry(SegmentIdIndex.pathFor(tmpPath), SegmentIdIndex.pathFor(finalPath));
+            }
             SegmentWriter mergedWriter = new SegmentWriter(finalPath);
             mergedWriter.sync();
             group.registerIfAbsent(mergedWriter);
@@ -90,6 +98,8 @@ public class DefaultSegmentCompactor implements SegmentCompactor {
                 try {
                     w.close();
                     Files.deleteIfExists(w.getPath());
+                    Files.deleteIfExists(SummarySidecar.pathFor(w.getPath()));
+                    Files.deleteIfExists(SegmentIdIndex.pathFor(w.getPath()));
                 } catch (Exception ignore) {}
             }
 
@@ -24,6 +24,7 @@ import java.nio.file.Path;
 import java.nio.file.StandardOpenOption;
 import java.util.*;
 import java.util.concurrent.atomic.AtomicInteger;
+import java.util.stream.IntStream;
 import java.util.stream.Stream;
 
 public class CachedReader implements AutoCloseable {
@@ -31,92 +32,286 @@ public class CachedReader implements AutoCloseable {
     private static final int ID_SIZE = 16;
     private static final int HEADER_SIZE = 1 + 16 + 4 + 4;
     private static final int ALIGNMENT = 8;
+    private static final long RESIDENCY_TTL_NANOS =
+            Math.max(0L, Long.getLong("resonance.io.residency.ttlMillis", 1000L)) * 1_000_000L;
+    private static final double RESIDENT_THRESHOLD =
+            Double.parseDouble(System.getProperty("resonance.io.residency.threshold", "0.9"));
 
     private final Path path;
-    private final FileChannel channel;
+    private final Mapping mapping;
     private final MappedByteBuffer mmap;
-    private final Map<String, Long> offsetMap;
+    private final int checksumLength;
+    private final SegmentIdIndex index;
+    private final SegmentSummary summary;
     private final long lastOffset;
     private final long weightInBytes;
     private volatile boolean closed = false;
+    /** Whether this version gave up its summary and its share of the mapping; guarded by unmapLock. */
+    private boolean unmapped;
+    private volatile double residency = -1.0;
+    private volatile long residencySampledAt;
+    private volatile long prefetchedAt;
 
     private final AtomicInteger refCount = new AtomicInteger(0);
     private final Object unmapLock = new Object();
 
-    private CachedReader(Path path, FileChannel channel, MappedByteBuffer mmap,
-                         Map<String, Long> offsetMap, long lastOffset, long weightInBytes) {
+    /**
+     * The segment mapping and the id index it was opened with, shared by the readers {@link #extend}
+     * builds from one another and released with the last of them.
+     */
+    private static final class Mapping {
+        private final MappedByteBuffer mmap;
+        private final SegmentIdIndex base;
+        private final AtomicInteger owners = new AtomicInteger(1);
+
+        Mapping(MappedByteBuffer mmap, SegmentIdIndex base) {
+            this.mmap = mmap;
+            this.base = base;
+        }
+
+        boolean retain() {
+            int cur;
+            do {
+                cur = owners.get();
+                if (cur <= 0) {
+                    return false;
+                }
+            } while (!owners.compareAndSet(cur, cur + 1));
+            return true;
+        }
+
+        void release() {
+            if (owners.decrementAndGet() == 0) {
+                Buffers.unmap(mmap);
+                base.unmap();
+            }
+        }
+    }
+
+    private CachedReader(Path path, Mapping mapping, int checksumLength,
+                         SegmentIdIndex index, SegmentSummary summary, long lastOffset, long weightInBytes) {
         this.path = path;
-        this.channel = channel;
-        this.mmap = mmap;
-        this.offsetMap = offsetMap;
+        this.mapping = mapping;
+        this.mmap = mapping.mmap;
+        this.checksumLength = checksumLength;
+        this.index = index;
+        this.summary = summary;
         this.lastOffset = lastOffset;
         this.weightInBytes = weightInBytes;
     }
 
     public static CachedReader open(Path segmentPath) throws IOException {
-        FileChannel channel = FileChannel.open(segmentPath, StandardOpenOption.READ);
-        long fileSize = channel.size();
-
-        MappedByteBuffer mmap = (MappedByteBuffer) channel
-                .map(FileChannel.MapMode.READ_ONLY, 0, fileSize)
-                .order(ByteOrder.LITTLE_ENDIAN);
+        long fileSize;
+        MappedByteBuffer mmap;
+        try (FileChannel channel = FileChannel.open(segmentPath, StandardOpenOption.READ)) {
+            fileSize = channel.size();
+            mmap = (MappedByteBuffer) channel
+                    .map(FileChannel.MapMode.READ_ONLY, 0, fileSize)
+                    .order(ByteOrder.LITTLE_ENDIAN);
+        }
 
         int checksumLen = SegmentReader.inferChecksumLength(segmentPath);
         int hdrSize = BinaryHeader.sizeFor(checksumLen);
 
-        ByteBuffer hdrBuf = mmap.duplicate().order(ByteOrder.LITTLE_ENDIAN);
-        BinaryHeader header = BinaryHeader.from(hdrBuf, checksumLen);
+        BinaryHeader header;
+        try {
+            header = readHeader(mmap, checksumLen, segmentPath);
+        } catch (RuntimeException e) {
+            Buffers.unmap(mmap);
+            throw e;
+        }
+
+        long lastOffset = header.lastOffset();
+        SegmentIdIndex index = SegmentIdIndex.load(segmentPath, lastOffset, header.checksum());
+        if (index == null) {
+            index = SegmentIdIndex.scan(mmap, hdrSize, lastOffset);
+        }
+
+        SegmentSummary summary = SummarySidecar.load(segmentPath, index);
+
+        return new CachedReader(segmentPath, new Mapping(mmap, index), checksumLen, index, summary,
+                lastOffset, fileSize);
+    }
 
+    /**
+     * Reader of the same segment at its current committed end, built from this one in time proportional
+     * to what was appended since: it shares this reader's mapping and id index, walks only the new
+     * records and checks only their summary entries. Works on a closed reader while a pinned version
+     * still holds the mapping.
+     *
+     * @param minLastOffset committed end the caller expects at least
+     * @return {@code null} if the mapping was released, the segment outgrew it or did not reach
+     *         {@code minLastOffset}, or another version was already extended from this one;
+     *         {@link #open} the segment instead
+     */
+    public CachedReader extend(long minLastOffset) {
+        if (!mapping.retain()) {
+            return null;
+        }
+        boolean handedOver = false;
+        try {
+            BinaryHeader header = readHeader(mmap, checksumLength, path);
+            long end = header.lastOffset();
+            if (end < minLastOffset || end < lastOffset || end > mmap.capacity()) {
+                return null;
+            }
+            SegmentIdIndex next = index.extend(mmap, lastOffset, end);
+            if (next == null) {
+                return null;
+            }
+            SegmentSummary nextSummary = SummarySidecar.extend(path, summary, next);
+            handedOver = true;
+            return new CachedReader(path, mapping, checksumLength, next, nextSummary, end, weightInBytes);
+        } catch (RuntimeException e) {
+            return null;
+        } finally {
+            if (!handedOver) {
+                mapping.release();
+            }
+        }
+    }
+
+    private static BinaryHeader readHeader(MappedByteBuffer mmap, int checksumLen, Path segmentPath) {
+        BinaryHeader header = BinaryHeader.from(mmap.duplicate().order(ByteOrder.LITTLE_ENDIAN), checksumLen);
         if (header.commitFlag() != 0 && header.commitFlag() != 1) {
             throw new IncompleteWriteException("Segment " + segmentPath.getFileName() +
                     " has unknown commit flag: " + header.commitFlag());
-            }
+        }
+        return header;
+    }
 
-        long lastOffset = header.lastOffset();
-        Map<String, Long> offsetMap = new LinkedHashMap<>();
-
-        int pos = hdrSize;
-        while (pos + HEADER_SIZE <= lastOffset) {
-            ByteBuffer buf = mmap.duplicate().order(ByteOrder.LITTLE_ENDIAN);
-            buf.position(pos);
-
-            byte deleted = buf.get();
-            byte[] idBytes = new byte[ID_SIZE];
-            buf.get(idBytes);
-            int len = buf.getInt();
-            buf.getInt();
-            if (len <= 0 || len > WavePatternCodec.MAX_SUPPORTED_LENGTH) {
-                break;
-            }
+    public Set<String> allIds() {
+        ensureOpen();
+        int live = liveCount();
+        Set<String> ids = new LinkedHashSet<>(live * 2);
+        for (int i = 0; i < live; i++) {
+            ids.add(idAt(i));
+        }
+        return ids;
+    }
+
+    public int liveCount() {
+        return index.liveCount();
+    }
 
-            int patternSize = WavePatternCodec.estimateSize(len, false);
-            int totalSize   = align(HEADER_SIZE + patternSize);
+    /** Id of the live record at {@code index}, decoded from the segment on each call. */
+    public String idAt(int index) {
+        byte[] bytes = new byte[ID_SIZE];
+        mmap.get((int) this.index.liveOffset(index) + 1, bytes);
+        return bytesToHex(bytes);
+    }
 
-            if (deleted == 0x01) {
-                String id = bytesToHex(idBytes);
-                offsetMap.put(id, (long) pos);
+    /** True if the live record at {@code index} has {@code id}; compares the stored bytes without decoding them. */
+    public boolean idEquals(int index, String id) {
+        if (id == null || id.length() != 2 * ID_SIZE) {
+            return false;
+        }
+        int p = (int) this.index.liveOffset(index) + 1;
+        for (int b = 0; b < ID_SIZE; b++) {
+            int v = mmap.get(p + b) & 0xFF;
+            if (Character.digit(id.charAt(2 * b), 16) != v >>> 4
+                    || Character.digit(id.charAt(2 * b + 1), 16) != (v & 0x0F)) {
+                return false;
             }
-            pos += totalSize;
         }
+        return true;
+    }
 
-        return new CachedReader(segmentPath, channel, mmap, offsetMap, lastOffset, fileSize);
+    /** Estimated heap held by the id index. */
+    public long heapBytes() {
+        return index.heapBytes();
     }
 
-    public Set<String> allIds() {
+    /** Record bytes of this segment currently held in the page cache. */
+    public long residentBytes() {
+        return (long) (residency() * lastOffset);
+    }
+
+    public long offsetAt(int index) {
+        return this.index.liveOffset(index);
+    }
+
+    public SegmentSummary summary() {
+        return summary;
+    }
+
+    /**
+     * Reads only the amplitude block of the live record at {@code index} and writes
+     * {@code Σ w_k·|A_k|} to {@code out[0]} and {@code Σ A_k²} to {@code out[1]}.
+     *
+     * @return {@code false} if the record length does not match {@code weights}
+     */
+    public boolean amplitudeProducts(int index, double[] weights, double[] out) {
         ensureOpen();
-        return offsetMap.keySet();
+        long offset = this.index.liveOffset(index);
+        int len = mmap.getInt((int) offset + 1 + ID_SIZE);
+        if (len != weights.length || offset + HEADER_SIZE + 4 + 8L * len > lastOffset) {
+            return false;
+        }
+        int pos = (int) offset + HEADER_SIZE + 4;
+        double dot = 0.0;
+        double energy = 0.0;
+        for (int k = 0; k < len; k++, pos += 8) {
+            double a = mmap.getDouble(pos);
+            dot += weights[k] * Math.abs(a);
+            energy += a * a;
+        }
+        out[0] = dot;
+        out[1] = energy;
+        return true;
+    }
+
+    /**
+     * Fraction of this segment's record pages held in the page cache, sampled with {@code mincore}
+     * at most once per {@code resonance.io.residency.ttlMillis}.
+     */
+    public double residency() {
+        long now = System.nanoTime();
+        double cached = residency;
+        if (cached >= 0.0 && now - residencySampledAt < RESIDENCY_TTL_NANOS) {
+            return cached;
+        }
+        synchronized (unmapLock) {
+            if (closed && refCount.get() == 0) {
+                return 0.0;
+            }
+            cached = PageResidency.residentFraction(mmap, lastOffset);
+        }
+        residency = cached;
+        residencySampledAt = now;
+        return cached;
+    }
+
+    /** True when scanning this segment should not touch the disk. */
+    public boolean isResident() {
+        return residency() >= RESIDENT_THRESHOLD;
+    }
+
+    /** Starts an asynchronous kernel read-ahead of the record pages; repeated calls within the sampling interval are skipped. */
+    public void prefetch() {
+        long now = System.nanoTime();
+        if (prefetchedAt != 0L && now - prefetchedAt < RESIDENCY_TTL_NANOS) {
+            return;
+        }
+        prefetchedAt = now;
+        synchronized (unmapLock) {
+            if (!(closed && refCount.get() == 0)) {
+                PageResidency.willNeed(mmap, lastOffset);
+            }
+        }
+        residency = -1.0;
     }
 
     public boolean contains(String id) {
         ensureOpen();
-        return offsetMap.containsKey(id);
+        return index.find(mmap, id) >= 0;
     }
 
     public long offsetOf(String id) {
         ensureOpen();
-        Long off = offsetMap.get(id);
-        if (off == null) throw new PatternNotFoundException("ID not found: " + id);
-        return off;
+        long offset = index.find(mmap, id);
+        if (offset < 0) throw new PatternNotFoundException("ID not found: " + id);
+        return offset;
     }
 
     public SegmentReader.PatternWithId readAtOffset(long offset) {
@@ -135,9 +330,9 @@ public class CachedReader implements AutoCloseable {
 
     public Stream<SegmentReader.PatternWithId> lazyStream() {
         ensureOpen();
-        return offsetMap.entrySet().stream().map(entry -> {
+        return IntStream.range(0, liveCount()).mapToLong(index::liveOffset).mapToObj(offset -> {
             try {
-                return readAtOffset(entry.getValue());
+                return readAtOffset(offset);
             } catch (RuntimeException e) {
                 return null;
             }
@@ -184,6 +379,19 @@ public class CachedReader implements AutoCloseable {
         }
     }
 
+    /**
+     * Adds a reference for a caller that already holds one; unlike {@link #acquire()}, this works after
+     * the cache closed the reader.
+     */
+    public void retain() {
+        synchronized (unmapLock) {
+            if (refCount.get() <= 0) {
+                throw new IllegalStateException("CachedReader for " + path + " is not held");
+            }
+            refCount.incrementAndGet();
+        }
+    }
+
     public void release() {
         synchronized (unmapLock) {
             int remaining = refCount.decrementAndGet();
@@ -191,7 +399,7 @@ public class CachedReader implements AutoCloseable {
                 throw new IllegalStateException("CachedReader refCount below zero for " + path);
             }
             if (closed && remaining == 0) {
-                Buffers.unmap(mmap);
+                unmapAll();
             }
         }
     }
@@ -200,20 +408,27 @@ public class CachedReader implements AutoCloseable {
     public void close() {
         synchronized (unmapLock) {
             closed = true;
-            try {
-                channel.close();
-            } catch (IOException ignored) {}
-
             if (refCount.get() == 0) {
-                Buffers.unmap(mmap);
+                unmapAll();
             }
         }
     }
 
+    private void unmapAll() {
+        if (unmapped) {
+            return;
+        }
+        unmapped = true;
+        if (summary != null) {
+            summary.unmap();
+        }
+        mapping.release();
+    }
+
     public OptionalInt samplePatternLength() {
         if (closed) return OptionalInt.empty();
-        if (offsetMap.isEmpty()) return OptionalInt.empty();
-        long off = offsetMap.values().iterator().next();
+        if (liveCount() == 0) return OptionalInt.empty();
+        long off = index.liveOffset(0);
         int pos = (int) (off + 1 + 16);
         if (pos < 0 || pos + 4 > mmap.capacity()) return OptionalInt.empty();
         int len = mmap.getInt(pos);
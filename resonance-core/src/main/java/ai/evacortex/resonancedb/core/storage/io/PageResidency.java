@@ -0,0 +1,103 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.storage.io;
+
+import java.lang.foreign.*;
+import java.lang.invoke.MethodHandle;
+import java.nio.MappedByteBuffer;
+
+import static java.lang.foreign.ValueLayout.*;
+
+/**
+ * Page-cache residency of mapped segments, read with {@code mincore(2)} and prefetched with
+ * {@code madvise(MADV_WILLNEED)} through the FFM linker. Where libc does not export these calls the
+ * residency falls back to {@link MappedByteBuffer#isLoaded()} and prefetching is a no-op.
+ */
+final class PageResidency {
+
+    private static final int MADV_WILLNEED = 3;
+
+    private static final MethodHandle MINCORE;
+    private static final MethodHandle MADVISE;
+    private static final long PAGE_SIZE;
+
+    static {
+        MethodHandle mincore = null;
+        MethodHandle madvise = null;
+        long pageSize = 4096L;
+        try {
+            Linker linker = Linker.nativeLinker();
+            SymbolLookup libc = linker.defaultLookup();
+            mincore = libc.find("mincore")
+                    .map(sym -> linker.downcallHandle(sym, FunctionDescriptor.of(JAVA_INT, ADDRESS, JAVA_LONG, ADDRESS)))
+                    .orElse(null);
+            madvise = libc.find("madvise")
+                    .map(sym -> linker.downcallHandle(sym, FunctionDescriptor.of(JAVA_INT, ADDRESS, JAVA_LONG, JAVA_INT)))
+                    .orElse(null);
+            MethodHandle getpagesize = libc.find("getpagesize")
+                    .map(sym -> linker.downcallHandle(sym, FunctionDescriptor.of(JAVA_INT)))
+                    .orElse(null);
+            if (getpagesize != null) {
+                pageSize = Math.max(1, (int) getpagesize.invoke());
+            }
+        } catch (Throwable t) {
+            mincore = null;
+            madvise = null;
+        }
+        MINCORE = mincore;
+        MADVISE = madvise;
+        PAGE_SIZE = pageSize;
+    }
+
+    private PageResidency() {}
+
+    /** Fraction of the pages backing {@code [0, length)} of {@code mmap} that are in the page cache. */
+    static double residentFraction(MappedByteBuffer mmap, long length) {
+        long size = Math.min(length, mmap.capacity());
+        if (size <= 0) {
+            return 1.0;
+        }
+        if (MINCORE == null) {
+            return mmap.isLoaded() ? 1.0 : 0.0;
+        }
+        long base = MemorySegment.ofBuffer(mmap).address();
+        long aligned = base & -PAGE_SIZE;
+        long span = size + (base - aligned);
+        long pages = (span + PAGE_SIZE - 1) / PAGE_SIZE;
+        try (Arena arena = Arena.ofConfined()) {
+            MemorySegment vec = arena.allocate(pages);
+            int rc = (int) MINCORE.invoke(MemorySegment.ofAddress(aligned), span, vec);
+            if (rc != 0) {
+                return mmap.isLoaded() ? 1.0 : 0.0;
+            }
+            long resident = 0;
+            for (long i = 0; i < pages; i++) {
+                resident += vec.get(JAVA_BYTE, i) & 1;
+            }
+            return resident / (double) pages;
+        } catch (Throwable t) {
+            return mmap.isLoaded() ? 1.0 : 0.0;
+        }
+    }
+
+    /** Asks the kernel to read {@code [0, length)} of {@code mmap} ahead; returns immediately. */
+    static void willNeed(MappedByteBuffer mmap, long length) {
+        long size = Math.min(length, mmap.capacity());
+        if (MADVISE == null || size <= 0) {
+            return;
+        }
+        long base = MemorySegment.ofBuffer(mmap).address();
+        long aligned = base & -PAGE_SIZE;
+        try {
+            MADVISE.invoke(MemorySegment.ofAddress(aligned), size + (base - aligned), MADV_WILLNEED);
+        } catch (Throwable ignored) {
+            // advisory only
+        }
+    }
+}
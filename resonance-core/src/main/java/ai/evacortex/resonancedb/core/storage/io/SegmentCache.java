@@ -8,11 +8,13 @@
  */
 package ai.evacortex.resonancedb.core.storage.io;
 
+import com.github.benmanes.caffeine.cache.Cache;
 import com.github.benmanes.caffeine.cache.Caffeine;
-import com.github.benmanes.caffeine.cache.LoadingCache;
 import com.github.benmanes.caffeine.cache.RemovalCause;
 
 import java.io.Closeable;
+import java.io.IOException;
+import java.io.UncheckedIOException;
 import java.nio.file.Path;
 import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.ConcurrentMap;
@@ -20,19 +22,24 @@ import java.util.concurrent.atomic.AtomicBoolean;
 
 public class SegmentCache implements Closeable {
 
+    private final Path dir;
     private final ConcurrentMap<String, Long> versions;
-    private final LoadingCache<Key, CachedReader> cache;
+    /** Reader of the version a segment's offset just moved past; the next version is extended from it. */
+    private final ConcurrentMap<String, CachedReader> superseded;
+    private final Cache<Key, CachedReader> cache;
     private record Key(String name, long ver) {}
 
     private final AtomicBoolean isClosed = new AtomicBoolean(false);
 
     public SegmentCache(Path dir) {
+        this.dir = dir;
         this.versions = new ConcurrentHashMap<>();
+        this.superseded = new ConcurrentHashMap<>();
         this.cache = Caffeine.newBuilder()
                 .maximumWeight(Runtime.getRuntime().maxMemory() - (64L << 20))
                 .weigher((Key k, CachedReader r) -> (int)Math.min(r.getWeightInBytes(), Integer.MAX_VALUE))
                 .removalListener((Key k, CachedReader r, RemovalCause c) -> { if (r != null) r.close(); })
-                .build(k -> CachedReader.open(dir.resolve(k.name)));
+                .build();
     }
 
     public void updateVersion(String seg, long lastOffset) {
@@ -40,24 +47,82 @@ public class SegmentCache implements Closeable {
         if (isClosed.get()) return;
         Long prev = versions.put(seg, lastOffset);
         if (prev != null && prev != lastOffset) {
-            cache.invalidate(new Key(seg, prev));
+            retire(seg, prev, lastOffset > prev);
         }
-        cache.refresh(new Key(seg, lastOffset));
     }
 
 
+    /** Like {@link #updateVersion} but never moves a segment back to an older offset; safe for concurrent appenders. */
+    public void advanceVersion(String seg, long lastOffset) {
+        if (isClosed.get()) return;
+        Long prev = versions.get(seg);
+        while (prev == null || prev < lastOffset) {
+            boolean swapped = prev == null
+                    ? versions.putIfAbsent(seg, lastOffset) == null
+                    : versions.replace(seg, prev, lastOffset);
+            if (swapped) {
+                if (prev != null) {
+                    retire(seg, prev, true);
+                }
+                return;
+            }
+            prev = versions.get(seg);
+        }
+    }
+
+    public void evict(String seg) {
+        Long prev = versions.remove(seg);
+        superseded.remove(seg);
+        if (prev != null) {
+            cache.invalidate(new Key(seg, prev));
+        }
+    }
+
+    /** Reader for the current version of {@code seg}, opened on a miss; {@code null} if unknown or unreadable. */
     public CachedReader get(String seg) {
         if (isClosed.get()) return null;
         long v = versions.getOrDefault(seg, -1L);
         if (v < 0) return null;
-        Key key = new Key(seg, v);
-        return cache.getIfPresent(key);
+        try {
+            return cache.get(new Key(seg, v), this::load);
+        } catch (RuntimeException e) {
+            return null;
+        }
+    }
+
+    /**
+     * Drops the reader of an older version. When the segment only grew, that reader is kept as the base
+     * of the next version, so an append costs a walk over the new records rather than a reopen.
+     */
+    private void retire(String seg, long version, boolean appended) {
+        Key old = new Key(seg, version);
+        CachedReader reader = appended ? cache.getIfPresent(old) : null;
+        if (reader != null) {
+            superseded.put(seg, reader);
+        } else if (!appended) {
+            superseded.remove(seg);
+        }
+        cache.invalidate(old);
+    }
+
+    private CachedReader load(Key key) {
+        CachedReader base = superseded.remove(key.name());
+        CachedReader next = base != null ? base.extend(key.ver()) : null;
+        if (next != null) {
+            return next;
+        }
+        try {
+            return CachedReader.open(dir.resolve(key.name()));
+        } catch (IOException e) {
+            throw new UncheckedIOException(e);
+        }
     }
 
     @Override
     public void close() {
         isClosed.set(true);
+        superseded.clear();
         cache.invalidateAll();
         cache.cleanUp();
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,502 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.storage.io;
+
+import ai.evacortex.resonancedb.core.storage.io.codec.WavePatternCodec;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.nio.file.StandardOpenOption;
+import java.util.Arrays;
+import java.util.HexFormat;
+import java.util.Map;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * Id/offset index of one segment: record offsets in append order, a tombstone bitmap and an
+ * open-addressing table from id to record. Ids are compared against the segment itself, so a lookup
+ * costs one probe sequence and no allocation. A record is live unless its bit is set, which happens
+ * when it is deleted or when a later record of the segment carries the same id.
+ *
+ * <p>Writers persist it as a {@code .ids} sidecar when a segment is sealed or closed. Layout:
+ * {@code magic, version, recordCount, liveCount, tableSize, reserved, lastOffset, checksum}
+ * followed by {@code [offset:long × recordCount][tombstones:long × ⌈recordCount/64⌉][table:int × tableSize]}.
+ * Readers map the sidecar and read the tables in place. A sidecar whose {@code lastOffset} or checksum
+ * differs from the segment header is stale and ignored; deletes flushed to a sealed segment patch the
+ * bitmap and the checksum in place ({@link #patchTombstones}) so the sidecar stays valid.</p>
+ *
+ * <p>Records appended after the index was built go to a tail ({@link #extend}); only the records
+ * before it are ever stored.</p>
+ */
+public final class SegmentIdIndex {
+
+    private static final int MAGIC = 0x58444952; // 'RIDX'
+    private static final int VERSION = 2;
+    private static final int FILE_HEADER_SIZE = 40;
+    private static final int LIVE_COUNT_POS = 12;
+    private static final int CHECKSUM_POS = 32;
+    private static final String SUFFIX = ".ids";
+    private static final int ID_SIZE = 16;
+    private static final int RECORD_HEADER_SIZE = 1 + ID_SIZE + 4 + 4;
+    private static final int ALIGNMENT = 8;
+    private static final int EMPTY = -1;
+
+    /** Sidecar body, little-endian: the mapped file past its header, or a heap copy built by a scan. */
+    private final ByteBuffer data;
+    private final MappedByteBuffer mapping;
+    private final int recordCount;
+    private final int tombstonePos;
+    private final int tablePos;
+    private final int tableSize;
+    private final int[] liveOrdinals;
+    private final Tail tail;
+
+    /**
+     * Records appended after the base tables were built. Versions extended from one another share the
+     * arrays: each sees its first {@code count} records, an extension only writes past the newest
+     * version's records and reallocates when full, so older versions keep reading what they saw.
+     * The table is probed to its end, and entries an older version does not know are skipped.
+     */
+    private record Tail(AtomicInteger tip, long[] offsets, int[] live, int[] table, int count, int liveCount) {
+
+        static Tail empty() {
+            int[] table = new int[64];
+            Arrays.fill(table, EMPTY);
+            return new Tail(new AtomicInteger(), new long[32], new int[32], table, 0, 0);
+        }
+
+        /** Newest of the first {@code count} records with the given id words, or {@code -1}. */
+        int find(ByteBuffer segment, long lo, long hi) {
+            int mask = table.length - 1;
+            int best = -1;
+            for (int s = slot(lo, mask); table[s] != EMPTY; s = (s + 1) & mask) {
+                int r = table[s];
+                if (r < count && r > best) {
+                    int p = (int) offsets[r] + 1;
+                    if (segment.getLong(p) == lo && segment.getLong(p + 8) == hi) {
+                        best = r;
+                    }
+                }
+            }
+            return best;
+        }
+    }
+
+    private SegmentIdIndex(ByteBuffer data, MappedByteBuffer mapping, int recordCount, int tableSize) {
+        this.data = data;
+        this.mapping = mapping;
+        this.recordCount = recordCount;
+        this.tombstonePos = 8 * recordCount;
+        this.tablePos = tombstonePos + 8 * wordsFor(recordCount);
+        this.tableSize = tableSize;
+
+        int[] live = new int[recordCount];
+        int n = 0;
+        for (int r = 0; r < recordCount; r++) {
+            if (!isTombstoned(r)) {
+                live[n++] = r;
+            }
+        }
+        this.liveOrdinals = n == recordCount ? live : Arrays.copyOf(live, n);
+        this.tail = null;
+    }
+
+    private SegmentIdIndex(SegmentIdIndex base, Tail tail) {
+        this.data = base.data;
+        this.mapping = base.mapping;
+        this.recordCount = base.recordCount;
+        this.tombstonePos = base.tombstonePos;
+        this.tablePos = base.tablePos;
+        this.tableSize = base.tableSize;
+        this.liveOrdinals = base.liveOrdinals;
+        this.tail = tail;
+    }
+
+    public static Path pathFor(Path segmentPath) {
+        return segmentPath.resolveSibling(segmentPath.getFileName().toString() + SUFFIX);
+    }
+
+    /** Walks the record headers of {@code segment} up to {@code lastOffset}. */
+    static SegmentIdIndex scan(ByteBuffer segment, int headerSize, long lastOffset) {
+        long[] offsets = new long[64];
+        int total = 0;
+
+        long pos = headerSize;
+        while (pos + RECORD_HEADER_SIZE <= lastOffset) {
+            int len = segment.getInt((int) pos + 1 + ID_SIZE);
+            if (len <= 0 || len > WavePatternCodec.MAX_SUPPORTED_LENGTH) {
+                break;
+            }
+            if (total == offsets.length) {
+                offsets = Arrays.copyOf(offsets, total * 2);
+            }
+            offsets[total++] = pos;
+            pos += align(RECORD_HEADER_SIZE + WavePatternCodec.estimateSize(len, false));
+        }
+        return build(segment, offsets, total);
+    }
+
+    /**
+     * This index plus the records of {@code segment} in {@code [from, lastOffset)}, where {@code from} is the
+     * end this version covers. Only those records are walked and hashed. A record already tombstoned is left
+     * out of the live order; one that repeats an earlier id shadows it in lookups.
+     *
+     * @return {@code null} if another version was already extended from this one
+     */
+    SegmentIdIndex extend(ByteBuffer segment, long from, long lastOffset) {
+        Tail t = tail != null ? tail : Tail.empty();
+        synchronized (t.tip()) {
+            if (t.tip().get() != t.count()) {
+                return null;
+            }
+            long[] offsets = t.offsets();
+            int[] live = t.live();
+            int[] table = t.table();
+            int count = t.count();
+            int liveCount = t.liveCount();
+
+            long pos = from;
+            while (pos + RECORD_HEADER_SIZE <= lastOffset) {
+                int len = segment.getInt((int) pos + 1 + ID_SIZE);
+                if (len <= 0 || len > WavePatternCodec.MAX_SUPPORTED_LENGTH) {
+                    break;
+                }
+                if (count == offsets.length) {
+                    offsets = Arrays.copyOf(offsets, count * 2);
+                }
+                offsets[count] = pos;
+                if (segment.get((int) pos) == 0x01) {
+                    if (liveCount == live.length) {
+                        live = Arrays.copyOf(live, liveCount * 2);
+                    }
+                    live[liveCount++] = count;
+                }
+                if (2 * (count + 1) > table.length) {
+                    table = rehash(segment, offsets, count, table.length * 2);
+                }
+                insert(table, segment.getLong((int) pos + 1), count);
+                count++;
+                pos += align(RECORD_HEADER_SIZE + WavePatternCodec.estimateSize(len, false));
+            }
+            t.tip().set(count);
+            return new SegmentIdIndex(this, new Tail(t.tip(), offsets, live, table, count, liveCount));
+        }
+    }
+
+    /** Loads the persisted index of {@code segmentPath}, or returns {@code null} if it is missing or stale. */
+    static SegmentIdIndex load(Path segmentPath, long lastOffset, long checksum) {
+        Path p = pathFor(segmentPath);
+        if (!Files.exists(p)) {
+            return null;
+        }
+        try (FileChannel ch = FileChannel.open(p, StandardOpenOption.READ)) {
+            long size = ch.size();
+            if (size < FILE_HEADER_SIZE) {
+                return null;
+            }
+            MappedByteBuffer map = Buffers.mmap(ch, FileChannel.MapMode.READ_ONLY, 0, size);
+            int total = map.getInt(8);
+            int live = map.getInt(LIVE_COUNT_POS);
+            int tableSize = map.getInt(16);
+            if (map.getInt(0) != MAGIC || map.getInt(4) != VERSION
+                    || map.getLong(24) != lastOffset || map.getLong(CHECKSUM_POS) != checksum
+                    || total < 0 || live < 0 || live > total
+                    || tableSize < 1 || Integer.bitCount(tableSize) != 1 || tableSize < total
+                    || size != FILE_HEADER_SIZE + bodySize(total, tableSize)) {
+                Buffers.unmap(map);
+                return null;
+            }
+            ByteBuffer data = map.slice(FILE_HEADER_SIZE, (int) (size - FILE_HEADER_SIZE))
+                    .order(ByteOrder.LITTLE_ENDIAN);
+            SegmentIdIndex index = new SegmentIdIndex(data, map, total, tableSize);
+            if (index.liveCount() != live) {
+                Buffers.unmap(map);
+                return null;
+            }
+            return index;
+        } catch (IOException | RuntimeException e) {
+            return null;
+        }
+    }
+
+    /** Writes the index next to {@code segmentPath}, replacing any previous one atomically. */
+    void store(Path segmentPath, long lastOffset, long checksum) throws IOException {
+        Path target = pathFor(segmentPath);
+        Path tmp = target.resolveSibling(target.getFileName() + ".tmp");
+        ByteBuffer hdr = ByteBuffer.allocate(FILE_HEADER_SIZE).order(ByteOrder.LITTLE_ENDIAN);
+        hdr.putInt(MAGIC).putInt(VERSION).putInt(recordCount).putInt(liveOrdinals.length).putInt(tableSize).putInt(0);
+        hdr.putLong(lastOffset).putLong(checksum);
+        hdr.flip();
+        ByteBuffer body = data.duplicate().clear();
+
+        try (FileChannel ch = FileChannel.open(tmp, StandardOpenOption.CREATE, StandardOpenOption.WRITE,
+                StandardOpenOption.TRUNCATE_EXISTING)) {
+            writeFully(ch, hdr, 0L);
+            writeFully(ch, body, FILE_HEADER_SIZE);
+            ch.force(false);
+        }
+        Files.move(tmp, target, StandardCopyOption.REPLACE_EXISTING, StandardCopyOption.ATOMIC_MOVE);
+    }
+
+    /**
+     * Applies tombstone changes ({@code offset → deleted}) to the sidecar of {@code segmentPath} in place and
+     * moves its checksum from {@code checksum} to {@code newChecksum}, the value the segment header now holds.
+     * The checksum is written last, so a sidecar left half-patched by a crash is stale rather than wrong.
+     *
+     * @return {@code false} if the sidecar is missing, stale or does not list one of the offsets
+     */
+    static boolean patchTombstones(Path segmentPath, long lastOffset, long checksum, long newChecksum,
+                                   Map<Long, Boolean> changes) throws IOException {
+        Path p = pathFor(segmentPath);
+        if (!Files.exists(p)) {
+            return false;
+        }
+        try (FileChannel ch = FileChannel.open(p, StandardOpenOption.READ, StandardOpenOption.WRITE)) {
+            long size = ch.size();
+            if (size < FILE_HEADER_SIZE) {
+                return false;
+            }
+            MappedByteBuffer map = Buffers.mmap(ch, FileChannel.MapMode.READ_WRITE, 0, size);
+            try {
+                int total = map.getInt(8);
+                int tableSize = map.getInt(16);
+                if (map.getInt(0) != MAGIC || map.getInt(4) != VERSION
+                        || map.getLong(24) != lastOffset || map.getLong(CHECKSUM_POS) != checksum
+                        || total < 0 || tableSize < 1
+                        || size != FILE_HEADER_SIZE + bodySize(total, tableSize)) {
+                    return false;
+                }
+                int bitmap = FILE_HEADER_SIZE + 8 * total;
+                int live = map.getInt(LIVE_COUNT_POS);
+                for (Map.Entry<Long, Boolean> change : changes.entrySet()) {
+                    int r = ordinalOf(map, total, change.getKey());
+                    if (r < 0) {
+                        return false;
+                    }
+                    int word = bitmap + 8 * (r >>> 6);
+                    long bits = map.getLong(word);
+                    long bit = 1L << r;
+                    boolean wasSet = (bits & bit) != 0;
+                    if (change.getValue() != wasSet) {
+                        map.putLong(word, bits ^ bit);
+                        live += wasSet ? 1 : -1;
+                    }
+                }
+                map.putInt(LIVE_COUNT_POS, live);
+                map.force();
+                map.putLong(CHECKSUM_POS, newChecksum);
+                map.force();
+                return true;
+            } finally {
+                Buffers.unmap(map);
+            }
+        }
+    }
+
+    /** Records covered, live or tombstoned, including the tail. */
+    int recordCount() {
+        return recordCount + (tail != null ? tail.count() : 0);
+    }
+
+    int liveCount() {
+        return liveOrdinals.length + (tail != null ? tail.liveCount() : 0);
+    }
+
+    /** Record ordinal of live record {@code index}; tail records are numbered after the base ones. */
+    int liveOrdinal(int index) {
+        return index < liveOrdinals.length
+                ? liveOrdinals[index]
+                : recordCount + tail.live()[index - liveOrdinals.length];
+    }
+
+    long recordOffset(int ordinal) {
+        return ordinal < recordCount ? data.getLong(8 * ordinal) : tail.offsets()[ordinal - recordCount];
+    }
+
+    long liveOffset(int index) {
+        return recordOffset(liveOrdinal(index));
+    }
+
+    /** Whether base record {@code ordinal} is tombstoned in the bitmap. */
+    private boolean isTombstoned(int ordinal) {
+        return (data.getLong(tombstonePos + 8 * (ordinal >>> 6)) & (1L << ordinal)) != 0;
+    }
+
+    /** Heap held by the live order and the tail, plus the tables when they were built by a scan rather than mapped. */
+    long heapBytes() {
+        long tailBytes = tail == null ? 0L
+                : 8L * tail.offsets().length + 4L * tail.live().length + 4L * tail.table().length;
+        return 4L * liveOrdinals.length + tailBytes + (mapping != null ? 0L : data.capacity());
+    }
+
+    /** Releases the sidecar mapping, if any; no version of the index may be used afterwards. */
+    void unmap() {
+        Buffers.unmap(mapping);
+    }
+
+    /**
+     * Offset of the live record with {@code id} in {@code segment}, or {@code -1}. A tail record shadows
+     * earlier ones; whether it was deleted is read from its status byte, as the tail has no bitmap.
+     */
+    long find(ByteBuffer segment, String id) {
+        if (id == null || id.length() != 2 * ID_SIZE || liveCount() == 0) {
+            return -1L;
+        }
+        long lo;
+        long hi;
+        try {
+            lo = idWord(id, 0);
+            hi = idWord(id, 8);
+        } catch (IllegalArgumentException e) {
+            return -1L;
+        }
+        if (tail != null) {
+            int r = tail.find(segment, lo, hi);
+            if (r >= 0) {
+                long offset = tail.offsets()[r];
+                return segment.get((int) offset) == 0x01 ? offset : -1L;
+            }
+        }
+        int mask = tableSize - 1;
+        for (int s = slot(lo, mask); ; s = (s + 1) & mask) {
+            int r = data.getInt(tablePos + 4 * s);
+            if (r == EMPTY) {
+                return -1L;
+            }
+            long offset = recordOffset(r);
+            int p = (int) offset + 1;
+            if (segment.getLong(p) == lo && segment.getLong(p + 8) == hi) {
+                return isTombstoned(r) ? -1L : offset;
+            }
+        }
+    }
+
+    /**
+     * Hashes every record by id; when an id occurs twice, the later record takes the slot and the earlier
+     * one is tombstoned, as a replay of the append log would have it. Deleted records stay in the table
+     * with their bit set, so a patched bitmap is all a later delete or undelete has to change.
+     */
+    private static SegmentIdIndex build(ByteBuffer segment, long[] offsets, int total) {
+        int tableSize = tableSizeFor(total);
+        ByteBuffer data = ByteBuffer.allocate((int) bodySize(total, tableSize)).order(ByteOrder.LITTLE_ENDIAN);
+        int tombstonePos = 8 * total;
+        int tablePos = tombstonePos + 8 * wordsFor(total);
+        for (int r = 0; r < total; r++) {
+            data.putLong(8 * r, offsets[r]);
+        }
+        for (int s = 0; s < tableSize; s++) {
+            data.putInt(tablePos + 4 * s, EMPTY);
+        }
+
+        long[] tombstones = new long[wordsFor(total)];
+        int mask = tableSize - 1;
+        for (int r = 0; r < total; r++) {
+            int p = (int) offsets[r];
+            if (segment.get(p) != 0x01) {
+                tombstones[r >>> 6] |= 1L << r;
+            }
+            long lo = segment.getLong(p + 1);
+            long hi = segment.getLong(p + 1 + 8);
+            int s = slot(lo, mask);
+            int prev;
+            while ((prev = data.getInt(tablePos + 4 * s)) != EMPTY) {
+                int q = (int) offsets[prev] + 1;
+                if (segment.getLong(q) == lo && segment.getLong(q + 8) == hi) {
+                    tombstones[prev >>> 6] |= 1L << prev;
+                    break;
+                }
+                s = (s + 1) & mask;
+            }
+            data.putInt(tablePos + 4 * s, r);
+        }
+        for (int w = 0; w < tombstones.length; w++) {
+            data.putLong(tombstonePos + 8 * w, tombstones[w]);
+        }
+        return new SegmentIdIndex(data, null, total, tableSize);
+    }
+
+    /** Binary search of the ascending offset column of a mapped sidecar. */
+    private static int ordinalOf(ByteBuffer map, int total, long offset) {
+        int lo = 0;
+        int hi = total - 1;
+        while (lo <= hi) {
+            int mid = (lo + hi) >>> 1;
+            long v = map.getLong(FILE_HEADER_SIZE + 8 * mid);
+            if (v < offset) {
+                lo = mid + 1;
+            } else if (v > offset) {
+                hi = mid - 1;
+            } else {
+                return mid;
+            }
+        }
+        return -1;
+    }
+
+    private static int[] rehash(ByteBuffer segment, long[] offsets, int count, int size) {
+        int[] table = new int[size];
+        Arrays.fill(table, EMPTY);
+        for (int r = 0; r < count; r++) {
+            insert(table, segment.getLong((int) offsets[r] + 1), r);
+        }
+        return table;
+    }
+
+    /** Puts {@code ordinal} in the first free slot of its probe sequence; earlier records with the id stay. */
+    private static void insert(int[] table, long idWord, int ordinal) {
+        int mask = table.length - 1;
+        int s = slot(idWord, mask);
+        while (table[s] != EMPTY) {
+            s = (s + 1) & mask;
+        }
+        table[s] = ordinal;
+    }
+
+    private static long bodySize(int total, int tableSize) {
+        return 8L * total + 8L * wordsFor(total) + 4L * tableSize;
+    }
+
+    private static int wordsFor(int total) {
+        return (total + 63) >>> 6;
+    }
+
+    private static int tableSizeFor(int total) {
+        return Integer.highestOneBit(Math.max(1, total) * 2 - 1) << 1;
+    }
+
+    private static int slot(long idWord, int mask) {
+        return (int) (idWord ^ (idWord >>> 32)) & mask;
+    }
+
+    /** Little-endian word of the id bytes {@code [from, from + 8)}, as the segment stores them. */
+    private static long idWord(String id, int from) {
+        long word = 0L;
+        for (int b = from + 7; b >= from; b--) {
+            word = (word << 8) | HexFormat.fromHexDigits(id, 2 * b, 2 * b + 2);
+        }
+        return word;
+    }
+
+    private static void writeFully(FileChannel ch, ByteBuffer buf, long position) throws IOException {
+        long pos = position;
+        while (buf.hasRemaining()) {
+            pos += ch.write(buf, pos);
+        }
+    }
+
+    private static int align(int size) {
+        return ((size + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+    }
+}
@@ -0,0 +1,121 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.storage.io;
+
+import java.lang.foreign.MemorySegment;
+import java.nio.ByteBuffer;
+
+/**
+ * Read-only view over the summary sidecar of a segment, indexed in the reader's live-record order.
+ *
+ * <p>Per record it exposes the total energy {@code Σ A²}, the energy of the spectral prefix,
+ * the sign sketch and the prefix itself as complex components {@code A·cos φ}, {@code A·sin φ}.</p>
+ */
+public final class SegmentSummary {
+
+    static final int ENERGY_POS = 8;
+    static final int PREFIX_ENERGY_POS = 16;
+    static final int SKETCH_POS = 24;
+
+    private final ByteBuffer entries;
+    private final SegmentIdIndex index;
+    private final int count;
+    private final int patternLen;
+    private final int words;
+    private final int prefixLen;
+    private final int entrySize;
+    private final int prefixPos;
+
+    SegmentSummary(ByteBuffer entries, SegmentIdIndex index,
+                   int patternLen, int words, int prefixLen, int entrySize) {
+        this.entries = entries;
+        this.index = index;
+        this.count = index.liveCount();
+        this.patternLen = patternLen;
+        this.words = words;
+        this.prefixLen = prefixLen;
+        this.entrySize = entrySize;
+        this.prefixPos = SKETCH_POS + 8 * words;
+    }
+
+    public int count() {
+        return count;
+    }
+
+    public int patternLen() {
+        return patternLen;
+    }
+
+    public int words() {
+        return words;
+    }
+
+    public int prefixLen() {
+        return prefixLen;
+    }
+
+    public double energy(int index) {
+        return entries.getDouble(base(index) + ENERGY_POS);
+    }
+
+    public double prefixEnergy(int index) {
+        return entries.getDouble(base(index) + PREFIX_ENERGY_POS);
+    }
+
+    public void copySketch(int index, long[] dst, int dstOff) {
+        int pos = base(index) + SKETCH_POS;
+        for (int w = 0; w < words; w++) {
+            dst[dstOff + w] = entries.getLong(pos + 8 * w);
+        }
+    }
+
+    /**
+     * The sketches of every record in the sidecar, live or tombstoned, read in place from the mapping:
+     * record {@code r} starts {@code r * sketchStride()} little-endian longs in. Map live indexes with
+     * {@link #ordinal(int)}.
+     */
+    public MemorySegment sketches() {
+        return MemorySegment.ofBuffer(entries).asSlice(SKETCH_POS);
+    }
+
+    public int sketchStride() {
+        return entrySize / Long.BYTES;
+    }
+
+    /** Records covered by the sidecar, including tombstoned ones. */
+    public int recordCount() {
+        return entries.capacity() / entrySize;
+    }
+
+    /** Record position of live record {@code index}. */
+    public int ordinal(int index) {
+        return this.index.liveOrdinal(index);
+    }
+
+    /**
+     * Returns {@code Σ_{k<prefixLen} A_q·A_c·cos(φ_c − φ_q)} given the query prefix in complex form.
+     */
+    public double prefixCross(int index, double[] queryRe, double[] queryIm) {
+        int re = base(index) + prefixPos;
+        int im = re + 4 * prefixLen;
+        double sum = 0.0;
+        for (int k = 0; k < prefixLen; k++) {
+            sum += queryRe[k] * entries.getFloat(re + 4 * k) + queryIm[k] * entries.getFloat(im + 4 * k);
+        }
+        return sum;
+    }
+
+    void unmap() {
+        Buffers.unmap(entries);
+    }
+
+    private int base(int index) {
+        return this.index.liveOrdinal(index) * entrySize;
+    }
+}
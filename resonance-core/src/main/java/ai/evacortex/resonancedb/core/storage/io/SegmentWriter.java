@@ -15,6 +15,7 @@ import ai.evacortex.resonancedb.core.storage.WavePattern;
 import ai.evacortex.resonancedb.core.storage.io.codec.WavePatternCodec;
 import ai.evacortex.resonancedb.core.storage.io.format.BinaryHeader;
 
+import java.io.EOFException;
 import java.io.IOException;
 import java.io.RandomAccessFile;
 import java.nio.ByteBuffer;
@@ -23,10 +24,29 @@ import java.nio.MappedByteBuffer;
 import java.nio.channels.FileChannel;
 import java.nio.file.Files;
 import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.HashMap;
 import java.util.HexFormat;
+import java.util.Map;
+import java.util.OptionalInt;
+import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.atomic.AtomicLong;
 import java.util.concurrent.locks.ReentrantReadWriteLock;
 
+/**
+ * Appends records to one memory-mapped segment.
+ *
+ * <p>Concurrent {@link #write} calls reserve disjoint byte ranges with a CAS on the reservation
+ * cursor and encode into them in parallel. A record becomes visible only once the commit watermark
+ * has advanced over it, which happens strictly in offset order, so the header written by
+ * {@link #flush()} never covers a partially written record. Operations that need the whole segment
+ * ({@link #close()}) take the write lock; appends, tombstones and flushes share the read lock.</p>
+ *
+ * <p>An existing segment is opened from its header alone and holds no file descriptor: the read-write
+ * channel, its mapping and the summary sidecar are set up by the first append, tombstone or flush.
+ * Sealed segments are read through the reader cache, so until they are mutated their writer is only
+ * a handle to the path and header.</p>
+ */
 public class SegmentWriter implements AutoCloseable {
 
     private static final long MAX_SEG_BYTES = Long.parseLong(System.getProperty("resonance.segment.maxBytes", "" + (64L << 20)));
@@ -35,12 +55,27 @@ public class SegmentWriter implements AutoCloseable {
 
     private final Path path;
     private final String segmentName;
-    private final FileChannel channel;
+    private volatile FileChannel channel;
+    private volatile boolean closed;
     private final AtomicLong writeOffset;
     private final ReentrantReadWriteLock lock;
+    private final Object commitLock = new Object();
+    private final Object mapLock = new Object();
+    private final Map<Long, Completed> completed = new ConcurrentHashMap<>();
 
-    private MappedByteBuffer buffer;
+    private record Completed(long end, WavePattern pattern) {}
+
+    private volatile MappedByteBuffer buffer;
+    private final long capacity;
+    private SummarySidecar summary;
     private int recordCount = 0;
+    private volatile long committedOffset;
+    private long flushedOffset = -1L;
+    private long flushedChecksum;
+    private long indexedOffset = -1L;
+    private long indexedChecksum;
+    /** Tombstones set ({@code true}) or cleared since the sidecar was written or patched; guarded by commitLock. */
+    private final Map<Long, Boolean> tombstoneChanges = new HashMap<>();
     private final int headerSize;
     private final int checksumLength;
 
@@ -56,104 +91,205 @@ public class SegmentWriter implements AutoCloseable {
             this.segmentName = path.getFileName().toString();
             Files.createDirectories(path.getParent());
 
-            RandomAccessFile raf = new RandomAccessFile(path.toFile(), "rw");
-            this.channel = raf.getChannel();
-
-            boolean isNew = channel.size() == 0;
-            long mapSize = Math.max(MAX_SEG_BYTES, channel.size());
-            this.buffer = Buffers.mmap(channel, FileChannel.MapMode.READ_WRITE, 0, mapSize);
-            this.buffer.order(ByteOrder.LITTLE_ENDIAN);
+            long size = Files.exists(path) ? Files.size(path) : 0L;
+            this.capacity = Math.max(MAX_SEG_BYTES, size);
 
-            if (isNew) {
+            if (size == 0) {
                 BinaryHeader header = new BinaryHeader(1, System.currentTimeMillis(), 0,
                         headerSize, 0L, (byte) 1, checksumLength);
+                mapped();
                 ensureCapacity(headerSize);
                 buffer.position(0);
                 buffer.put(header.toBytes());
                 this.writeOffset = new AtomicLong(headerSize);
+                this.committedOffset = headerSize;
             } else {
-                ByteBuffer hdr = buffer.duplicate().order(ByteOrder.LITTLE_ENDIAN);
-                hdr.position(0);
+                ByteBuffer hdr = ByteBuffer.allocate(headerSize).order(ByteOrder.LITTLE_ENDIAN);
+                try (FileChannel ch = FileChannel.open(path, StandardOpenOption.READ)) {
+                    readFully(ch, hdr, 0L);
+                }
+                hdr.flip();
                 BinaryHeader header = BinaryHeader.from(hdr, checksumLength);
                 this.recordCount = header.recordCount();
                 this.writeOffset = new AtomicLong(header.lastOffset());
+                this.committedOffset = header.lastOffset();
             }
         } catch (IOException e) {
             throw new RuntimeException("Failed to initialize segment writer", e);
         }
     }
 
-    public long write(String hexId, WavePattern pattern) throws SegmentOverflowException {
-        lock.writeLock().lock();
-        try {
-            byte[] idBytes = HexFormat.of().parseHex(hexId);
-            if (idBytes.length != 16) {
-                throw new InvalidWavePatternException("ID must be a 16-byte MD5 hex string (32 characters)");
-            }
-
-            int patternSize = WavePatternCodec.estimateSize(pattern, false);
-            int blockSize = RECORD_HEADER_SIZE + patternSize;
-            int alignedSize = align(blockSize);
-
-            long offset = writeOffset.get();
-            if (offset + alignedSize > buffer.capacity()) {
-                throw new SegmentOverflowException("Not enough space in segment");
+    /** The read-write mapping, created together with the summary sidecar on first use. */
+    private MappedByteBuffer mapped() {
+        MappedByteBuffer b = buffer;
+        if (b != null) {
+            return b;
+        }
+        synchronized (mapLock) {
+            if (buffer == null) {
+                if (closed) {
+                    throw new IllegalStateException("Segment writer is closed: " + segmentName);
+                }
+                if (channel == null) {
+                    try {
+                        channel = new RandomAccessFile(path.toFile(), "rw").getChannel();
+                    } catch (IOException e) {
+                        throw new RuntimeException("Failed to open segment for writing: " + segmentName, e);
+                    }
+                }
+                MappedByteBuffer map = Buffers.mmap(channel, FileChannel.MapMode.READ_WRITE, 0, capacity);
+                map.order(ByteOrder.LITTLE_ENDIAN);
+                synchronized (commitLock) {
+                    summary = SummarySidecar.openForAppend(path, recordCount);
+                }
+                buffer = map;
             }
+            return buffer;
+        }
+    }
 
-            ensureCapacity(Math.max(offset + alignedSize, headerSize));
+    public long write(String hexId, WavePattern pattern) throws SegmentOverflowException {
+        byte[] idBytes = HexFormat.of().parseHex(hexId);
+        if (idBytes.length != 16) {
+            throw new InvalidWavePatternException("ID must be a 16-byte MD5 hex string (32 characters)");
+        }
+        int len = pattern.amplitude().length;
+        if (len <= 0 || len > WavePatternCodec.MAX_SUPPORTED_LENGTH || pattern.phase().length != len) {
+            throw new InvalidWavePatternException("Unsupported WavePattern length: " + len);
+        }
 
-            buffer.position((int) offset);
-            buffer.put((byte) 0x01);
-            buffer.put(idBytes);
-            buffer.putInt(pattern.amplitude().length);
-            buffer.putInt(-1);
+        int patternSize = WavePatternCodec.estimateSize(pattern, false);
+        int blockSize = RECORD_HEADER_SIZE + patternSize;
+        int alignedSize = align(blockSize);
 
-            WavePatternCodec.writeDirect(buffer, pattern);
-            int pad = alignedSize - blockSize;
-            for (int i = 0; i < pad; i++) {
-                buffer.put((byte) 0);
+        lock.readLock().lock();
+        try {
+            MappedByteBuffer buffer = mapped();
+            long offset;
+            do {
+                offset = writeOffset.get();
+                if (offset + alignedSize > buffer.capacity()) {
+                    throw new SegmentOverflowException("Not enough space in segment");
+                }
+            } while (!writeOffset.compareAndSet(offset, offset + alignedSize));
+
+            boolean written = false;
+            try {
+                MappedByteBuffer view = buffer.duplicate();
+                view.order(ByteOrder.LITTLE_ENDIAN);
+                view.position((int) offset);
+                view.put((byte) 0x01);
+                view.put(idBytes);
+                view.putInt(len);
+                view.putInt(-1);
+                WavePatternCodec.writeDirect(view, pattern);
+                for (int i = blockSize; i < alignedSize; i++) {
+                    view.put((byte) 0);
+                }
+                written = true;
+            } finally {
+                if (!written) {
+                    // The range is already reserved, and any Throwable may have left a partial header: rewrite it
+                    // as a tombstone of the same size so the watermark and record walks can pass it.
+                    try {
+                        writeTombstoneHeader(buffer, offset, idBytes, len);
+                    } finally {
+                        commit(offset, offset + alignedSize, null);
+                    }
+                }
             }
+            commit(offset, offset + alignedSize, pattern);
+            awaitCommitted(offset + alignedSize);
+            return offset;
+        } finally {
+            lock.readLock().unlock();
+        }
+    }
 
-            writeOffset.addAndGet(alignedSize);
-            recordCount++;
+    private static void writeTombstoneHeader(MappedByteBuffer buffer, long offset, byte[] idBytes, int len) {
+        ByteBuffer view = buffer.duplicate().order(ByteOrder.LITTLE_ENDIAN);
+        int p = (int) offset;
+        view.put(p, (byte) 0x00);
+        view.put(p + 1, idBytes);
+        view.putInt(p + 1 + idBytes.length, len);
+        view.putInt(p + 1 + idBytes.length + 4, -1);
+    }
 
-            int checksumOffset = headerSize;
-            int lengthToChecksum = (int) (writeOffset.get() - checksumOffset);
+    /**
+     * Marks {@code [offset, end)} as written and advances the commit watermark over every contiguous
+     * completed record, appending their summaries in offset order.
+     */
+    private void commit(long offset, long end, WavePattern pattern) {
+        completed.put(offset, new Completed(end, pattern));
+        synchronized (commitLock) {
+            Completed next;
+            while ((next = completed.remove(committedOffset)) != null) {
+                if (next.pattern() != null) {
+                    appendSummary(committedOffset, next.pattern());
+                } else if (summary != null) {
+                    summary.discard();
+                    summary = null;
+                }
+                recordCount++;
+                committedOffset = next.end();
+            }
+            commitLock.notifyAll();
+        }
+    }
 
-            ByteBuffer checksumBuf = buffer.duplicate().order(ByteOrder.LITTLE_ENDIAN);
-            checksumBuf.position(checksumOffset);
-            checksumBuf.limit(checksumOffset + lengthToChecksum);
+    /** Blocks until every record below {@code end} is committed; earlier reservations are still being encoded. */
+    private void awaitCommitted(long end) {
+        boolean interrupted = false;
+        synchronized (commitLock) {
+            while (committedOffset < end) {
+                try {
+                    commitLock.wait();
+                } catch (InterruptedException e) {
+                    interrupted = true;
+                }
+            }
+        }
+        if (interrupted) {
+            Thread.currentThread().interrupt();
+        }
+    }
 
-            return offset;
-        } finally {
-            lock.writeLock().unlock();
+    private void appendSummary(long offset, WavePattern pattern) {
+        if (summary == null) return;
+        try {
+            summary.append(offset, pattern);
+        } catch (IOException e) {
+            summary.discard();
+            summary = null;
         }
     }
 
     public void markDeleted(long offset) {
-        lock.writeLock().lock();
+        lock.readLock().lock();
         try {
-            if (offset < buffer.limit()) {
-                buffer.put((int) offset, (byte) 0x00);
+            if (offset < committedOffset) {
+                mapped().put((int) offset, (byte) 0x00);
+                recordTombstone(offset, true);
             } else {
-                throw new IllegalStateException("Offset exceeds segment capacity: " + offset);
+                throw new IllegalStateException("Offset is not a committed record: " + offset);
             }
         } finally {
-            lock.writeLock().unlock();
+            lock.readLock().unlock();
         }
     }
 
     public void unmarkDeleted(long offset) {
-        lock.writeLock().lock();
+        lock.readLock().lock();
         try {
-            buffer.position((int) offset);
-            buffer.put((byte) 0x01);
+            MappedByteBuffer buffer = mapped();
+            buffer.put((int) offset, (byte) 0x01);
+            recordTombstone(offset, false);
             buffer.force();
             channel.force(false);
         } catch (IOException e) {
             throw new RuntimeException("Failed to unmark deleted at offset: " + offset, e);
         } finally {
-            lock.writeLock().unlock();
+            lock.readLock().unlock();
         }
     }
 
@@ -177,53 +313,139 @@ public class SegmentWriter implements AutoCloseable {
         int patternSize = WavePatternCodec.estimateSize(pattern, false);
         int blockSize = RECORD_HEADER_SIZE + patternSize;
         int aligned = align(blockSize);
-        return writeOffset.get() + aligned > buffer.capacity();
+        return writeOffset.get() + aligned > capacity;
     }
 
+    /** Publishes the committed prefix in the header and forces it; returns the committed offset. */
     public long flush() {
-        lock.writeLock().lock();
+        lock.readLock().lock();
         try {
-            if (buffer == null) {
+            if (closed) {
                 throw new IllegalStateException("Segment buffer is null during flush");
             }
-            int lengthToChecksum = (int) (writeOffset.get() - headerSize);
-            if (lengthToChecksum < 0) {
-                throw new IllegalStateException("Invalid checksum length: " + lengthToChecksum);
+            MappedByteBuffer buffer = mapped();
+            synchronized (commitLock) {
+                long finalOffset = committedOffset;
+                int lengthToChecksum = (int) (finalOffset - headerSize);
+                if (lengthToChecksum < 0) {
+                    throw new IllegalStateException("Invalid checksum length: " + lengthToChecksum);
+                }
+
+                ByteBuffer checksumBuf = buffer.duplicate().order(ByteOrder.LITTLE_ENDIAN);
+                checksumBuf.position(headerSize);
+                checksumBuf.limit(headerSize + lengthToChecksum);
+                long checksum = HashingUtil.computeChecksum(checksumBuf.slice(), checksumLength);
+
+                BinaryHeader header = new BinaryHeader(
+                        1, System.currentTimeMillis(), recordCount, finalOffset,
+                        checksum, (byte) 1, checksumLength);
+
+                buffer.put(0, header.toBytes());
+
+                buffer.force();
+                flushedOffset = finalOffset;
+                flushedChecksum = checksum;
+                patchIdIndex(finalOffset, checksum);
+                return finalOffset;
             }
+        } finally {
+            lock.readLock().unlock();
+        }
+    }
 
-            ByteBuffer checksumBuf = buffer.duplicate().order(ByteOrder.LITTLE_ENDIAN);
-            checksumBuf.position(headerSize);
-            checksumBuf.limit(headerSize + lengthToChecksum);
-            long checksum = HashingUtil.computeChecksum(checksumBuf.slice(), checksumLength);
+    /**
+     * Marks the segment as no longer the append target of its group: flushes it and writes the
+     * {@code .ids} sidecar once, so readers open the segment without walking its records. Tombstones
+     * flushed later are patched into the sidecar rather than invalidating it.
+     */
+    public void seal() {
+        flush();
+        storeIdIndex();
+    }
 
-            long finalOffset = writeOffset.get();
-            BinaryHeader header = new BinaryHeader(
-                    1, System.currentTimeMillis(), recordCount, finalOffset,
-                    checksum, (byte) 1, checksumLength);
+    private void recordTombstone(long offset, boolean deleted) {
+        synchronized (commitLock) {
+            if (offset < indexedOffset) {
+                tombstoneChanges.put(offset, deleted);
+            }
+        }
+    }
 
-            buffer.position(0);
-            buffer.put(header.toBytes());
+    /**
+     * Carries the tombstones of a flush into the sidecar when it still covers every record. If the patch
+     * fails the sidecar stays stale, and the next seal or close writes it again.
+     */
+    private void patchIdIndex(long finalOffset, long checksum) {
+        if (indexedOffset != finalOffset || indexedChecksum == checksum || tombstoneChanges.isEmpty()) {
+            tombstoneChanges.clear();
+            return;
+        }
+        try {
+            if (SegmentIdIndex.patchTombstones(path, finalOffset, indexedChecksum, checksum, tombstoneChanges)) {
+                indexedChecksum = checksum;
+            } else {
+                indexedOffset = -1L;
+            }
+        } catch (IOException | RuntimeException e) {
+            indexedOffset = -1L;
+            System.err.println("Failed to patch id index of " + segmentName + ": " + e.getMessage());
+        }
+        tombstoneChanges.clear();
+    }
 
-            buffer.force();
-            return writeOffset.get();
+    /** Writes the sidecar for the last flushed header unless it already matches. */
+    private void storeIdIndex() {
+        lock.readLock().lock();
+        try {
+            MappedByteBuffer buffer = this.buffer;
+            if (buffer == null) {
+                return;
+            }
+            synchronized (commitLock) {
+                if (flushedOffset < 0 || (indexedOffset == flushedOffset && indexedChecksum == flushedChecksum)) {
+                    return;
+                }
+                SegmentIdIndex.scan(buffer.duplicate().order(ByteOrder.LITTLE_ENDIAN), headerSize, flushedOffset)
+                        .store(path, flushedOffset, flushedChecksum);
+                indexedOffset = flushedOffset;
+                indexedChecksum = flushedChecksum;
+                tombstoneChanges.clear();
+            }
+        } catch (IOException | RuntimeException e) {
+            // Readers fall back to scanning the segment.
+            System.err.println("Failed to write id index of " + segmentName + ": " + e.getMessage());
         } finally {
-            lock.writeLock().unlock();
+            lock.readLock().unlock();
         }
     }
 
     public void sync() {
-        lock.writeLock().lock();
+        lock.readLock().lock();
         try {
             if (buffer != null) {
                 buffer.force();
             }
-            if (channel.isOpen()) {
-                channel.force(true);
+            FileChannel ch = channel;
+            if (ch != null && ch.isOpen()) {
+                ch.force(true);
+            }
+            synchronized (commitLock) {
+                if (summary != null) {
+                    summary.force();
+                }
             }
         } catch (IOException e) {
             throw new RuntimeException("Failed to sync segment to disk", e);
         } finally {
-            lock.writeLock().unlock();
+            lock.readLock().unlock();
+        }
+    }
+
+    private void readFully(FileChannel ch, ByteBuffer dst, long position) throws IOException {
+        while (dst.hasRemaining()) {
+            if (ch.read(dst, position + dst.position()) < 0) {
+                throw new EOFException("Unexpected end of segment " + segmentName + " at " + position);
+            }
         }
     }
 
@@ -240,11 +462,32 @@ public class SegmentWriter implements AutoCloseable {
     }
 
     public double getFillRatio() {
-        return (double) writeOffset.get() / buffer.capacity();
+        return (double) writeOffset.get() / capacity;
+    }
+
+    /** Whether the read-write mapping has been set up; segments that were only read stay unmapped. */
+    public boolean isMapped() {
+        return buffer != null;
+    }
+
+    /** Pattern length of the first record, read from the file without mapping it; empty for an empty segment. */
+    public OptionalInt firstRecordLength() {
+        if (committedOffset < headerSize + RECORD_HEADER_SIZE) {
+            return OptionalInt.empty();
+        }
+        ByteBuffer len = ByteBuffer.allocate(4).order(ByteOrder.LITTLE_ENDIAN);
+        try (FileChannel ch = FileChannel.open(path, StandardOpenOption.READ)) {
+            readFully(ch, len, headerSize + 1 + 16);
+        } catch (IOException e) {
+            return OptionalInt.empty();
+        }
+        int n = len.getInt(0);
+        return n > 0 && n <= WavePatternCodec.MAX_SUPPORTED_LENGTH ? OptionalInt.of(n) : OptionalInt.empty();
     }
 
+    /** End of the committed prefix: every byte below it belongs to a fully written record. */
     public long getWriteOffset() {
-        return writeOffset.get();
+        return committedOffset;
     }
 
     public long approxSize() {
@@ -257,12 +500,18 @@ public class SegmentWriter implements AutoCloseable {
         try {
             if (buffer != null) {
                 flush();
+                storeIdIndex();
                 Buffers.unmap(buffer);
                 buffer = null;
             }
-            if (channel.isOpen()) {
+            closed = true;
+            if (channel != null && channel.isOpen()) {
                 channel.close();
             }
+            if (summary != null) {
+                summary.close();
+                summary = null;
+            }
         } catch (IOException e) {
             throw new RuntimeException("Failed to close segment writer", e);
         } finally {
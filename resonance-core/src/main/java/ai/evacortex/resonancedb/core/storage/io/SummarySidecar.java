@@ -0,0 +1,263 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.storage.io;
+
+import ai.evacortex.resonancedb.core.math.SignSketch;
+import ai.evacortex.resonancedb.core.storage.WavePattern;
+import ai.evacortex.resonancedb.core.storage.io.codec.WavePatternCodec;
+
+import java.io.EOFException;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+
+/**
+ * Append-only sidecar holding one fixed-size summary entry per segment record,
+ * in record (append) order, including records that were later tombstoned.
+ *
+ * <p>Layout: {@code magic, version, patternLen, prefixLen} followed by entries of
+ * {@code [recordOffset:long][energy:double][prefixEnergy:double][sketch:long × words]
+ * [prefixRe:float × prefixLen][prefixIm:float × prefixLen]}. A sidecar that does not line up
+ * with its segment (or has an older version) is ignored by readers and dropped by writers;
+ * compaction rebuilds it.</p>
+ */
+public final class SummarySidecar implements AutoCloseable {
+
+    private static final int MAGIC = 0x4D555352; // 'RSUM'
+    private static final int VERSION = 2;
+    private static final int HEADER_SIZE = 16;
+    private static final String SUFFIX = ".summary";
+    private static final int PREFIX_DIMS = Math.max(0, Integer.getInteger("resonance.summary.prefixDims", 64));
+
+    private final Path path;
+    private final FileChannel channel;
+    private int patternLen;
+    private int prefixLen;
+    private int entrySize;
+    private long entries;
+
+    private record Header(int patternLen, int prefixLen, int entrySize) {}
+
+    private SummarySidecar(Path path, FileChannel channel, Header header, long entries) {
+        this.path = path;
+        this.channel = channel;
+        if (header != null) {
+            this.patternLen = header.patternLen();
+            this.prefixLen = header.prefixLen();
+            this.entrySize = header.entrySize();
+        }
+        this.entries = entries;
+    }
+
+    public static Path pathFor(Path segmentPath) {
+        return segmentPath.resolveSibling(segmentPath.getFileName().toString() + SUFFIX);
+    }
+
+    static int entrySizeFor(int patternLen, int prefixLen) {
+        return SegmentSummary.SKETCH_POS + 8 * SignSketch.wordsFor(patternLen) + 8 * prefixLen;
+    }
+
+    static SummarySidecar openForAppend(Path segmentPath, int recordCount) {
+        Path p = pathFor(segmentPath);
+        FileChannel ch = null;
+        try {
+            ch = FileChannel.open(p, StandardOpenOption.CREATE, StandardOpenOption.READ, StandardOpenOption.WRITE);
+            long size = ch.size();
+            Header header = readHeader(ch);
+
+            if (header == null) {
+                if (recordCount == 0) {
+                    ch.truncate(0);
+                    return new SummarySidecar(p, ch, null, 0);
+                }
+                ch.close();
+                Files.deleteIfExists(p);
+                return null;
+            }
+
+            long have = (size - HEADER_SIZE) / header.entrySize();
+            if (have < recordCount) {
+                ch.close();
+                Files.deleteIfExists(p);
+                return null;
+            }
+            long keep = HEADER_SIZE + (long) recordCount * header.entrySize();
+            if (size != keep) {
+                ch.truncate(keep);
+            }
+            return new SummarySidecar(p, ch, header, recordCount);
+        } catch (IOException e) {
+            if (ch != null) {
+                try {
+                    ch.close();
+                } catch (IOException ignored) {}
+            }
+            return null;
+        }
+    }
+
+    void append(long recordOffset, WavePattern pattern) throws IOException {
+        int len = pattern.amplitude().length;
+        if (patternLen == 0) {
+            writeHeader(len);
+        } else if (len != patternLen) {
+            throw new IOException("Pattern length " + len + " does not match summary length " + patternLen);
+        }
+
+        double[] amp = pattern.amplitude();
+        double[] phase = pattern.phase();
+        double energy = 0.0;
+        double prefixEnergy = 0.0;
+        for (int i = 0; i < len; i++) {
+            double e = amp[i] * amp[i];
+            energy += e;
+            if (i < prefixLen) {
+                prefixEnergy += e;
+            }
+        }
+
+        long[] sketch = SignSketch.of(pattern);
+        ByteBuffer buf = ByteBuffer.allocate(entrySize).order(ByteOrder.LITTLE_ENDIAN);
+        buf.putLong(recordOffset);
+        buf.putDouble(energy);
+        buf.putDouble(prefixEnergy);
+        for (long w : sketch) {
+            buf.putLong(w);
+        }
+        for (int k = 0; k < prefixLen; k++) {
+            buf.putFloat((float) (amp[k] * Math.cos(phase[k])));
+        }
+        for (int k = 0; k < prefixLen; k++) {
+            buf.putFloat((float) (amp[k] * Math.sin(phase[k])));
+        }
+        buf.flip();
+
+        long pos = HEADER_SIZE + entries * entrySize;
+        while (buf.hasRemaining()) {
+            pos += channel.write(buf, pos);
+        }
+        entries++;
+    }
+
+    void force() throws IOException {
+        if (channel.isOpen()) {
+            channel.force(false);
+        }
+    }
+
+    void discard() {
+        try {
+            channel.close();
+        } catch (IOException ignored) {}
+        try {
+            Files.deleteIfExists(path);
+        } catch (IOException ignored) {}
+    }
+
+    @Override
+    public void close() throws IOException {
+        if (channel.isOpen()) {
+            channel.close();
+        }
+    }
+
+    static SegmentSummary load(Path segmentPath, SegmentIdIndex index) {
+        return load(segmentPath, index, 0);
+    }
+
+    /**
+     * Summary of a reader extended from one with {@code prev}: the entries {@code prev} covers were
+     * already checked against the index, so only the appended ones are.
+     */
+    static SegmentSummary extend(Path segmentPath, SegmentSummary prev, SegmentIdIndex index) {
+        return load(segmentPath, index, prev != null ? prev.recordCount() : 0);
+    }
+
+    /** Maps the entries of every record of {@code index}, checking those from {@code verifiedCount} on. */
+    private static SegmentSummary load(Path segmentPath, SegmentIdIndex index, int verifiedCount) {
+        int total = index.recordCount();
+        Path p = pathFor(segmentPath);
+        if (total == 0 || !Files.exists(p)) {
+            return null;
+        }
+
+        try (FileChannel ch = FileChannel.open(p, StandardOpenOption.READ)) {
+            Header header = readHeader(ch);
+            if (header == null) {
+                return null;
+            }
+            int entry = header.entrySize();
+            long body = (long) total * entry;
+            if (body > Integer.MAX_VALUE || ch.size() < HEADER_SIZE + body) {
+                return null;
+            }
+
+            MappedByteBuffer map = Buffers.mmap(ch, FileChannel.MapMode.READ_ONLY, HEADER_SIZE, body);
+            for (int i = Math.min(verifiedCount, total); i < total; i++) {
+                if (map.getLong(i * entry) != index.recordOffset(i)) {
+                    Buffers.unmap(map);
+                    return null;
+                }
+            }
+
+            return new SegmentSummary(map, index,
+                    header.patternLen(), SignSketch.wordsFor(header.patternLen()), header.prefixLen(), entry);
+        } catch (IOException | RuntimeException e) {
+            return null;
+        }
+    }
+
+    private void writeHeader(int len) throws IOException {
+        ByteBuffer hdr = ByteBuffer.allocate(HEADER_SIZE).order(ByteOrder.LITTLE_ENDIAN);
+        int prefix = Math.min(PREFIX_DIMS, len);
+        hdr.putInt(MAGIC).putInt(VERSION).putInt(len).putInt(prefix);
+        hdr.flip();
+        long pos = 0;
+        while (hdr.hasRemaining()) {
+            pos += channel.write(hdr, pos);
+        }
+        this.patternLen = len;
+        this.prefixLen = prefix;
+        this.entrySize = entrySizeFor(len, prefix);
+    }
+
+    private static Header readHeader(FileChannel ch) throws IOException {
+        if (ch.size() < HEADER_SIZE) {
+            return null;
+        }
+        ByteBuffer buf = ByteBuffer.allocate(HEADER_SIZE).order(ByteOrder.LITTLE_ENDIAN);
+        readFully(ch, buf, 0);
+        int magic = buf.getInt(0);
+        int version = buf.getInt(4);
+        int len = buf.getInt(8);
+        int prefix = buf.getInt(12);
+        if (magic != MAGIC || version != VERSION
+                || len <= 0 || len > WavePatternCodec.MAX_SUPPORTED_LENGTH
+                || prefix < 0 || prefix > len) {
+            return null;
+        }
+        return new Header(len, prefix, entrySizeFor(len, prefix));
+    }
+
+    private static void readFully(FileChannel ch, ByteBuffer dst, long position) throws IOException {
+        long pos = position;
+        while (dst.hasRemaining()) {
+            int n = ch.read(dst, pos);
+            if (n < 0) {
+                throw new EOFException("Unexpected end of summary sidecar");
+            }
+            pos += n;
+        }
+    }
+}
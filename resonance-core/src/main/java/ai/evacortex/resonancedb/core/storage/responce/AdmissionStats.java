@@ -0,0 +1,33 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.storage.responce;
+
+import java.util.Map;
+
+/**
+ * Point-in-time view of query admission control: running queries and their estimated scan bytes,
+ * waiting queries per priority class and per corpus, and lifetime admit/reject counters.
+ */
+public record AdmissionStats(
+        int inFlight,
+        int maxInFlight,
+        long inFlightBytes,
+        long maxInFlightBytes,
+        int queuedInteractive,
+        int queuedBatch,
+        Map<String, Integer> queuedByCorpus,
+        long admitted,
+        long rejected
+) {
+    public static final AdmissionStats EMPTY = new AdmissionStats(0, 0, 0L, 0L, 0, 0, Map.of(), 0L, 0L);
+
+    public int queued() {
+        return queuedInteractive + queuedBatch;
+    }
+}
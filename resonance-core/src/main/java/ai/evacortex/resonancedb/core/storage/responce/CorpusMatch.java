@@ -0,0 +1,30 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.storage.responce;
+
+import ai.evacortex.resonancedb.core.storage.WavePattern;
+import com.fasterxml.jackson.annotation.JsonInclude;
+
+import java.util.Map;
+
+/**
+ * One hit of a query over several corpora: a {@link ResonanceMatch} and the corpus it was found in.
+ * Ids are content hashes, so the same id may appear once per corpus.
+ */
+public record CorpusMatch(
+        String corpusId,
+        String id,
+        float energy,
+        WavePattern pattern,
+        @JsonInclude(JsonInclude.Include.NON_NULL) Map<String, String> metadata
+) {
+    public static CorpusMatch of(String corpusId, ResonanceMatch match) {
+        return new CorpusMatch(corpusId, match.id(), match.energy(), match.pattern(), match.metadata());
+    }
+}
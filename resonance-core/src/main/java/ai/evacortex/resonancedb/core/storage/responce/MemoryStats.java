@@ -0,0 +1,28 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.storage.responce;
+
+import java.util.Map;
+
+/**
+ * Point-in-time view of the memory governor: the global byte budget, the accounted heap structures,
+ * query scratch and page-cache-resident mapped bytes of all tenants, and lifetime trim/evict counters.
+ */
+public record MemoryStats(
+        long budgetBytes,
+        long usedBytes,
+        long heapBytes,
+        long scratchBytes,
+        long mappedBytes,
+        Map<String, Long> byTenant,
+        long trimmedBytes,
+        long evictions
+) {
+    public static final MemoryStats EMPTY = new MemoryStats(0L, 0L, 0L, 0L, 0L, Map.of(), 0L, 0L);
+}
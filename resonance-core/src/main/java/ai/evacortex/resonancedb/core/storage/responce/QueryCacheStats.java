@@ -0,0 +1,19 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.storage.responce;
+
+public record QueryCacheStats(
+        long corpusVersion,
+        long hits,
+        long misses,
+        double hitRate,
+        long entries,
+        long weightBytes,
+        long maxBytes
+) {}
@@ -0,0 +1,24 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.storage.responce;
+
+import ai.evacortex.resonancedb.core.engine.QueryOptions;
+
+import java.util.List;
+
+/**
+ * One page of a ranked query. {@code nextCursor} resumes strictly after the last match and is
+ * {@code null} when no further matches exist; {@code corpusVersion} is the version the page was
+ * ranked at.
+ */
+public record QueryPage<T>(List<T> matches,
+                           String nextCursor,
+                           QueryOptions options,
+                           long corpusVersion,
+                           boolean partial) {}
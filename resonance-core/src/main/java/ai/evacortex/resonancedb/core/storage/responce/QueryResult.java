@@ -0,0 +1,26 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.storage.responce;
+
+import ai.evacortex.resonancedb.core.engine.QueryOptions;
+
+import java.util.List;
+
+/**
+ * Query matches together with the options the store actually applied: the phase epsilon after
+ * widening, the resolved overfetch factor, and caps cleared by exact mode.
+ *
+ * <p>{@code partial} is set when the query deadline expired before every routed segment was
+ * scanned; {@code matches} then holds the best matches found so far.</p>
+ */
+public record QueryResult<T>(List<T> matches,
+                             QueryOptions options,
+                             int segmentsScanned,
+                             long candidatesScored,
+                             boolean partial) {}
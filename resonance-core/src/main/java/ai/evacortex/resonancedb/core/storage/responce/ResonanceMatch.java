@@ -9,5 +9,21 @@
 package ai.evacortex.resonancedb.core.storage.responce;
 
 import ai.evacortex.resonancedb.core.storage.WavePattern;
+import com.fasterxml.jackson.annotation.JsonInclude;
 
-public record ResonanceMatch(String id, float energy, WavePattern pattern) {}
\ No newline at end of file
+import java.util.Map;
+
+/**
+ * One query hit. {@code pattern} is {@code null} when the query projection is not {@code FULL};
+ * {@code metadata} is set only for the {@code IDS_SCORES_METADATA} projection.
+ */
+public record ResonanceMatch(
+        String id,
+        float energy,
+        WavePattern pattern,
+        @JsonInclude(JsonInclude.Include.NON_NULL) Map<String, String> metadata
+) {
+    public ResonanceMatch(String id, float energy, WavePattern pattern) {
+        this(id, energy, pattern, null);
+    }
+}
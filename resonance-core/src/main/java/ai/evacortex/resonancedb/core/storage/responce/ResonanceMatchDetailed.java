@@ -10,6 +10,9 @@ package ai.evacortex.resonancedb.core.storage.responce;
 
 import ai.evacortex.resonancedb.core.math.ResonanceZone;
 import ai.evacortex.resonancedb.core.storage.WavePattern;
+import com.fasterxml.jackson.annotation.JsonInclude;
+
+import java.util.Map;
 
 public record ResonanceMatchDetailed(
         String id,
@@ -17,5 +20,15 @@ public record ResonanceMatchDetailed(
         WavePattern pattern,
         double phaseDelta,
         ResonanceZone zone,
-        double zoneScore
-) {}
\ No newline at end of file
+        double zoneScore,
+        @JsonInclude(JsonInclude.Include.NON_NULL) Map<String, String> metadata
+) {
+    public ResonanceMatchDetailed(String id,
+                                  float energy,
+                                  WavePattern pattern,
+                                  double phaseDelta,
+                                  ResonanceZone zone,
+                                  double zoneScore) {
+        this(id, energy, pattern, phaseDelta, zone, zoneScore, null);
+    }
+}
@@ -0,0 +1,23 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.storage.responce;
+
+import ai.evacortex.resonancedb.core.engine.QueryOptions;
+
+/**
+ * Summary of a threshold query whose matches were streamed to a sink.
+ *
+ * <p>{@code partial} is set when the deadline or the candidate cap stopped the scan before every
+ * eligible segment was read, so further matches above the floor may exist.</p>
+ */
+public record ThresholdResult(long emitted,
+                              QueryOptions options,
+                              int segmentsScanned,
+                              long candidatesScored,
+                              boolean partial) {}
@@ -27,6 +27,10 @@ public final class AutoLock implements AutoCloseable {
         return new AutoLock(rw.writeLock());
     }
 
+    public static AutoLock of(Lock lock) {
+        return new AutoLock(lock);
+    }
+
     @Override
     public void close() {
         lock.unlock();
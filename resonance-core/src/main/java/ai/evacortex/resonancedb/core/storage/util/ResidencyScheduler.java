@@ -0,0 +1,57 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.storage.util;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.ForkJoinTask;
+import java.util.function.Consumer;
+import java.util.function.Function;
+import java.util.function.Predicate;
+
+/**
+ * Splits a scan by page-cache residency so that warm segments are scored while the kernel reads the cold
+ * ones ahead. CPU-bound scoring of warm data then overlaps the disk I/O instead of queueing behind it.
+ */
+public final class ResidencyScheduler {
+
+    private ResidencyScheduler() {}
+
+    /**
+     * Runs the task for the resident {@code items} and the task for the cold ones concurrently on
+     * {@code pool} and concatenates their results, warm first. Read-ahead of every cold item starts before
+     * either task, and the cold task is forked right after, so idle workers pick it up while the warm
+     * one is still scoring. Each task keeps the input order; when every item is resident, or none is,
+     * one task covers all of them.
+     */
+    public static <S, T> List<T> invoke(ForkJoinPool pool,
+                                        List<S> items,
+                                        Predicate<? super S> resident,
+                                        Consumer<? super S> prefetch,
+                                        Function<List<S>, ? extends ForkJoinTask<List<T>>> taskFor) {
+        List<S> warm = new ArrayList<>(items.size());
+        List<S> cold = new ArrayList<>();
+        for (S item : items) {
+            if (resident.test(item)) {
+                warm.add(item);
+            } else {
+                prefetch.accept(item);
+                cold.add(item);
+            }
+        }
+        if (warm.isEmpty() || cold.isEmpty()) {
+            return pool.invoke(taskFor.apply(items));
+        }
+        ForkJoinTask<List<T>> coldScan = pool.submit(taskFor.apply(cold));
+        List<T> out = new ArrayList<>(pool.invoke(taskFor.apply(warm)));
+        out.addAll(coldScan.join());
+        return out;
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core.storage.util;
+
+import java.util.concurrent.CancellationException;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionException;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ConcurrentMap;
+import java.util.concurrent.atomic.LongAdder;
+import java.util.function.BooleanSupplier;
+import java.util.function.Supplier;
+
+/**
+ * Collapses concurrent calls with an equal key into one computation. The first caller computes; callers
+ * arriving while it runs wait for and share its value or exception. The key is forgotten as soon as
+ * the computation ends, so nothing is served after the fact — keys must carry whatever makes a
+ * result stale (e.g. a corpus version).
+ */
+public final class SingleFlight<K, V> {
+
+    private final ConcurrentMap<K, CompletableFuture<V>> inFlight = new ConcurrentHashMap<>();
+    private final LongAdder shared = new LongAdder();
+
+    /**
+     * Returns {@code compute}'s value, or that of an equal in-flight call. When {@code abandoned} holds
+     * after the leader computed (its caller went away, so the value may be cut short), waiters compute
+     * their own instead of sharing it.
+     */
+    public V execute(K key, Supplier<V> compute, BooleanSupplier abandoned) {
+        CompletableFuture<V> mine = new CompletableFuture<>();
+        CompletableFuture<V> running = inFlight.putIfAbsent(key, mine);
+        if (running != null) {
+            try {
+                V value = running.join();
+                shared.increment();
+                return value;
+            } catch (CancellationException e) {
+                return compute.get();
+            } catch (CompletionException e) {
+                throw propagate(e.getCause());
+            }
+        }
+        try {
+            V value = compute.get();
+            if (abandoned.getAsBoolean()) {
+                mine.cancel(false);
+            } else {
+                mine.complete(value);
+            }
+            return value;
+        } catch (Throwable t) {
+            mine.completeExceptionally(t);
+            throw t;
+        } finally {
+            inFlight.remove(key, mine);
+        }
+    }
+
+    /** Calls answered by another caller's computation since creation. */
+    public long shared() {
+        return shared.sum();
+    }
+
+    private static RuntimeException propagate(Throwable cause) {
+        if (cause instanceof RuntimeException re) {
+            return re;
+        }
+        if (cause instanceof Error err) {
+            throw err;
+        }
+        return new CompletionException(cause);
+    }
+}
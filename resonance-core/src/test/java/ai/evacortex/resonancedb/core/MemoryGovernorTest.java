@@ -0,0 +1,121 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core;
+
+import ai.evacortex.resonancedb.core.storage.MemoryGovernor;
+import ai.evacortex.resonancedb.core.storage.responce.MemoryStats;
+import org.junit.jupiter.api.Test;
+
+import java.util.concurrent.TimeUnit;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+class MemoryGovernorTest {
+
+    private static final class FakeTenant implements MemoryGovernor.Tenant {
+        final String name;
+        long heap;
+        long trimmable;
+        final long lastAccess;
+        final boolean evictable;
+        long trimmed;
+        boolean evicted;
+
+        FakeTenant(String name, long heap, long trimmable, long idleSeconds, boolean evictable) {
+            this.name = name;
+            this.heap = heap;
+            this.trimmable = trimmable;
+            this.lastAccess = System.nanoTime() - TimeUnit.SECONDS.toNanos(idleSeconds);
+            this.evictable = evictable;
+        }
+
+        @Override
+        public String name() {
+            return name;
+        }
+
+        @Override
+        public MemoryGovernor.Footprint footprint() {
+            return new MemoryGovernor.Footprint(heap, 0L, 0L);
+        }
+
+        @Override
+        public long lastAccessNanos() {
+            return lastAccess;
+        }
+
+        @Override
+        public long trim(long bytes) {
+            long take = Math.min(bytes, trimmable);
+            trimmable -= take;
+            heap -= take;
+            trimmed += take;
+            return take;
+        }
+
+        @Override
+        public boolean evict() {
+            if (!evictable) {
+                return false;
+            }
+            heap = 0L;
+            evicted = true;
+            return true;
+        }
+    }
+
+    @Test
+    void testTrimsLargestIdleTenantFirstAndStopsUnderBudget() {
+        MemoryGovernor governor = new MemoryGovernor(1_000L);
+        FakeTenant idle = new FakeTenant("idle", 800L, 300L, 60, true);
+        FakeTenant hot = new FakeTenant("hot", 400L, 400L, 0, true);
+        governor.register(idle);
+        governor.register(hot);
+
+        assertEquals(200L, governor.rebalance());
+        assertEquals(200L, idle.trimmed);
+        assertEquals(0L, hot.trimmed);
+        assertFalse(idle.evicted || hot.evicted);
+
+        MemoryStats stats = governor.stats();
+        assertEquals(1_000L, stats.usedBytes());
+        assertEquals(200L, stats.trimmedBytes());
+        assertEquals(0L, stats.evictions());
+        assertEquals(600L, stats.byTenant().get("idle"));
+        assertEquals(0L, governor.rebalance());
+    }
+
+    @Test
+    void testEvictsOnlyWhenTrimmingFallsShortAndSkipsBusyTenants() {
+        MemoryGovernor governor = new MemoryGovernor(100L);
+        FakeTenant busy = new FakeTenant("busy", 500L, 0L, 120, false);
+        FakeTenant idle = new FakeTenant("idle", 500L, 50L, 60, true);
+        governor.register(busy);
+        governor.register(idle);
+
+        assertEquals(500L, governor.rebalance());
+        assertEquals(50L, idle.trimmed);
+        assertTrue(idle.evicted);
+        assertFalse(busy.evicted);
+        assertEquals(1L, governor.stats().evictions());
+        assertEquals(500L, governor.stats().usedBytes());
+    }
+
+    @Test
+    void testZeroBudgetOnlyAccounts() {
+        MemoryGovernor governor = new MemoryGovernor(0L);
+        FakeTenant tenant = new FakeTenant("a", 1L << 30, 1L << 30, 600, true);
+        governor.register(tenant);
+
+        assertFalse(governor.enabled());
+        assertEquals(0L, governor.rebalance());
+        assertEquals(0L, tenant.trimmed);
+        assertEquals(1L << 30, governor.stats().usedBytes());
+    }
+}
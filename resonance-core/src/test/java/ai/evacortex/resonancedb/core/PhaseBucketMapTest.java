@@ -0,0 +1,90 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core;
+
+import ai.evacortex.resonancedb.core.storage.PhaseBucketMap;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.nio.file.Path;
+import java.util.List;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+class PhaseBucketMapTest {
+
+    private static final double WIDTH = (2 * Math.PI) / 64;
+
+    @TempDir
+    Path tempDir;
+
+    @Test
+    void testDefaultMapMatchesFixedBuckets() {
+        PhaseBucketMap map = PhaseBucketMap.loadOrCreate(tempDir.resolve("buckets.json"), WIDTH);
+
+        assertEquals(64, map.ranges().size());
+        assertEquals("phase-0", map.groupFor(-Math.PI));
+        assertEquals("phase-0", map.groupFor(-10.0));
+        assertEquals("phase-32", map.groupFor(0.01));
+        assertEquals("phase-63", map.groupFor(Math.PI));
+        assertEquals("phase-63", map.groupFor(10.0));
+    }
+
+    @Test
+    void testSplitMergeAndReload() {
+        Path file = tempDir.resolve("buckets.json");
+        PhaseBucketMap map = PhaseBucketMap.loadOrCreate(file, WIDTH);
+
+        PhaseBucketMap.Range hot = map.rangeFor(0.01);
+        double at = hot.lo() + hot.width() / 3;
+        List<PhaseBucketMap.Range> halves = map.split(hot.group(), at);
+
+        assertEquals(65, map.ranges().size());
+        assertEquals(halves.get(0).group(), map.groupFor(at - 1e-6));
+        assertEquals(halves.get(1).group(), map.groupFor(at));
+        assertNull(map.rangeOf(hot.group()));
+
+        PhaseBucketMap.Range merged = map.merge(halves.get(1), map.next(halves.get(1)));
+        assertEquals(64, map.ranges().size());
+        assertEquals(merged.group(), map.groupFor(at + 1e-6));
+        map.flush();
+
+        PhaseBucketMap reloaded = PhaseBucketMap.loadOrCreate(file, WIDTH);
+        assertEquals(map.ranges(), reloaded.ranges());
+
+        List<PhaseBucketMap.Range> again = reloaded.split(merged.group(), merged.lo() + merged.width() / 2);
+        assertNotEquals(merged.group(), again.get(0).group());
+        assertNotEquals(halves.get(0).group(), again.get(0).group(), "group names must not be reused");
+    }
+
+    @Test
+    void testPlannedSplitIsInstalledByReplace() {
+        PhaseBucketMap map = PhaseBucketMap.loadOrCreate(tempDir.resolve("buckets.json"), WIDTH);
+        PhaseBucketMap.Range hot = map.rangeFor(0.01);
+
+        List<PhaseBucketMap.Range> halves = map.planSplit(hot.group(), hot.lo() + hot.width() / 2);
+        assertEquals(hot, map.rangeOf(hot.group()), "planning must not change the map");
+        assertNull(map.rangeOf(halves.get(0).group()));
+
+        map.replace(List.of(hot), halves);
+        assertEquals(65, map.ranges().size());
+        assertEquals(halves.get(1).group(), map.groupFor(0.01));
+        assertThrows(IllegalArgumentException.class, () -> map.replace(List.of(hot), halves),
+                "a replaced range is no longer current");
+        assertThrows(IllegalArgumentException.class,
+                () -> map.replace(halves, List.of(halves.get(0))), "targets must tile the sources");
+    }
+
+    @Test
+    void testMergeRejectsNonAdjacentRanges() {
+        PhaseBucketMap map = PhaseBucketMap.loadOrCreate(tempDir.resolve("buckets.json"), WIDTH);
+        List<PhaseBucketMap.Range> ranges = map.ranges();
+        assertThrows(IllegalArgumentException.class, () -> map.merge(ranges.get(0), ranges.get(2)));
+    }
+}
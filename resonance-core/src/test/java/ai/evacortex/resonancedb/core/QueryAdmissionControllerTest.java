@@ -0,0 +1,125 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core;
+
+import ai.evacortex.resonancedb.core.engine.QueryOptions;
+import ai.evacortex.resonancedb.core.exceptions.QueryRejectedException;
+import ai.evacortex.resonancedb.core.storage.QueryAdmissionController;
+import org.junit.jupiter.api.Test;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.*;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+class QueryAdmissionControllerTest {
+
+    private static final QueryOptions.Priority BATCH = QueryOptions.Priority.BATCH;
+    private static final QueryOptions.Priority INTERACTIVE = QueryOptions.Priority.INTERACTIVE;
+
+    @Test
+    void testQueueBoundAndLatencyTargetShedLoad() throws Exception {
+        QueryAdmissionController admission = new QueryAdmissionController(1, 1L << 30, 1, 50, 10_000, 4, 1);
+        ExecutorService pool = Executors.newSingleThreadExecutor();
+        try (QueryAdmissionController.Permit running = admission.admit("a", BATCH, 0)) {
+            Future<QueryAdmissionController.Permit> waiting = pool.submit(() -> admission.admit("a", BATCH, 0));
+            awaitQueued(admission, 1);
+
+            assertThrows(QueryRejectedException.class, () -> admission.admit("b", BATCH, 0));
+
+            running.close();
+            waiting.get(10, TimeUnit.SECONDS).close();
+        } finally {
+            pool.shutdownNow();
+        }
+
+        try (QueryAdmissionController.Permit ignored = admission.admit("a", BATCH, 0)) {
+            assertThrows(QueryRejectedException.class, () -> admission.admit("a", INTERACTIVE, 0));
+        }
+        assertEquals(0, admission.stats().inFlight());
+        assertEquals(0, admission.stats().queued());
+        assertEquals(2, admission.stats().rejected());
+    }
+
+    @Test
+    void testQueueingCountsAgainstTheQueryDeadline() {
+        QueryAdmissionController admission = new QueryAdmissionController(1, 1L << 30, 4, 10_000, 10_000, 4, 1);
+        try (QueryAdmissionController.Permit running = admission.admit("a", BATCH, 0)) {
+            long start = System.nanoTime();
+            long deadline = start + TimeUnit.MILLISECONDS.toNanos(50);
+            assertThrows(QueryRejectedException.class, () -> admission.admit("a", BATCH, 0, deadline));
+            assertTrue(System.nanoTime() - start < TimeUnit.SECONDS.toNanos(5),
+                    "a queued query must give up at its deadline, not at the class target");
+
+            assertThrows(QueryRejectedException.class, () -> admission.admit("a", BATCH, 0, System.nanoTime() - 1));
+        }
+        assertEquals(0, admission.stats().queued());
+        assertEquals(2, admission.stats().rejected());
+    }
+
+    @Test
+    void testQueuedPoolWorkerDoesNotStarveThePool() throws Exception {
+        QueryAdmissionController admission = new QueryAdmissionController(1, 1L << 30, 4, 10_000, 10_000, 4, 1);
+        ForkJoinPool pool = new ForkJoinPool(1);
+        try (QueryAdmissionController.Permit running = admission.admit("a", BATCH, 0)) {
+            ForkJoinTask<?> waiting = pool.submit(() -> admission.admit("a", BATCH, 0).close());
+            awaitQueued(admission, 1);
+
+            assertEquals(42, pool.submit(() -> 42).get(10, TimeUnit.SECONDS),
+                    "a worker queued in admission must be compensated so other tasks still run");
+
+            running.close();
+            waiting.get(10, TimeUnit.SECONDS);
+        } finally {
+            pool.shutdownNow();
+        }
+        assertEquals(0, admission.stats().inFlight());
+    }
+
+    @Test
+    void testCorporaShareTheQueueFairly() throws Exception {
+        QueryAdmissionController admission = new QueryAdmissionController(1, 1L << 30, 16, 10_000, 10_000, 4, 1);
+        List<String> order = new CopyOnWriteArrayList<>();
+        ExecutorService pool = Executors.newCachedThreadPool();
+        List<Future<?>> futures = new ArrayList<>();
+        try {
+            QueryAdmissionController.Permit running = admission.admit("busy", BATCH, 0);
+            String[] arrivals = {"busy", "busy", "busy", "quiet"};
+            for (int i = 0; i < arrivals.length; i++) {
+                String corpus = arrivals[i];
+                futures.add(pool.submit(() -> {
+                    try (QueryAdmissionController.Permit ignored = admission.admit(corpus, BATCH, 0)) {
+                        order.add(corpus);
+                    }
+                    return null;
+                }));
+                awaitQueued(admission, i + 1);
+            }
+            assertEquals(3, admission.stats().queuedByCorpus().get("busy"));
+
+            running.close();
+            for (Future<?> f : futures) {
+                f.get(10, TimeUnit.SECONDS);
+            }
+        } finally {
+            pool.shutdownNow();
+        }
+
+        assertEquals(List.of("busy", "quiet", "busy", "busy"), order);
+    }
+
+    private static void awaitQueued(QueryAdmissionController admission, int queued) throws InterruptedException {
+        long deadline = System.nanoTime() + TimeUnit.SECONDS.toNanos(10);
+        while (admission.stats().queued() < queued) {
+            assertTrue(System.nanoTime() < deadline, "waiters did not queue");
+            Thread.sleep(1);
+        }
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core;
+
+import ai.evacortex.resonancedb.core.storage.util.ResidencyScheduler;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.Test;
+
+import java.util.ArrayList;
+import java.util.Comparator;
+import java.util.List;
+import java.util.Random;
+import java.util.Set;
+import java.util.concurrent.CopyOnWriteArrayList;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.ForkJoinTask;
+import java.util.concurrent.TimeUnit;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+class ResidencySchedulerTest {
+
+    private record Segment(String name, List<Double> scores) {}
+
+    private final ForkJoinPool pool = new ForkJoinPool(2);
+
+    @AfterEach
+    void shutdown() {
+        pool.shutdownNow();
+    }
+
+    @Test
+    void testColdSegmentsArePrefetchedAndResidentOnesComeFirst() {
+        List<String> segments = List.of("a", "b", "c", "d", "e");
+        Set<String> resident = Set.of("b", "d");
+        List<String> events = new CopyOnWriteArrayList<>();
+
+        List<String> out = ResidencyScheduler.invoke(pool, segments, resident::contains,
+                s -> events.add("prefetch " + s),
+                wave -> ForkJoinTask.adapt(() -> {
+                    events.add("scan " + wave);
+                    return wave;
+                }));
+
+        assertEquals(List.of("prefetch a", "prefetch c", "prefetch e"), events.subList(0, 3));
+        assertEquals(Set.of("scan [b, d]", "scan [a, c, e]"), Set.copyOf(events.subList(3, events.size())));
+        assertEquals(List.of("b", "d", "a", "c", "e"), out);
+    }
+
+    @Test
+    void testColdScanRunsAlongsideTheWarmOne() {
+        List<String> segments = List.of("a", "b");
+        CountDownLatch coldStarted = new CountDownLatch(1);
+
+        List<String> out = ResidencyScheduler.invoke(pool, segments, "a"::equals, s -> {},
+                wave -> ForkJoinTask.adapt(() -> {
+                    if (wave.contains("b")) {
+                        coldStarted.countDown();
+                    } else {
+                        assertTrue(coldStarted.await(10, TimeUnit.SECONDS),
+                                "the cold scan must not wait for the warm one to finish");
+                    }
+                    return wave;
+                }));
+
+        assertEquals(segments, out);
+    }
+
+    @Test
+    void testUniformResidencyScansOnce() {
+        List<String> segments = List.of("a", "b", "c");
+        List<List<String>> waves = new ArrayList<>();
+
+        ResidencyScheduler.<String, String>invoke(pool, segments, s -> true,
+                s -> fail("resident segments need no read-ahead"),
+                wave -> ForkJoinTask.adapt(() -> {
+                    waves.add(wave);
+                    return wave;
+                }));
+        List<String> prefetched = new ArrayList<>();
+        ResidencyScheduler.<String, String>invoke(pool, segments, s -> false, prefetched::add,
+                wave -> ForkJoinTask.adapt(() -> {
+                    waves.add(wave);
+                    return wave;
+                }));
+
+        assertEquals(List.of(segments, segments), waves);
+        assertEquals(segments, prefetched);
+    }
+
+    @Test
+    void testTopKIsIdenticalForEveryResidencyMix() {
+        Random rnd = new Random(69L);
+        List<Segment> segments = new ArrayList<>();
+        for (int s = 0; s < 6; s++) {
+            List<Double> scores = new ArrayList<>();
+            for (int i = 0; i < 40; i++) {
+                scores.add(Math.floor(rnd.nextDouble() * 50) / 50);
+            }
+            segments.add(new Segment("seg-" + s, scores));
+        }
+        List<Double> expected = topK(segments.stream().flatMap(s -> s.scores().stream()).toList(), 10);
+
+        for (int mask = 0; mask < 1 << segments.size(); mask++) {
+            final int residentMask = mask;
+            List<Double> hits = ResidencyScheduler.invoke(pool, segments,
+                    s -> (residentMask & 1 << segments.indexOf(s)) != 0,
+                    s -> {},
+                    wave -> ForkJoinTask.adapt(
+                            () -> topK(wave.stream().flatMap(s -> s.scores().stream()).toList(), 10)));
+            assertEquals(expected, topK(hits, 10), "residency mask " + Integer.toBinaryString(mask));
+        }
+    }
+
+    private static List<Double> topK(List<Double> scores, int k) {
+        return scores.stream().sorted(Comparator.reverseOrder()).limit(k).toList();
+    }
+}
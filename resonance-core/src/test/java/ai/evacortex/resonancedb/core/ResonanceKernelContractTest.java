@@ -11,11 +11,16 @@ package ai.evacortex.resonancedb.core;
 import ai.evacortex.resonancedb.core.engine.CompareOptions;
 import ai.evacortex.resonancedb.core.engine.JavaKernel;
 import ai.evacortex.resonancedb.core.engine.ResonanceKernel;
+import ai.evacortex.resonancedb.core.math.SignSketch;
 import ai.evacortex.resonancedb.core.storage.WavePattern;
 import ai.evacortex.resonancedb.core.storage.responce.ComparisonResult;
 import org.junit.jupiter.api.DisplayName;
 import org.junit.jupiter.api.Test;
 
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import java.nio.ByteOrder;
 import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.List;
@@ -256,6 +261,49 @@ abstract class ResonanceKernelContractTest {
                     "Mismatch at iter " + i);
         }
     }
+
+    @Test
+    void hammingMany_matches_pairwise_distance() {
+        int len = 200;
+        int count = 7;
+        int words = SignSketch.wordsFor(len);
+        long[] q = SignSketch.of(randomPattern(len, 300));
+        long[] all = new long[words * count];
+        for (int i = 0; i < count; i++) {
+            System.arraycopy(SignSketch.of(randomPattern(len, 400 + i)), 0, all, i * words, words);
+        }
+
+        int[] dist = kernel().hammingMany(q, all, words, count);
+        assertEquals(count, dist.length);
+        for (int i = 0; i < count; i++) {
+            assertEquals(SignSketch.hamming(q, 0, all, i * words, words), dist[i], "Mismatch at sketch " + i);
+        }
+    }
+
+    @Test
+    void hammingMany_reads_strided_little_endian_segment() {
+        int len = 200;
+        int count = 7;
+        int words = SignSketch.wordsFor(len);
+        int stride = words + 3;
+        long[] q = SignSketch.of(randomPattern(len, 300));
+        long[][] sketches = new long[count][];
+        try (Arena arena = Arena.ofConfined()) {
+            MemorySegment seg = arena.allocate(ValueLayout.JAVA_LONG, (long) stride * count);
+            ValueLayout.OfLong le = ValueLayout.JAVA_LONG.withOrder(ByteOrder.LITTLE_ENDIAN);
+            for (int i = 0; i < count; i++) {
+                sketches[i] = SignSketch.of(randomPattern(len, 400 + i));
+                MemorySegment.copy(sketches[i], 0, seg, le, (long) i * stride * Long.BYTES, words);
+                seg.setAtIndex(le, (long) i * stride + words, -1L);
+            }
+
+            int[] dist = kernel().hammingMany(q, seg, words, stride, count);
+            assertEquals(count, dist.length);
+            for (int i = 0; i < count; i++) {
+                assertEquals(SignSketch.hamming(q, 0, sketches[i], 0, words), dist[i], "Mismatch at sketch " + i);
+            }
+        }
+    }
 }
 
 @DisplayName("ResonanceKernel contract tests (JavaKernel)")
@@ -0,0 +1,67 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core;
+
+import ai.evacortex.resonancedb.core.sharding.PhaseShardSelector;
+import ai.evacortex.resonancedb.core.sharding.SegmentPhaseHistogram;
+import ai.evacortex.resonancedb.core.storage.WavePattern;
+import org.junit.jupiter.api.Test;
+
+import java.util.List;
+import java.util.Map;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+class SegmentPhaseHistogramTest {
+
+    @Test
+    void testWideSegmentWithoutNearbyRecordsIsNotSelected() {
+        SegmentPhaseHistogram near = new SegmentPhaseHistogram();
+        near.add(0.02, 64.0);
+        near.add(-0.03, 64.0);
+
+        SegmentPhaseHistogram wide = new SegmentPhaseHistogram();
+        wide.add(-1.5, 64.0);
+        wide.add(1.5, 64.0);
+        assertEquals(0.0, wide.meanPhase(), 1e-12, "wide segment is centred on the query phase");
+
+        SegmentPhaseHistogram far = new SegmentPhaseHistogram();
+        far.add(2.0, 64.0);
+
+        PhaseShardSelector selector = PhaseShardSelector.fromHistograms(
+                Map.of("near.segment", near, "wide.segment", wide, "far.segment", far), 0.1);
+
+        WavePattern query = WavePatternTestUtils.createConstantPattern(1.0, 0.0, 64);
+        assertEquals(List.of("near.segment"), selector.getRelevantShards(query, 0.1));
+
+        List<String> ranked = selector.getRelevantShards(query, Math.PI);
+        assertEquals(List.of("near.segment", "wide.segment", "far.segment"), ranked);
+    }
+
+    @Test
+    void testRemoveEmptiesHistogram() {
+        SegmentPhaseHistogram h = new SegmentPhaseHistogram();
+        h.add(0.5, Double.NaN);
+        h.remove(0.5);
+
+        assertEquals(0, h.total());
+        assertTrue(Double.isInfinite(h.minDistance(0.5)));
+        assertEquals(0.0, h.estimateBestScore(0.5, 1.0));
+    }
+
+    @Test
+    void testEnergyMismatchLowersEstimate() {
+        SegmentPhaseHistogram matched = new SegmentPhaseHistogram();
+        matched.add(0.0, 64.0);
+        SegmentPhaseHistogram weak = new SegmentPhaseHistogram();
+        weak.add(0.0, 1.0);
+
+        assertTrue(matched.estimateBestScore(0.0, 64.0) > weak.estimateBestScore(0.0, 64.0));
+    }
+}
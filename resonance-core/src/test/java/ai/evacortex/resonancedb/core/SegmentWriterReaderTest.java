@@ -12,13 +12,25 @@ import ai.evacortex.resonancedb.core.exceptions.IncompleteWriteException;
 import ai.evacortex.resonancedb.core.storage.WavePattern;
 import ai.evacortex.resonancedb.core.storage.io.format.BinaryHeader;
 import ai.evacortex.resonancedb.core.storage.util.HashingUtil;
+import ai.evacortex.resonancedb.core.exceptions.PatternNotFoundException;
+import ai.evacortex.resonancedb.core.storage.io.CachedReader;
+import ai.evacortex.resonancedb.core.storage.io.SegmentIdIndex;
 import ai.evacortex.resonancedb.core.storage.io.SegmentReader;
 import ai.evacortex.resonancedb.core.storage.io.SegmentWriter;
 import org.junit.jupiter.api.Test;
 import org.junit.jupiter.api.io.TempDir;
 
 import java.io.RandomAccessFile;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.file.Files;
 import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.Map;
+import java.util.OptionalInt;
+import java.util.concurrent.*;
 
 import static org.junit.jupiter.api.Assertions.*;
 
@@ -58,6 +70,47 @@ class SegmentWriterReaderTest {
         }
     }
 
+    @Test
+    void testParallelWritersAppendDisjointCommittedRecords() throws Exception {
+        Path segmentFile = tempDir.resolve("parallel.segment");
+        int threads = 4;
+        int perThread = 25;
+        Map<Long, String> written = new ConcurrentHashMap<>();
+
+        long committed;
+        ExecutorService pool = Executors.newFixedThreadPool(threads);
+        try (SegmentWriter writer = new SegmentWriter(segmentFile, 8)) {
+            List<Future<?>> futures = new ArrayList<>();
+            for (int t = 0; t < threads; t++) {
+                final int worker = t;
+                futures.add(pool.submit(() -> {
+                    for (int i = 0; i < perThread; i++) {
+                        String hexId = HashingUtil.md5Hex("w" + worker + "-" + i);
+                        long offset = writer.write(hexId, WavePatternTestUtils.createConstantPattern(worker + 1, i * 0.01, 256));
+                        assertTrue(writer.getWriteOffset() > offset, "write must return after its record is committed");
+                        written.put(offset, hexId);
+                    }
+                    return null;
+                }));
+            }
+            for (Future<?> f : futures) {
+                f.get(60, TimeUnit.SECONDS);
+            }
+            committed = writer.flush();
+        } finally {
+            pool.shutdownNow();
+        }
+
+        assertEquals(threads * perThread, written.size());
+        try (SegmentReader reader = new SegmentReader(segmentFile)) {
+            assertEquals(threads * perThread, reader.getHeader().recordCount());
+            assertEquals(committed, reader.getHeader().lastOffset());
+            for (Map.Entry<Long, String> e : written.entrySet()) {
+                assertEquals(e.getValue(), reader.readWithId(e.getKey()).id());
+            }
+        }
+    }
+
     @Test
     void testFailsOnUncommittedSegment() throws Exception {
         Path segmentFile = tempDir.resolve("uncommitted.segment");
@@ -87,4 +140,184 @@ class SegmentWriterReaderTest {
             }
         });
     }
-}
\ No newline at end of file
+
+    @Test
+    void testIdIndexSidecarMatchesSegmentScan() throws Exception {
+        Path segmentFile = tempDir.resolve("ids.segment");
+        List<String> ids = new ArrayList<>();
+        List<Long> offsets = new ArrayList<>();
+
+        try (SegmentWriter writer = new SegmentWriter(segmentFile)) {
+            for (int i = 0; i < 5; i++) {
+                WavePattern p = WavePatternTestUtils.createRandomPattern(32, 100L + i);
+                String id = HashingUtil.computeContentHash(p);
+                ids.add(id);
+                offsets.add(writer.write(id, p));
+            }
+            writer.markDeleted(offsets.get(2));
+            writer.flush();
+        }
+        assertTrue(Files.exists(SegmentIdIndex.pathFor(segmentFile)), "closing a writer must persist its id index");
+
+        List<String> expected = new ArrayList<>(ids);
+        expected.remove(2);
+        assertIndexedLookups(segmentFile, ids, offsets, expected);
+
+        Files.write(SegmentIdIndex.pathFor(segmentFile), new byte[]{1, 2, 3, 4});
+        assertIndexedLookups(segmentFile, ids, offsets, expected);
+
+        Files.delete(SegmentIdIndex.pathFor(segmentFile));
+        assertIndexedLookups(segmentFile, ids, offsets, expected);
+    }
+
+    @Test
+    void testSealWritesIdIndexOnceAndPatchesLaterDeletes() throws Exception {
+        Path segmentFile = tempDir.resolve("sealed.segment");
+        List<String> ids = new ArrayList<>();
+        List<Long> offsets = new ArrayList<>();
+
+        try (SegmentWriter writer = new SegmentWriter(segmentFile)) {
+            for (int i = 0; i < 4; i++) {
+                WavePattern p = WavePatternTestUtils.createRandomPattern(32, 200L + i);
+                String id = HashingUtil.computeContentHash(p);
+                ids.add(id);
+                offsets.add(writer.write(id, p));
+            }
+            writer.seal();
+            Path sidecar = SegmentIdIndex.pathFor(segmentFile);
+            byte[] sealedIndex = Files.readAllBytes(sidecar);
+
+            writer.markDeleted(offsets.get(1));
+            writer.flush();
+            byte[] patched = Files.readAllBytes(sidecar);
+            assertEquals(sealedIndex.length, patched.length,
+                    "a flushed delete must patch the id index, not rewrite it");
+            assertArrayEquals(Arrays.copyOfRange(sealedIndex, 40, 40 + 8 * ids.size()),
+                    Arrays.copyOfRange(patched, 40, 40 + 8 * ids.size()));
+            ByteBuffer segment = ByteBuffer.wrap(Files.readAllBytes(segmentFile)).order(ByteOrder.LITTLE_ENDIAN);
+            assertEquals(BinaryHeader.from(segment, 8).checksum(),
+                    ByteBuffer.wrap(patched).order(ByteOrder.LITTLE_ENDIAN).getLong(32),
+                    "the patched id index must stay valid against the new segment checksum");
+
+            List<String> expected = new ArrayList<>(ids);
+            expected.remove(1);
+            assertIndexedLookups(segmentFile, ids, offsets, expected);
+
+            writer.unmarkDeleted(offsets.get(1));
+            writer.flush();
+            assertIndexedLookups(segmentFile, ids, offsets, ids);
+        }
+    }
+
+    @Test
+    void testReopenedSegmentIsMappedOnlyOnceWritten() throws Exception {
+        Path segmentFile = tempDir.resolve("lazy.segment");
+        WavePattern first = WavePatternTestUtils.createRandomPattern(48, 7L);
+        try (SegmentWriter writer = new SegmentWriter(segmentFile)) {
+            writer.write(HashingUtil.computeContentHash(first), first);
+            writer.flush();
+        }
+
+        try (SegmentWriter writer = new SegmentWriter(segmentFile)) {
+            assertFalse(writer.isMapped(), "opening an existing segment must not map it writable");
+            assertEquals(OptionalInt.of(48), writer.firstRecordLength());
+
+            long end = writer.getWriteOffset();
+            WavePattern second = WavePatternTestUtils.createRandomPattern(48, 8L);
+            assertEquals(end, writer.write(HashingUtil.computeContentHash(second), second));
+            assertTrue(writer.isMapped());
+            writer.flush();
+        }
+
+        try (CachedReader reader = CachedReader.open(segmentFile)) {
+            assertEquals(2, reader.liveCount());
+        }
+    }
+
+    @Test
+    void testExtendedReaderCoversAppendedRecordsAndKeepsOlderVersionStable() throws Exception {
+        Path segmentFile = tempDir.resolve("extend.segment");
+        List<String> ids = new ArrayList<>();
+        List<Long> offsets = new ArrayList<>();
+
+        try (SegmentWriter writer = new SegmentWriter(segmentFile)) {
+            for (int i = 0; i < 3; i++) {
+                WavePattern p = WavePatternTestUtils.createRandomPattern(32, 300L + i);
+                ids.add(HashingUtil.computeContentHash(p));
+                offsets.add(writer.write(ids.getLast(), p));
+            }
+            long first = writer.flush();
+
+            try (CachedReader v1 = CachedReader.open(segmentFile)) {
+                v1.acquire();
+                for (int i = 3; i < 8; i++) {
+                    WavePattern p = WavePatternTestUtils.createRandomPattern(32, 300L + i);
+                    ids.add(HashingUtil.computeContentHash(p));
+                    offsets.add(writer.write(ids.getLast(), p));
+                }
+                writer.markDeleted(offsets.get(6));
+                long second = writer.flush();
+                assertTrue(second > first);
+
+                CachedReader v2 = v1.extend(second);
+                assertNotNull(v2, "an appended segment must extend without a reopen");
+                v1.close();
+                v1.release();
+                try (v2) {
+                    List<String> expected = new ArrayList<>(ids);
+                    expected.remove(6);
+                    assertEquals(expected.size(), v2.liveCount());
+                    for (int i = 0; i < expected.size(); i++) {
+                        assertEquals(expected.get(i), v2.idAt(i));
+                    }
+                    assertEquals(offsets.get(5).longValue(), v2.offsetOf(ids.get(5)));
+                    assertFalse(v2.contains(ids.get(6)));
+                    assertNotNull(v2.summary());
+                    assertEquals(expected.size(), v2.summary().count());
+                    assertEquals(ids.size(), v2.summary().recordCount());
+
+                    try (CachedReader reopened = CachedReader.open(segmentFile)) {
+                        assertEquals(reopened.liveCount(), v2.liveCount());
+                        for (int i = 0; i < v2.liveCount(); i++) {
+                            assertEquals(reopened.offsetAt(i), v2.offsetAt(i));
+                            assertEquals(reopened.summary().energy(i), v2.summary().energy(i));
+                        }
+                    }
+
+                    WavePattern p = WavePatternTestUtils.createRandomPattern(32, 399L);
+                    String lastId = HashingUtil.computeContentHash(p);
+                    writer.write(lastId, p);
+                    long third = writer.flush();
+                    try (CachedReader v3 = v2.extend(third)) {
+                        assertNotNull(v3);
+                        assertTrue(v3.contains(lastId));
+                        assertFalse(v2.contains(lastId), "an older version must not see later records");
+                        assertEquals(expected.size(), v2.liveCount());
+                        assertNull(v2.extend(third), "v2 was already extended past");
+                    }
+                }
+            }
+        }
+    }
+
+    private static void assertIndexedLookups(Path segmentFile, List<String> ids, List<Long> offsets,
+                                             List<String> expected) throws Exception {
+        try (CachedReader reader = CachedReader.open(segmentFile)) {
+            assertEquals(expected.size(), reader.liveCount());
+            for (int i = 0; i < expected.size(); i++) {
+                assertEquals(expected.get(i), reader.idAt(i));
+            }
+            for (int i = 0; i < ids.size(); i++) {
+                if (!expected.contains(ids.get(i))) {
+                    assertFalse(reader.contains(ids.get(i)));
+                    String deleted = ids.get(i);
+                    assertThrows(PatternNotFoundException.class, () -> reader.offsetOf(deleted));
+                } else {
+                    assertTrue(reader.contains(ids.get(i)));
+                    assertEquals(offsets.get(i).longValue(), reader.offsetOf(ids.get(i)));
+                }
+            }
+            assertFalse(reader.contains("00000000000000000000000000000000"));
+        }
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core;
+
+import ai.evacortex.resonancedb.core.math.SignSketch;
+import ai.evacortex.resonancedb.core.storage.WavePattern;
+import ai.evacortex.resonancedb.core.storage.io.CachedReader;
+import ai.evacortex.resonancedb.core.storage.io.SegmentSummary;
+import ai.evacortex.resonancedb.core.storage.io.SegmentWriter;
+import ai.evacortex.resonancedb.core.storage.util.HashingUtil;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.nio.file.Path;
+import java.util.Arrays;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+class SignSketchTest {
+
+    @TempDir
+    Path tempDir;
+
+    @Test
+    void testIdenticalPatternsHaveZeroDistance() {
+        WavePattern p = WavePatternTestUtils.createRandomPattern(256, 7L);
+        long[] a = SignSketch.of(p);
+        long[] b = SignSketch.of(new WavePattern(p.amplitude().clone(), p.phase().clone()));
+
+        assertEquals(SignSketch.wordsFor(256), a.length);
+        assertEquals(0, SignSketch.hamming(a, 0, b, 0, a.length));
+    }
+
+    @Test
+    void testOppositePhaseFlipsEveryBit() {
+        int len = 100;
+        WavePattern p = WavePatternTestUtils.createRandomPattern(len, 11L);
+        double[] shifted = Arrays.stream(p.phase()).map(x -> x + Math.PI).toArray();
+        WavePattern q = new WavePattern(p.amplitude(), shifted);
+
+        long[] a = SignSketch.of(p);
+        long[] b = SignSketch.of(q);
+        assertEquals(2 * len, SignSketch.hamming(a, 0, b, 0, a.length));
+    }
+
+    @Test
+    void testHammingManyMatchesPairwise() {
+        int len = 96;
+        int count = 5;
+        int words = SignSketch.wordsFor(len);
+        WavePattern query = WavePatternTestUtils.createRandomPattern(len, 1L);
+        long[] q = SignSketch.of(query);
+
+        long[] all = new long[words * count];
+        for (int i = 0; i < count; i++) {
+            long[] s = SignSketch.of(WavePatternTestUtils.createRandomPattern(len, 100L + i));
+            System.arraycopy(s, 0, all, i * words, words);
+        }
+
+        int[] dist = SignSketch.hammingMany(q, all, words, count);
+        for (int i = 0; i < count; i++) {
+            assertEquals(SignSketch.hamming(q, 0, all, i * words, words), dist[i]);
+        }
+    }
+
+    @Test
+    void testSegmentSummarySidecarFollowsLiveRecords() throws Exception {
+        Path segment = tempDir.resolve("sketch.segment");
+        WavePattern p1 = WavePatternTestUtils.createRandomPattern(64, 21L);
+        WavePattern p2 = WavePatternTestUtils.createRandomPattern(64, 22L);
+        WavePattern p3 = WavePatternTestUtils.createRandomPattern(64, 23L);
+
+        try (SegmentWriter writer = new SegmentWriter(segment)) {
+            writer.write(HashingUtil.computeContentHash(p1), p1);
+            long off2 = writer.write(HashingUtil.computeContentHash(p2), p2);
+            writer.write(HashingUtil.computeContentHash(p3), p3);
+            writer.markDeleted(off2);
+            writer.flush();
+            writer.sync();
+        }
+
+        try (CachedReader reader = CachedReader.open(segment)) {
+            assertEquals(2, reader.liveCount());
+            SegmentSummary summary = reader.summary();
+            assertNotNull(summary, "summary sidecar must be loaded");
+            assertEquals(2, summary.count());
+
+            int words = summary.words();
+            long[] first = new long[words];
+            long[] second = new long[words];
+            summary.copySketch(0, first, 0);
+            summary.copySketch(1, second, 0);
+            assertArrayEquals(SignSketch.of(p1), first);
+            assertArrayEquals(SignSketch.of(p3), second);
+            assertEquals(HashingUtil.computeContentHash(p3), reader.idAt(1));
+
+            double e3 = Arrays.stream(p3.amplitude()).map(a -> a * a).sum();
+            assertEquals(e3, summary.energy(1), 1e-9);
+            assertTrue(summary.prefixEnergy(1) <= summary.energy(1));
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.core;
+
+import ai.evacortex.resonancedb.core.storage.util.SingleFlight;
+import org.junit.jupiter.api.Test;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.*;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+class SingleFlightTest {
+
+    @Test
+    void testConcurrentCallsShareOneComputation() throws Exception {
+        SingleFlight<String, Integer> flights = new SingleFlight<>();
+        AtomicInteger computed = new AtomicInteger();
+        CountDownLatch started = new CountDownLatch(1);
+        CountDownLatch release = new CountDownLatch(1);
+
+        List<Integer> results = new CopyOnWriteArrayList<>();
+        Thread leader = Thread.ofPlatform().start(() -> results.add(flights.execute("q", () -> {
+            started.countDown();
+            awaitQuietly(release);
+            return computed.incrementAndGet();
+        }, () -> false)));
+        assertTrue(started.await(10, TimeUnit.SECONDS));
+
+        List<Thread> followers = new ArrayList<>();
+        for (int i = 0; i < 3; i++) {
+            followers.add(Thread.ofPlatform().start(
+                    () -> results.add(flights.execute("q", computed::incrementAndGet, () -> false))));
+        }
+        for (Thread follower : followers) {
+            awaitParked(follower);
+        }
+        release.countDown();
+
+        leader.join(10_000);
+        for (Thread follower : followers) {
+            follower.join(10_000);
+        }
+        assertEquals(List.of(1, 1, 1, 1), results);
+        assertEquals(1, computed.get());
+        assertEquals(3, flights.shared());
+
+        assertEquals(2, flights.execute("q", computed::incrementAndGet, () -> false),
+                "a finished flight must not be served to later calls");
+    }
+
+    @Test
+    void testAbandonedLeaderIsNotShared() throws Exception {
+        SingleFlight<String, Integer> flights = new SingleFlight<>();
+        AtomicInteger computed = new AtomicInteger();
+        CountDownLatch started = new CountDownLatch(1);
+        CountDownLatch release = new CountDownLatch(1);
+
+        Thread leader = Thread.ofPlatform().start(() -> flights.execute("q", () -> {
+            started.countDown();
+            awaitQuietly(release);
+            return -computed.incrementAndGet();
+        }, () -> true));
+        assertTrue(started.await(10, TimeUnit.SECONDS));
+
+        CompletableFuture<Integer> follower = new CompletableFuture<>();
+        Thread waiter = Thread.ofPlatform().start(
+                () -> follower.complete(flights.execute("q", computed::incrementAndGet, () -> false)));
+        awaitParked(waiter);
+        release.countDown();
+
+        leader.join(10_000);
+        assertEquals(2, follower.get(10, TimeUnit.SECONDS));
+        assertEquals(0, flights.shared());
+    }
+
+    private static void awaitParked(Thread thread) throws InterruptedException {
+        long deadline = System.nanoTime() + TimeUnit.SECONDS.toNanos(10);
+        while (thread.getState() != Thread.State.WAITING && thread.getState() != Thread.State.TIMED_WAITING) {
+            assertTrue(System.nanoTime() < deadline, "thread did not attach to the flight");
+            Thread.sleep(1);
+        }
+    }
+
+    private static void awaitQuietly(CountDownLatch latch) {
+        try {
+            latch.await(10, TimeUnit.SECONDS);
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+        }
+    }
+}
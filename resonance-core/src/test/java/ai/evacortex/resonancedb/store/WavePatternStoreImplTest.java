@@ -9,6 +9,7 @@
 package ai.evacortex.resonancedb.store;
 
 import ai.evacortex.resonancedb.core.*;
+import ai.evacortex.resonancedb.core.engine.QueryOptions;
 import ai.evacortex.resonancedb.core.exceptions.DuplicatePatternException;
 import ai.evacortex.resonancedb.core.exceptions.InvalidWavePatternException;
 import ai.evacortex.resonancedb.core.exceptions.PatternNotFoundException;
@@ -26,6 +27,8 @@ import java.io.IOException;
 import java.nio.file.Files;
 import java.nio.file.Path;
 import java.util.*;
+import java.util.concurrent.*;
+import java.util.concurrent.atomic.AtomicReference;
 import java.util.stream.Collectors;
 import java.util.stream.Stream;
 
@@ -324,6 +327,542 @@ public class WavePatternStoreImplTest {
         assertEquals(1.0f, hits.getFirst().energy(), 1e-5, "self-match energy should be 1");
     }
 
+    @Test
+    void testBoundedScanModesMatchFullScan() {
+        Random rnd = new Random(52L);
+        int n = len();
+        List<WavePattern> patterns = new ArrayList<>();
+        for (int i = 0; i < 80; i++) {
+            double[] a = new double[n];
+            double[] p = new double[n];
+            for (int k = 0; k < n; k++) {
+                a[k] = (0.2 + rnd.nextDouble()) / (1.0 + k / 16.0);
+                p[k] = rnd.nextDouble() * 2 * Math.PI;
+            }
+            WavePattern psi = new WavePattern(a, p);
+            patterns.add(psi);
+            store.insert(psi, Map.of());
+        }
+
+        QueryOptions full = QueryOptions.defaultOptions().withScanMode(QueryOptions.ScanMode.FULL);
+        List<QueryOptions.ScanMode> modes = List.of(
+                QueryOptions.ScanMode.SPECTRAL_PREFIX, QueryOptions.ScanMode.AMPLITUDE_CASCADE);
+
+        for (WavePattern query : List.of(patterns.get(7), patterns.get(41), randomPattern(0.1, 1.0, 0.0, 1.0, rnd))) {
+            List<ResonanceMatch> expected = store.query(query, 5, full);
+            for (QueryOptions.ScanMode mode : modes) {
+                List<ResonanceMatch> actual = store.query(query, 5, full.withScanMode(mode));
+
+                assertEquals(expected.stream().map(ResonanceMatch::id).toList(),
+                        actual.stream().map(ResonanceMatch::id).toList(),
+                        mode + " scan must return the same top-K as the full scan");
+                for (int i = 0; i < expected.size(); i++) {
+                    assertEquals(expected.get(i).energy(), actual.get(i).energy(), 1e-6);
+                }
+            }
+        }
+    }
+
+    @Test
+    void testQueryOptionsCapsAndExactMode() {
+        for (int i = 0; i < 40; i++) {
+            store.insert(constant(1.0 + i * 0.01, -3.0 + i * 0.15), Map.of());
+        }
+        WavePattern query = constant(1.0, 0.3);
+        QueryOptions full = QueryOptions.defaultOptions().withScanMode(QueryOptions.ScanMode.FULL);
+
+        QueryResult<ResonanceMatch> exact = store.queryResult(query, 3, full.withExact(true).withMaxCandidates(2));
+        assertEquals(3, exact.matches().size());
+        assertEquals(40, exact.candidatesScored(), "exact mode ignores the candidate cap");
+        assertEquals(0, exact.options().maxCandidates());
+        assertEquals(Math.PI, exact.options().phaseEpsilon(), 1e-12);
+        assertTrue(exact.options().overfetch() > 0, "adaptive overfetch must be resolved");
+        assertFalse(exact.partial());
+
+        QueryResult<ResonanceMatch> withDeadline = store.queryResult(query, 3, full.withExact(true).withTimeoutMillis(60_000));
+        assertFalse(withDeadline.partial(), "a generous deadline must not cut the scan short");
+        assertEquals(exact.matches().stream().map(ResonanceMatch::id).toList(),
+                withDeadline.matches().stream().map(ResonanceMatch::id).toList());
+
+        QueryResult<ResonanceMatch> capped = store.queryResult(query, 3, full.withMaxCandidates(5));
+        assertTrue(capped.candidatesScored() <= 5);
+        assertFalse(capped.matches().isEmpty());
+
+        QueryResult<ResonanceMatch> oneSegment = store.queryResult(query, 3, full.withMaxSegments(1));
+        assertEquals(1, oneSegment.segmentsScanned());
+        assertEquals(1, oneSegment.options().maxSegments());
+
+        QueryResult<ResonanceMatchDetailed> detailed = store.queryDetailedResult(query, 3, full.withExact(true));
+        assertEquals(3, detailed.matches().size());
+        assertEquals(40, detailed.candidatesScored());
+        assertFalse(detailed.options().sketchPrefilter());
+
+        QueryResult<ResonanceMatchDetailed> detailedCapped = store.queryDetailedResult(query, 3, full.withMaxCandidates(5));
+        assertTrue(detailedCapped.candidatesScored() <= 5);
+        assertFalse(detailedCapped.matches().isEmpty());
+    }
+
+    @Test
+    void testExpiredDeadlineReturnsSortedPartialResult() {
+        Random rnd = new Random(57L);
+        QueryOptions hurried = QueryOptions.defaultOptions()
+                .withScanMode(QueryOptions.ScanMode.FULL)
+                .withSketchPrefilter(false)
+                .withTimeoutMillis(1);
+        WavePattern query = randomPattern(0.2, 1.0, -Math.PI, Math.PI, rnd);
+
+        int corpus = 0;
+        QueryResult<ResonanceMatch> result = null;
+        while (corpus < 8_000 && (result == null || !result.partial())) {
+            for (int i = 0; i < 1_000; i++) {
+                store.insert(randomPattern(0.2, 1.0, -Math.PI, Math.PI, rnd), Map.of());
+            }
+            corpus += 1_000;
+            result = store.queryResult(query, 10, hurried);
+        }
+
+        assertTrue(result.partial(), "a 1 ms deadline must expire over " + corpus + " patterns");
+        assertTrue(result.candidatesScored() < corpus,
+                "scored " + result.candidatesScored() + " of " + corpus + " after the deadline");
+        assertTrue(result.segmentsScanned() > 0 || result.matches().isEmpty());
+        List<ResonanceMatch> matches = result.matches();
+        for (int i = 1; i < matches.size(); i++) {
+            assertTrue(matches.get(i - 1).energy() >= matches.get(i).energy(), "partial matches must stay ranked");
+        }
+    }
+
+    @Test
+    void testQueryBatchMatchesIndividualQueries() {
+        Random rnd = new Random(58L);
+        for (int i = 0; i < 60; i++) {
+            store.insert(randomPattern(0.2, 1.0, -Math.PI, Math.PI, rnd), Map.of());
+        }
+        List<WavePattern> queries = List.of(
+                constant(1.0, 0.2),
+                constant(0.5, -2.0),
+                randomPattern(0.2, 1.0, -Math.PI, Math.PI, rnd));
+        QueryOptions full = QueryOptions.defaultOptions()
+                .withScanMode(QueryOptions.ScanMode.FULL)
+                .withSketchPrefilter(false)
+                .withMaxCandidates(0);
+
+        List<List<ResonanceMatch>> batch = store.queryBatch(queries, 4);
+        assertEquals(queries.size(), batch.size());
+        for (int i = 0; i < queries.size(); i++) {
+            List<ResonanceMatch> single = store.query(queries.get(i), 4, full);
+            assertEquals(single.stream().map(ResonanceMatch::id).toList(),
+                    batch.get(i).stream().map(ResonanceMatch::id).toList());
+            batch.get(i).forEach(m -> assertNotNull(m.pattern()));
+        }
+        assertTrue(store.queryBatch(List.of(), 4).isEmpty());
+    }
+
+    @Test
+    void testSegmentSplitIntoMorselsMatchesSequentialScan() throws IOException {
+        int count = 300;
+        List<String> ids = new ArrayList<>();
+        for (int i = 0; i < count; i++) {
+            double[] a = new double[len()];
+            Arrays.fill(a, 1.0);
+            a[i % len()] = 0.5;
+            a[(i * 7 + 3) % len()] = 0.25 * (1 + i % 3);
+            ids.add(store.insert(new WavePattern(a, new double[len()]), Map.of()));
+        }
+        try (Stream<Path> files = Files.list(tempDir.resolve("segments"))) {
+            assertEquals(1, files.filter(f -> f.toString().endsWith(".segment")).count(),
+                    "all records must share one segment to exercise morsels");
+        }
+
+        WavePattern query = constant(1.0, 0.0);
+        Map<String, Float> energies = new HashMap<>();
+        for (String id : ids) {
+            energies.put(id, store.compare(query, store.getPattern(id)));
+        }
+        List<String> sequential = ids.stream()
+                .sorted(Comparator.comparing((String id) -> energies.get(id), Comparator.reverseOrder())
+                        .thenComparing(Comparator.naturalOrder()))
+                .limit(7)
+                .toList();
+        QueryOptions exact = QueryOptions.defaultOptions()
+                .withScanMode(QueryOptions.ScanMode.FULL)
+                .withExact(true);
+
+        QueryResult<ResonanceMatch> result = store.queryResult(query, 7, exact);
+        assertEquals(sequential, result.matches().stream().map(ResonanceMatch::id).toList());
+        assertEquals(count, result.candidatesScored(), "each record must be scored by exactly one morsel");
+        assertEquals(1, result.segmentsScanned());
+
+        QueryResult<ResonanceMatchDetailed> detailed = store.queryDetailedResult(query, 7, exact);
+        assertEquals(sequential, detailed.matches().stream().map(ResonanceMatchDetailed::id).toList());
+        assertEquals(count, detailed.candidatesScored());
+
+        assertEquals(sequential, store.queryBatch(List.of(query), 7).getFirst().stream().map(ResonanceMatch::id).toList());
+    }
+
+    @Test
+    void testTiedScoresBreakOnIdAcrossScanPaths() {
+        List<String> tied = new ArrayList<>();
+        for (int i = 0; i < 12; i++) {
+            double[] a = new double[len()];
+            Arrays.fill(a, 1.0);
+            a[i] = 0.5;
+            tied.add(store.insert(new WavePattern(a, new double[len()]), Map.of()));
+        }
+        for (int i = 0; i < 4; i++) {
+            store.insert(constant(0.3 + 0.1 * i, 1.0), Map.of());
+        }
+        WavePattern query = constant(1.0, 0.0);
+        List<String> expected = tied.stream().sorted().limit(3).toList();
+        QueryOptions full = QueryOptions.defaultOptions()
+                .withScanMode(QueryOptions.ScanMode.FULL)
+                .withSketchPrefilter(false);
+
+        assertEquals(expected, store.query(query, 3, full).stream().map(ResonanceMatch::id).toList());
+        assertEquals(expected, store.queryBatch(List.of(query), 3).getFirst().stream().map(ResonanceMatch::id).toList());
+        assertEquals(expected, store.queryDetailed(query, 3, full).stream().map(ResonanceMatchDetailed::id).toList());
+    }
+
+    @Test
+    void testTwoPhaseDetailedMatchesFullRefinement() {
+        Random rnd = new Random(60L);
+        for (int i = 0; i < 80; i++) {
+            store.insert(randomPattern(0.2, 1.0, -1.0, 1.0, rnd), Map.of());
+        }
+        WavePattern query = randomPattern(0.2, 1.0, -1.0, 1.0, rnd);
+        QueryOptions full = QueryOptions.defaultOptions().withScanMode(QueryOptions.ScanMode.FULL);
+
+        List<ResonanceMatchDetailed> reference = store.queryDetailed(query, 5, full.withOverfetch(100));
+        List<ResonanceMatchDetailed> exact = store.queryDetailed(query, 5, full.withExact(true));
+        assertEquals(reference.stream().map(ResonanceMatchDetailed::id).toList(),
+                exact.stream().map(ResonanceMatchDetailed::id).toList());
+
+        QueryResult<ResonanceMatchDetailed> fast = store.queryDetailedResult(query, 5, full.withOverfetch(2));
+        assertEquals(5, fast.matches().size());
+        assertEquals(80, fast.candidatesScored(), "phase delta must not add a second scan");
+        for (ResonanceMatchDetailed m : fast.matches()) {
+            assertNotNull(m.pattern());
+            assertNotNull(m.zone());
+        }
+    }
+
+    @Test
+    void testParallelInsertsIntoSeparatePhaseGroupsAreDurable() throws Exception {
+        int threads = 4;
+        int perThread = 12;
+        ExecutorService pool = Executors.newFixedThreadPool(threads);
+        List<Future<List<String>>> futures = new ArrayList<>();
+        try {
+            for (int t = 0; t < threads; t++) {
+                final int worker = t;
+                double center = -Math.PI + (worker + 0.5) * (2 * Math.PI / threads);
+                futures.add(pool.submit(() -> {
+                    Random rnd = new Random(650L + worker);
+                    List<String> ids = new ArrayList<>();
+                    for (int i = 0; i < perThread; i++) {
+                        WavePattern p = randomPattern(0.2, 1.0, center - 0.05, center + 0.05, rnd);
+                        ids.add(store.insert(p, Map.of("worker", String.valueOf(worker))));
+                    }
+                    return ids;
+                }));
+            }
+            Map<String, Integer> inserted = new HashMap<>();
+            for (int t = 0; t < threads; t++) {
+                for (String id : futures.get(t).get(60, TimeUnit.SECONDS)) {
+                    inserted.put(id, t);
+                }
+            }
+            assertEquals(threads * perThread, inserted.size());
+
+            store.close();
+            store = new WavePatternStoreImpl(tempDir, len(), StoreRuntimeServices.fromSystemProperties());
+            for (Map.Entry<String, Integer> e : inserted.entrySet()) {
+                assertNotNull(store.getPattern(e.getKey()));
+                assertEquals(String.valueOf(e.getValue()), store.getMetadata(e.getKey()).get("worker"));
+            }
+        } finally {
+            pool.shutdownNow();
+        }
+    }
+
+    @Test
+    void testInsertThroughputScalesWithPhaseGroups() throws Exception {
+        int groups = 4;
+        Assumptions.assumeTrue(Runtime.getRuntime().availableProcessors() >= groups,
+                "needs a core per concurrent phase group");
+        int perWriter = 40;
+
+        double single = insertRate(Files.createDirectories(tempDir.resolve("one-group")), 1, perWriter);
+        double parallel = insertRate(Files.createDirectories(tempDir.resolve("four-groups")), groups, perWriter);
+
+        assertTrue(parallel >= 1.5 * single, String.format(
+                "%d writers into %d phase groups insert %.1f/s, one writer into one group %.1f/s",
+                groups, groups, parallel, single));
+    }
+
+    /**
+     * Times {@code perWriter} inserts from each of {@code writers} threads, writer {@code w} into its own
+     * phase group, on a fresh store; returns inserts per second.
+     */
+    private static double insertRate(Path dir, int writers, int perWriter) throws Exception {
+        List<List<WavePattern>> batches = new ArrayList<>();
+        for (int w = 0; w < writers; w++) {
+            double center = -Math.PI + (w + 0.5) * (2 * Math.PI / 4);
+            Random rnd = new Random(6500L + w);
+            List<WavePattern> batch = new ArrayList<>();
+            for (int i = 0; i <= perWriter; i++) {
+                batch.add(randomPattern(0.2, 1.0, center - 0.05, center + 0.05, rnd));
+            }
+            batches.add(batch);
+        }
+
+        ExecutorService pool = Executors.newFixedThreadPool(writers);
+        try (WavePatternStoreImpl target = newStore(dir)) {
+            // The first insert of each group creates its segment; keep that out of the timing.
+            batches.forEach(batch -> target.insert(batch.getFirst(), Map.of()));
+
+            CountDownLatch start = new CountDownLatch(1);
+            List<Future<?>> futures = new ArrayList<>();
+            for (List<WavePattern> batch : batches) {
+                futures.add(pool.submit(() -> {
+                    start.await();
+                    batch.subList(1, batch.size()).forEach(p -> target.insert(p, Map.of()));
+                    return null;
+                }));
+            }
+            long t0 = System.nanoTime();
+            start.countDown();
+            for (Future<?> f : futures) {
+                f.get(120, TimeUnit.SECONDS);
+            }
+            double seconds = (System.nanoTime() - t0) / 1e9;
+            return writers * perWriter / seconds;
+        } finally {
+            pool.shutdownNow();
+        }
+    }
+
+    @Test
+    void testRebalanceKeepsWritesMadeWhileRecordsAreCopied() throws Exception {
+        Random rnd = new Random(5400L);
+        List<String> kept = new ArrayList<>();
+        List<String> doomed = new ArrayList<>();
+        for (int i = 0; i < 60; i++) {
+            double center = -Math.PI + 0.3 + rnd.nextDouble() * (2 * Math.PI - 0.6);
+            String id = store.insert(randomPattern(0.2, 1.0, center - 0.05, center + 0.05, rnd), Map.of());
+            (i % 3 == 0 ? doomed : kept).add(id);
+        }
+
+        ExecutorService pool = Executors.newSingleThreadExecutor();
+        try {
+            Future<List<String>> writes = pool.submit(() -> {
+                Random wr = new Random(5401L);
+                List<String> ids = new ArrayList<>();
+                for (int i = 0; i < 30; i++) {
+                    double center = -Math.PI + 0.3 + wr.nextDouble() * (2 * Math.PI - 0.6);
+                    ids.add(store.insert(randomPattern(0.2, 1.0, center - 0.05, center + 0.05, wr), Map.of()));
+                }
+                doomed.forEach(store::delete);
+                return ids;
+            });
+            // Few records per range: the first pass merges the ranges while the writer runs.
+            assertTrue(store.rebalanceBuckets());
+            kept.addAll(writes.get(60, TimeUnit.SECONDS));
+        } finally {
+            pool.shutdownNow();
+        }
+        store.rebalanceBuckets();
+
+        for (int pass = 0; pass < 2; pass++) {
+            for (String id : kept) {
+                WavePattern p = store.getPattern(id);
+                assertEquals(id, store.query(p, 1).getFirst().id());
+            }
+            for (String id : doomed) {
+                assertThrows(PatternNotFoundException.class, () -> store.getPattern(id));
+            }
+            store.close();
+            store = new WavePatternStoreImpl(tempDir, len(), StoreRuntimeServices.fromSystemProperties());
+        }
+    }
+
+    @Test
+    void testQueriesReadPinnedSnapshotsWhileWriting() throws InterruptedException {
+        Random rnd = new Random(64L);
+        for (int i = 0; i < 20; i++) {
+            store.insert(randomPattern(0.2, 1.0, -Math.PI, Math.PI, rnd), Map.of());
+        }
+        List<WavePattern> pending = new ArrayList<>();
+        for (int i = 0; i < 40; i++) {
+            pending.add(randomPattern(0.2, 1.0, -Math.PI, Math.PI, rnd));
+        }
+        WavePattern query = randomPattern(0.2, 1.0, -Math.PI, Math.PI, rnd);
+        QueryOptions exact = QueryOptions.defaultOptions().withExact(true);
+
+        AtomicReference<Throwable> failure = new AtomicReference<>();
+        Thread writer = new Thread(() -> {
+            try {
+                pending.forEach(p -> store.insert(p, Map.of()));
+            } catch (Throwable t) {
+                failure.set(t);
+            }
+        });
+        writer.start();
+        int rounds = 0;
+        do {
+            QueryResult<ResonanceMatch> result = store.queryResult(query, 10, exact);
+            assertEquals(10, result.matches().size(), "every pinned segment must be readable");
+            result.matches().forEach(m -> assertNotNull(m.pattern(), "matches must materialize from the snapshot"));
+            rounds++;
+        } while (writer.isAlive() || rounds < 2);
+        writer.join();
+
+        assertNull(failure.get());
+        assertEquals(60, store.query(query, 100, exact).size());
+    }
+
+    @Test
+    void testCursorPagesMatchOneDeepQuery() {
+        Random rnd = new Random(63L);
+        for (int i = 0; i < 40; i++) {
+            store.insert(randomPattern(0.2, 1.0, -Math.PI, Math.PI, rnd), Map.of());
+        }
+        WavePattern query = randomPattern(0.2, 1.0, -Math.PI, Math.PI, rnd);
+        QueryOptions exact = QueryOptions.defaultOptions().withExact(true);
+
+        List<String> deep = store.query(query, 40, exact).stream().map(ResonanceMatch::id).toList();
+
+        List<String> paged = new ArrayList<>();
+        String cursor = null;
+        int pages = 0;
+        do {
+            QueryPage<ResonanceMatch> page = store.queryPage(query, 3, cursor, exact);
+            page.matches().forEach(m -> paged.add(m.id()));
+            cursor = page.nextCursor();
+            assertTrue(++pages <= 14, "pagination must terminate");
+        } while (cursor != null);
+        assertEquals(deep, paged);
+
+        QueryPage<ResonanceMatch> first = store.queryPage(query, 5, null, exact);
+        store.insert(randomPattern(0.2, 1.0, -Math.PI, Math.PI, rnd), Map.of());
+        QueryPage<ResonanceMatch> second = store.queryPage(query, 5, first.nextCursor(), exact);
+        assertTrue(second.corpusVersion() > first.corpusVersion());
+        Set<String> firstIds = first.matches().stream().map(ResonanceMatch::id).collect(Collectors.toSet());
+        second.matches().forEach(m -> assertFalse(firstIds.contains(m.id()), "pages must not overlap"));
+
+        assertThrows(IllegalArgumentException.class,
+                () -> store.queryPage(constant(1.0, 0.0), 5, first.nextCursor(), exact));
+        assertThrows(IllegalArgumentException.class, () -> store.queryPage(query, 5, "not-a-cursor", exact));
+    }
+
+    @Test
+    void testQueryThresholdStreamsEveryMatchAboveFloor() {
+        Random rnd = new Random(62L);
+        List<WavePattern> inserted = new ArrayList<>();
+        for (int i = 0; i < 60; i++) {
+            WavePattern p = randomPattern(0.2, 1.0, -1.5, 1.5, rnd);
+            store.insert(p, Map.of());
+            inserted.add(p);
+        }
+        WavePattern query = inserted.get(7);
+        float floor = 0.55f;
+
+        Set<String> above = new HashSet<>();
+        Set<String> borderline = new HashSet<>();
+        for (WavePattern p : inserted) {
+            float e = store.compare(query, p);
+            String id = HashingUtil.computeContentHash(p);
+            if (e >= floor + 1e-4f) {
+                above.add(id);
+            } else if (e > floor - 1e-4f) {
+                borderline.add(id);
+            }
+        }
+
+        for (QueryOptions.ScanMode mode : QueryOptions.ScanMode.values()) {
+            List<ResonanceMatch> streamed = Collections.synchronizedList(new ArrayList<>());
+            QueryOptions options = QueryOptions.defaultOptions()
+                    .withScanMode(mode)
+                    .withProjection(QueryOptions.Projection.IDS_SCORES);
+            ThresholdResult summary = store.queryThreshold(query, floor, options, streamed::add);
+
+            Set<String> ids = streamed.stream().map(ResonanceMatch::id).collect(Collectors.toSet());
+            assertEquals(streamed.size(), ids.size(), "each match must be emitted once in " + mode);
+            assertTrue(ids.containsAll(above), "missing matches above the floor in " + mode);
+            ids.removeAll(above);
+            assertTrue(borderline.containsAll(ids), "matches below the floor emitted in " + mode);
+            assertEquals(streamed.size(), summary.emitted());
+            assertFalse(summary.partial());
+            streamed.forEach(m -> assertNull(m.pattern()));
+        }
+
+        List<ResonanceMatch> none = new ArrayList<>();
+        ThresholdResult empty = store.queryThreshold(query, 1.5f, QueryOptions.defaultOptions(), none::add);
+        assertTrue(none.isEmpty());
+        assertEquals(0, empty.emitted());
+    }
+
+    @Test
+    void testQueryProjectionAndLazyPatternFetch() {
+        WavePattern a = constant(1.0, 0.2);
+        WavePattern b = constant(0.8, 0.5);
+        String idA = store.insert(a, Map.of("label", "a"));
+        store.insert(b, Map.of("label", "b"));
+        QueryOptions options = QueryOptions.defaultOptions();
+
+        List<ResonanceMatch> scores = store.query(a, 2, options.withProjection(QueryOptions.Projection.IDS_SCORES));
+        assertEquals(idA, scores.getFirst().id());
+        scores.forEach(m -> {
+            assertNull(m.pattern());
+            assertNull(m.metadata());
+        });
+
+        List<ResonanceMatch> withMeta = store.query(a, 2, options.withProjection(QueryOptions.Projection.parse("ids+scores+metadata")));
+        assertEquals(Map.of("label", "a"), withMeta.getFirst().metadata());
+        assertNull(withMeta.getFirst().pattern());
+
+        List<ResonanceMatchDetailed> detailed = store.queryDetailed(a, 2, options.withProjection(QueryOptions.Projection.IDS));
+        assertEquals(idA, detailed.getFirst().id());
+        assertNull(detailed.getFirst().pattern());
+        assertNotNull(detailed.getFirst().zone());
+
+        assertNotNull(store.query(a, 1).getFirst().pattern(), "default projection keeps full payloads");
+        assertSamePattern(a, store.getPattern(idA));
+        assertEquals(Map.of("label", "a"), store.getMetadata(idA));
+        assertThrows(PatternNotFoundException.class,
+                () -> store.getPattern(HashingUtil.computeContentHash(constant(0.3, 2.0))));
+    }
+
+    @Test
+    void testQueryResultCacheHitsAndVersionInvalidation() throws IOException {
+        System.setProperty("resonance.query.cache.maxBytes", String.valueOf(1L << 24));
+        StoreRuntimeServices runtime = StoreRuntimeServices.fromSystemProperties();
+        try (WavePatternStoreImpl cached = new WavePatternStoreImpl(
+                Files.createDirectories(tempDir.resolve("cached")), len(), runtime)) {
+            for (int i = 0; i < 10; i++) {
+                cached.insert(constant(1.0, -1.0 + i * 0.2), Map.of());
+            }
+            WavePattern query = constant(1.0, 0.05);
+
+            List<ResonanceMatch> first = cached.query(query, 3);
+            long admitted = runtime.admission().stats().admitted();
+            List<ResonanceMatch> second = cached.query(query, 3);
+            assertEquals(first, second);
+            assertEquals(admitted, runtime.admission().stats().admitted(), "a cache hit must not take a permit");
+            QueryCacheStats stats = cached.queryCacheStats();
+            assertEquals(1, stats.hits());
+            assertEquals(1, stats.misses());
+            assertEquals(1, stats.entries());
+
+            long version = stats.corpusVersion();
+            String id = cached.insert(query, Map.of());
+            assertTrue(cached.queryCacheStats().corpusVersion() > version);
+            assertEquals(id, cached.query(query, 3).getFirst().id(), "a mutation must invalidate cached results");
+            assertEquals(2, cached.queryCacheStats().misses());
+        } finally {
+            System.clearProperty("resonance.query.cache.maxBytes");
+        }
+    }
+
     @Test
     void testQueryDetailedWithZonesAndPhaseShift() {
         WavePattern core = constant(1.0, 0.0);
@@ -829,4 +1368,122 @@ public class WavePatternStoreImplTest {
         assertEquals(p.energy(), d.energy(), 1e-6,
                 "query and queryDetailed must agree on energy for the same id");
     }
-}
\ No newline at end of file
+    @Test
+    void testAsyncApiMatchesSyncAndCompletesExceptionally() throws Exception {
+        Random rnd = new Random(70);
+        List<String> ids = new ArrayList<>();
+        for (int i = 0; i < 20; i++) {
+            ids.add(store.insertAsync(randomPattern(0.5, 1.5, -Math.PI, Math.PI, rnd), Map.of()).get(30, TimeUnit.SECONDS));
+        }
+        assertEquals(20, new HashSet<>(ids).size());
+
+        WavePattern query = randomPattern(0.5, 1.5, -Math.PI, Math.PI, rnd);
+        List<ResonanceMatch> sync = store.query(query, 5);
+        List<ResonanceMatch> async = store.queryAsync(query, 5, QueryOptions.defaultOptions()).get(30, TimeUnit.SECONDS);
+        assertEquals(sync.stream().map(ResonanceMatch::id).toList(), async.stream().map(ResonanceMatch::id).toList());
+
+        WavePattern existing = store.getPattern(ids.getFirst());
+        ExecutionException duplicate = assertThrows(ExecutionException.class,
+                () -> store.insertAsync(existing, Map.of()).get(30, TimeUnit.SECONDS));
+        assertInstanceOf(DuplicatePatternException.class, duplicate.getCause());
+
+        store.deleteAsync(ids.getFirst()).get(30, TimeUnit.SECONDS);
+        assertThrows(PatternNotFoundException.class, () -> store.getPattern(ids.getFirst()));
+
+        CompletableFuture<List<ResonanceMatch>> cancelled = store.queryAsync(query, 5, QueryOptions.defaultOptions());
+        cancelled.cancel(true);
+        assertTrue(cancelled.isDone());
+    }
+
+    @Test
+    void testReopenedStoreWarmsUpInBackgroundWithoutMissingRecords() {
+        Random rnd = new Random(74L);
+        List<WavePattern> patterns = new ArrayList<>();
+        for (int i = 0; i < 30; i++) {
+            WavePattern p = randomPattern(0.2, 1.0, -Math.PI, Math.PI, rnd);
+            patterns.add(p);
+            store.insert(p, Map.of());
+        }
+        WavePattern query = patterns.get(11);
+        List<String> before = store.query(query, 10).stream().map(ResonanceMatch::id).toList();
+        store.close();
+
+        store = new WavePatternStoreImpl(tempDir, len(), StoreRuntimeServices.fromSystemProperties());
+        List<String> after = store.query(query, 10).stream().map(ResonanceMatch::id).toList();
+
+        assertTrue(store.isReady());
+        assertEquals(store.warmupSegments(), store.warmedSegments());
+        assertEquals(before, after);
+        assertEquals(HashingUtil.computeContentHash(query), after.get(0));
+    }
+
+    @Test
+    void testMutationsDuringWarmUpAreVisibleOnceReady() {
+        Random rnd = new Random(741L);
+        List<String> ids = new ArrayList<>();
+        for (int i = 0; i < 20; i++) {
+            ids.add(store.insert(randomPattern(0.2, 1.0, -Math.PI, Math.PI, rnd), Map.of()));
+        }
+        store.close();
+
+        store = new WavePatternStoreImpl(tempDir, len(), StoreRuntimeServices.fromSystemProperties());
+        WavePattern added = randomPattern(0.2, 1.0, -Math.PI, Math.PI, rnd);
+        String addedId = store.insert(added, Map.of());
+        store.delete(ids.get(3));
+
+        List<ResonanceMatch> matches = store.query(added, 21, QueryOptions.defaultOptions().withExact(true));
+        assertTrue(store.isReady());
+        assertEquals(addedId, matches.getFirst().id());
+        assertEquals(20, matches.size());
+        assertTrue(matches.stream().noneMatch(m -> m.id().equals(ids.get(3))));
+    }
+
+    @Test
+    void testQueryManyRanksAcrossCorporaAsOneResult() throws IOException {
+        Random rnd = new Random(75L);
+        try (StoreRuntimeServices runtime = StoreRuntimeServices.fromSystemProperties();
+             WavePatternStoreImpl a = new WavePatternStoreImpl(
+                     Files.createDirectories(tempDir.resolve("a")), len(), runtime);
+             WavePatternStoreImpl b = new WavePatternStoreImpl(
+                     Files.createDirectories(tempDir.resolve("b")), len(), runtime)) {
+            for (int i = 0; i < 20; i++) {
+                a.insert(randomPattern(0.2, 1.0, -Math.PI, Math.PI, rnd), Map.of());
+                b.insert(randomPattern(0.2, 1.0, -Math.PI, Math.PI, rnd), Map.of());
+            }
+            WavePattern query = randomPattern(0.2, 1.0, -Math.PI, Math.PI, rnd);
+            String queryId = a.insert(query, Map.of());
+            b.insert(query, Map.of());
+
+            QueryOptions exact = QueryOptions.defaultOptions().withExact(true);
+            Map<String, WavePatternStoreImpl> stores = new LinkedHashMap<>();
+            stores.put("a", a);
+            stores.put("b", b);
+            QueryResult<CorpusMatch> result = WavePatternStoreImpl.queryMany(stores, query, 10, exact);
+
+            List<CorpusMatch> expected = new ArrayList<>();
+            stores.forEach((corpus, s) -> s.query(query, 10, exact)
+                    .forEach(m -> expected.add(CorpusMatch.of(corpus, m))));
+            expected.sort(Comparator.comparingDouble((CorpusMatch m) -> m.energy()).reversed());
+
+            List<CorpusMatch> matches = result.matches();
+            assertEquals(10, matches.size());
+            assertFalse(result.partial());
+            assertEquals(queryId, matches.get(0).id());
+            assertEquals(queryId, matches.get(1).id());
+            assertEquals(List.of("a", "b"), List.of(matches.get(0).corpusId(), matches.get(1).corpusId()),
+                    "the same pattern is reported once per corpus, ordered by corpus id");
+            assertEquals(expected.subList(0, 10).stream().map(m -> m.corpusId() + "/" + m.id()).toList(),
+                    matches.stream().map(m -> m.corpusId() + "/" + m.id()).toList());
+            assertSamePattern(query, matches.get(0).pattern());
+
+            Map<String, WavePatternStoreImpl> reversed = new LinkedHashMap<>();
+            reversed.put("b", b);
+            reversed.put("a", a);
+            QueryResult<CorpusMatch> swapped = WavePatternStoreImpl.queryMany(reversed, query, 10, QueryOptions.defaultOptions());
+            QueryResult<CorpusMatch> straight = WavePatternStoreImpl.queryMany(stores, query, 10, QueryOptions.defaultOptions());
+            assertEquals(straight.options(), swapped.options(), "options must not depend on the argument order");
+            assertEquals(straight.matches().stream().map(m -> m.corpusId() + "/" + m.id()).toList(),
+                    swapped.matches().stream().map(m -> m.corpusId() + "/" + m.id()).toList());
+        }
+    }
+}
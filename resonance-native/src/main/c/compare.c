@@ -534,6 +534,86 @@ EXPORT void compare_with_phase_delta(const float* restrict A1, const float* rest
 #endif
 }
 
+static inline uint32_t popcount_xor_scalar(const uint64_t *a, const uint64_t *b, int words) {
+    uint32_t total = 0;
+    for (int i = 0; i < words; ++i) {
+        total += (uint32_t)__builtin_popcountll(a[i] ^ b[i]);
+    }
+    return total;
+}
+
+#if defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+static inline uint32_t popcount_xor(const uint64_t *a, const uint64_t *b, int words) {
+    __m512i acc = _mm512_setzero_si512();
+    int i = 0;
+    for (; i <= words - 8; i += 8) {
+        __m512i x = _mm512_xor_si512(_mm512_loadu_si512((const void*)(a + i)),
+                                     _mm512_loadu_si512((const void*)(b + i)));
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(x));
+    }
+    uint32_t total = (uint32_t)_mm512_reduce_add_epi64(acc);
+    return total + popcount_xor_scalar(a + i, b + i, words - i);
+}
+#elif defined(__AVX2__)
+static inline uint32_t popcount_xor(const uint64_t *a, const uint64_t *b, int words) {
+    const __m256i lookup = _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,
+                                            0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+    const __m256i low  = _mm256_set1_epi8(0x0f);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i <= words - 4; i += 4) {
+        __m256i x  = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(a + i)),
+                                      _mm256_loadu_si256((const __m256i*)(b + i)));
+        __m256i lo = _mm256_and_si256(x, low);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), low);
+        __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+                                      _mm256_shuffle_epi8(lookup, hi));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, zero));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, acc);
+    uint32_t total = (uint32_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    return total + popcount_xor_scalar(a + i, b + i, words - i);
+}
+#else
+static inline uint32_t popcount_xor(const uint64_t *a, const uint64_t *b, int words) {
+    return popcount_xor_scalar(a, b, words);
+}
+#endif
+
+/*
+ * Sketches are `stride` words apart, so callers can pass the summary sidecar mapping in place,
+ * where each sketch sits inside a larger per-record entry.
+ */
+EXPORT void hamming_many_strided(const uint64_t* restrict query,
+                                 const uint64_t* restrict all,
+                                 int words, int stride, int count, int32_t* restrict out)
+{
+    if (!query || !all || !out || words <= 0 || stride < words || count <= 0 || count > (int)MAX_COUNT) {
+#if DEBUG_MODE
+        fprintf(stderr, "[hamming_many_strided] invalid args: words=%d stride=%d count=%d\n",
+                words, stride, count);
+#endif
+        return;
+    }
+
+    OMP_FOR(omp parallel for schedule(static) if (count >= 64))
+    for (int k = 0; k < count; ++k) {
+        out[k] = (int32_t)popcount_xor(query, all + (size_t)k * (size_t)stride, words);
+    }
+#if defined(__AVX2__)
+    _mm256_zeroupper();
+#endif
+}
+
+EXPORT void hamming_many(const uint64_t* restrict query,
+                         const uint64_t* restrict all,
+                         int words, int count, int32_t* restrict out)
+{
+    hamming_many_strided(query, all, words, words, count, out);
+}
+
 #ifdef __cplusplus
 }
 #endif
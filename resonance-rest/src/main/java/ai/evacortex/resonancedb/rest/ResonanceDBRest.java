@@ -10,10 +10,13 @@ package ai.evacortex.resonancedb.rest;
 
 import ai.evacortex.resonancedb.core.corpus.CorpusService;
 import ai.evacortex.resonancedb.core.storage.FileSystemCorpusService;
+import ai.evacortex.resonancedb.rest.dto.BatchQueryRequest;
 import ai.evacortex.resonancedb.rest.dto.CompareRequest;
 import ai.evacortex.resonancedb.rest.dto.CompositeQueryRequest;
 import ai.evacortex.resonancedb.rest.dto.DeleteRequest;
+import ai.evacortex.resonancedb.rest.dto.FederatedQueryRequest;
 import ai.evacortex.resonancedb.rest.dto.InsertRequest;
+import ai.evacortex.resonancedb.rest.dto.PageQueryRequest;
 import ai.evacortex.resonancedb.rest.dto.QueryRequest;
 import ai.evacortex.resonancedb.rest.dto.ReplaceRequest;
 import ai.evacortex.resonancedb.rest.error.ErrorMapper;
@@ -91,29 +94,37 @@ public final class ResonanceDBRest implements Closeable {
         this.cors = new CorsSupport(cfg);
 
         this.errors = new ErrorMapper();
-        this.pipeline = new RestPipeline(io, cors, errors);
+        this.pipeline = new RestPipeline(io, cors, errors, httpExec);
         this.router = new RestRouter(server, pipeline);
 
         this.validator = new WavePatternValidator(cfg);
         this.topK = new TopK(cfg);
 
-        this.healthHandlers = new HealthHandlers();
+        this.healthHandlers = new HealthHandlers(corpusService);
         this.queryHandlers = new QueryHandlers(corpusService, validator, topK);
         this.mutationHandlers = new MutationHandlers(corpusService, validator);
 
         router.get("/health", ex -> io.writeJson(ex, 200, healthHandlers.health(ex)));
+        router.get("/admission", ex -> io.writeJson(ex, 200, healthHandlers.admission(ex)));
+        router.get("/memory", ex -> io.writeJson(ex, 200, healthHandlers.memory(ex)));
+        router.get("/corpora/{corpusId}/queryCache", ex -> io.writeJson(ex, 200, queryHandlers.queryCacheStats(ex)));
+        router.get("/corpora/{corpusId}/patterns/{patternId}", ex -> io.writeJson(ex, 200, queryHandlers.pattern(ex)));
 
+        router.postJsonAsync("/query", FederatedQueryRequest.class, queryHandlers::queryMany);
         router.postJson("/corpora/{corpusId}/compare", CompareRequest.class, queryHandlers::compare);
-        router.postJson("/corpora/{corpusId}/query", QueryRequest.class, queryHandlers::query);
-        router.postJson("/corpora/{corpusId}/queryDetailed", QueryRequest.class, queryHandlers::queryDetailed);
+        router.postJsonAsync("/corpora/{corpusId}/query", QueryRequest.class, queryHandlers::query);
+        router.postJsonAsync("/corpora/{corpusId}/queryDetailed", QueryRequest.class, queryHandlers::queryDetailed);
+        router.postJson("/corpora/{corpusId}/queryPage", PageQueryRequest.class, queryHandlers::queryPage);
+        router.postJsonAsync("/corpora/{corpusId}/queryBatch", BatchQueryRequest.class, queryHandlers::queryBatch);
+        router.post("/corpora/{corpusId}/queryThreshold", ex -> queryHandlers.queryThreshold(ex, io));
         router.postJson("/corpora/{corpusId}/queryInterference", QueryRequest.class, queryHandlers::queryInterference);
         router.postJson("/corpora/{corpusId}/queryInterferenceMap", QueryRequest.class, queryHandlers::queryInterferenceMap);
         router.postJson("/corpora/{corpusId}/queryComposite", CompositeQueryRequest.class, queryHandlers::queryComposite);
         router.postJson("/corpora/{corpusId}/queryCompositeDetailed", CompositeQueryRequest.class, queryHandlers::queryCompositeDetailed);
 
-        router.postJson("/corpora/{corpusId}/insert", InsertRequest.class, mutationHandlers::insert);
-        router.postJson("/corpora/{corpusId}/replace", ReplaceRequest.class, mutationHandlers::replace);
-        router.postJson("/corpora/{corpusId}/delete", DeleteRequest.class, mutationHandlers::delete);
+        router.postJsonAsync("/corpora/{corpusId}/insert", InsertRequest.class, mutationHandlers::insert);
+        router.postJsonAsync("/corpora/{corpusId}/replace", ReplaceRequest.class, mutationHandlers::replace);
+        router.postJsonAsync("/corpora/{corpusId}/delete", DeleteRequest.class, mutationHandlers::delete);
     }
 
     public static ResonanceDBRest withEmbeddedStore(Path dbRoot, int port) throws IOException {
@@ -64,7 +64,7 @@ public record ResonanceRestConfig(
 
         String corsOrigin = getString("resonance.rest.corsOrigin", "*");
         String corsMethods = getString("resonance.rest.corsMethods", "GET,POST,OPTIONS");
-        String corsHeaders = getString("resonance.rest.corsHeaders", "Content-Type");
+        String corsHeaders = getString("resonance.rest.corsHeaders", "Content-Type, X-Query-Timeout-Ms");
 
         int defTopK = getInt("resonance.rest.topK.default", 10);
         if (defTopK < 0) defTopK = 10;
@@ -0,0 +1,13 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.rest.dto;
+
+import java.util.List;
+
+public record FederatedQueryRequest(List<String> corpusIds, WavePatternDto query, Integer topK, QueryOptionsDto options) {}
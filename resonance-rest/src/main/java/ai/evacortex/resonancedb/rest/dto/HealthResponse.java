@@ -8,4 +8,9 @@
  */
 package ai.evacortex.resonancedb.rest.dto;
 
-public record HealthResponse(String status, String timeUtc) {}
\ No newline at end of file
+import ai.evacortex.resonancedb.core.corpus.CorpusReadiness;
+
+import java.util.List;
+
+/** Liveness plus readiness: {@code ready} is false while any open corpus is still warming up. */
+public record HealthResponse(String status, String timeUtc, boolean ready, List<CorpusReadiness> corpora) {}
\ No newline at end of file
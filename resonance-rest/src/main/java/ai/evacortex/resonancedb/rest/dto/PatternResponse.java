@@ -0,0 +1,15 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.rest.dto;
+
+import ai.evacortex.resonancedb.core.storage.WavePattern;
+
+import java.util.Map;
+
+public record PatternResponse(String id, WavePattern pattern, Map<String, String> metadata) {}
@@ -0,0 +1,25 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.rest.dto;
+
+/**
+ * Optional per-request overrides of {@code QueryOptions}; {@code null} fields keep the server defaults.
+ */
+public record QueryOptionsDto(
+        String scanMode,
+        Boolean sketchPrefilter,
+        Double phaseEpsilon,
+        Integer maxSegments,
+        Integer maxCandidates,
+        Integer overfetch,
+        Boolean exact,
+        Long timeoutMillis,
+        String projection,
+        String priority
+) {}
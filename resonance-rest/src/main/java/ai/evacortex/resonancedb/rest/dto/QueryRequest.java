@@ -8,4 +8,9 @@
  */
 package ai.evacortex.resonancedb.rest.dto;
 
-public record QueryRequest(WavePatternDto query, Integer topK) {}
\ No newline at end of file
+public record QueryRequest(WavePatternDto query, Integer topK, QueryOptionsDto options) {
+
+    public QueryRequest(WavePatternDto query, Integer topK) {
+        this(query, topK, null);
+    }
+}
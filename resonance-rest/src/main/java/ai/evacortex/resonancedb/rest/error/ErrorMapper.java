@@ -8,9 +8,11 @@
  */
 package ai.evacortex.resonancedb.rest.error;
 
+import ai.evacortex.resonancedb.core.exceptions.CorpusNotFoundException;
 import ai.evacortex.resonancedb.core.exceptions.DuplicatePatternException;
 import ai.evacortex.resonancedb.core.exceptions.InvalidWavePatternException;
 import ai.evacortex.resonancedb.core.exceptions.PatternNotFoundException;
+import ai.evacortex.resonancedb.core.exceptions.QueryRejectedException;
 import ai.evacortex.resonancedb.rest.dto.ErrorResponse;
 import com.fasterxml.jackson.core.JsonProcessingException;
 
@@ -61,6 +63,22 @@ public final class ErrorMapper {
             );
         }
 
+        // 404: unknown corpus
+        if (t instanceof CorpusNotFoundException cnfe) {
+            return new RestError(
+                    404,
+                    new ErrorResponse("corpus_not_found", safeMsg(cnfe))
+            );
+        }
+
+        // 429: shed by query admission control
+        if (t instanceof QueryRejectedException qre) {
+            return new RestError(
+                    429,
+                    new ErrorResponse("overloaded", safeMsg(qre))
+            );
+        }
+
         // Fallback: 500
         return new RestError(
                 500,
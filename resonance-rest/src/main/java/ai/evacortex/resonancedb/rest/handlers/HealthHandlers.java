@@ -8,16 +8,38 @@
  */
 package ai.evacortex.resonancedb.rest.handlers;
 
+import ai.evacortex.resonancedb.core.corpus.CorpusReadiness;
+import ai.evacortex.resonancedb.core.corpus.CorpusService;
+import ai.evacortex.resonancedb.core.storage.responce.AdmissionStats;
+import ai.evacortex.resonancedb.core.storage.responce.MemoryStats;
 import ai.evacortex.resonancedb.rest.dto.HealthResponse;
 import com.sun.net.httpserver.HttpExchange;
 
 import java.time.Instant;
+import java.util.List;
+import java.util.Objects;
 
 public final class HealthHandlers {
 
-    public HealthHandlers() {}
+    private final CorpusService corpora;
+
+    public HealthHandlers(CorpusService corpora) {
+        this.corpora = Objects.requireNonNull(corpora, "corpora");
+    }
 
     public HealthResponse health(HttpExchange ex) {
-        return new HealthResponse("ok", Instant.now().toString());
+        List<CorpusReadiness> open = corpora.readiness();
+        boolean ready = open.stream().noneMatch(c -> c.phase() == CorpusReadiness.Phase.WARMING);
+        return new HealthResponse("ok", Instant.now().toString(), ready, open);
+    }
+
+    /** Query admission counters shared by all corpora: in-flight work and queue depth per class and corpus. */
+    public AdmissionStats admission(HttpExchange ex) {
+        return corpora.admissionStats();
+    }
+
+    /** Bytes held by open corpora and query scratch against the global memory budget. */
+    public MemoryStats memory(HttpExchange ex) {
+        return corpora.memoryStats();
     }
 }
\ No newline at end of file
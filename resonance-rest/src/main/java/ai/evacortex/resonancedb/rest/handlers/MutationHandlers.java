@@ -21,6 +21,7 @@ import com.sun.net.httpserver.HttpExchange;
 
 import java.util.Map;
 import java.util.Objects;
+import java.util.concurrent.CompletableFuture;
 
 public final class MutationHandlers {
 
@@ -32,32 +33,29 @@ public final class MutationHandlers {
         this.validator = Objects.requireNonNull(validator, "validator");
     }
 
-    public IdResponse insert(HttpExchange ex, InsertRequest req)
+    public CompletableFuture<IdResponse> insert(HttpExchange ex, InsertRequest req)
             throws DuplicatePatternException, InvalidWavePatternException {
 
         ResonanceStore store = resolveStore(ex);
         WavePattern psi = validator.toWavePattern(req.pattern());
         Map<String, String> md = (req.metadata() == null) ? Map.of() : req.metadata();
-        String id = store.insert(psi, md);
-        return new IdResponse(id);
+        return store.insertAsync(psi, md).thenApply(IdResponse::new);
     }
 
-    public IdResponse replace(HttpExchange ex, ReplaceRequest req)
+    public CompletableFuture<IdResponse> replace(HttpExchange ex, ReplaceRequest req)
             throws PatternNotFoundException, DuplicatePatternException, InvalidWavePatternException {
 
         ResonanceStore store = resolveStore(ex);
         WavePattern psi = validator.toWavePattern(req.pattern());
         Map<String, String> md = (req.metadata() == null) ? Map.of() : req.metadata();
-        String id = store.replace(req.id(), psi, md);
-        return new IdResponse(id);
+        return store.replaceAsync(req.id(), psi, md).thenApply(IdResponse::new);
     }
 
-    public OkResponse delete(HttpExchange ex, DeleteRequest req)
+    public CompletableFuture<OkResponse> delete(HttpExchange ex, DeleteRequest req)
             throws PatternNotFoundException {
 
         ResonanceStore store = resolveStore(ex);
-        store.delete(req.id());
-        return new OkResponse(true);
+        return store.deleteAsync(req.id()).thenApply(ignored -> new OkResponse(true));
     }
 
     private ResonanceStore resolveStore(HttpExchange ex) {
@@ -10,25 +10,43 @@ package ai.evacortex.resonancedb.rest.handlers;
 
 import ai.evacortex.resonancedb.core.ResonanceStore;
 import ai.evacortex.resonancedb.core.corpus.CorpusService;
+import ai.evacortex.resonancedb.core.engine.QueryOptions;
 import ai.evacortex.resonancedb.core.exceptions.InvalidWavePatternException;
 import ai.evacortex.resonancedb.core.storage.WavePattern;
+import ai.evacortex.resonancedb.core.storage.responce.CorpusMatch;
 import ai.evacortex.resonancedb.core.storage.responce.InterferenceEntry;
 import ai.evacortex.resonancedb.core.storage.responce.InterferenceMap;
+import ai.evacortex.resonancedb.core.storage.responce.QueryCacheStats;
+import ai.evacortex.resonancedb.core.storage.responce.QueryPage;
+import ai.evacortex.resonancedb.core.storage.responce.QueryResult;
 import ai.evacortex.resonancedb.core.storage.responce.ResonanceMatch;
 import ai.evacortex.resonancedb.core.storage.responce.ResonanceMatchDetailed;
+import ai.evacortex.resonancedb.core.storage.responce.ThresholdResult;
 import ai.evacortex.resonancedb.rest.dto.*;
+import ai.evacortex.resonancedb.rest.error.BadRequestException;
 import ai.evacortex.resonancedb.rest.http.RestRouter;
+import ai.evacortex.resonancedb.rest.io.HttpIO;
+import ai.evacortex.resonancedb.rest.io.NdjsonStream;
 import ai.evacortex.resonancedb.rest.util.TopK;
 import ai.evacortex.resonancedb.rest.validation.WavePatternValidator;
 import com.sun.net.httpserver.HttpExchange;
 
+import java.io.IOException;
 import java.util.ArrayList;
 import java.util.List;
+import java.util.Locale;
 import java.util.Objects;
+import java.util.concurrent.CompletableFuture;
+import java.util.function.Function;
 
 
 public final class QueryHandlers {
 
+    /** Client-side timeout in milliseconds; the query stops when it expires and returns a partial result. */
+    public static final String TIMEOUT_HEADER = "X-Query-Timeout-Ms";
+    /** Query parameter ({@code ?envelope=true}) that asks for the {@code QueryResult} envelope without options. */
+    public static final String ENVELOPE_PARAM = "envelope";
+
     private final CorpusService corpora;
     private final WavePatternValidator validator;
     private final TopK topK;
@@ -47,18 +65,110 @@ public final class QueryHandlers {
         return new CompareResponse(score);
     }
 
-    public List<ResonanceMatch> query(HttpExchange ex, QueryRequest req) {
+    /**
+     * Plain match list, or the {@code QueryResult} envelope with the effective options, scan counters
+     * and the partial flag when the caller opts in: by sending options, a {@value #TIMEOUT_HEADER}
+     * header or the {@value #ENVELOPE_PARAM} query parameter. With the {@code ids} projection each
+     * match is reduced to its id.
+     */
+    public CompletableFuture<Object> query(HttpExchange ex, QueryRequest req) {
         ResonanceStore store = resolveStore(ex);
         WavePattern q = validator.toWavePattern(req.query());
         int k = topK.clamp(req.topK());
-        return store.query(q, k);
+        QueryOptions options = requestOptions(ex, req.options());
+        boolean envelope = wantsEnvelope(ex, req.options());
+        return store.queryResultAsync(q, k, options)
+                .thenApply(result -> envelope ? idsOnly(result, ResonanceMatch::id) : result.matches());
     }
 
-    public List<ResonanceMatchDetailed> queryDetailed(HttpExchange ex, QueryRequest req) {
+    /** Detailed counterpart of {@link #query}, with the same opt-in envelope. */
+    public CompletableFuture<Object> queryDetailed(HttpExchange ex, QueryRequest req) {
         ResonanceStore store = resolveStore(ex);
         WavePattern q = validator.toWavePattern(req.query());
         int k = topK.clamp(req.topK());
-        return store.queryDetailed(q, k);
+        QueryOptions options = requestOptions(ex, req.options());
+        boolean envelope = wantsEnvelope(ex, req.options());
+        return store.queryDetailedResultAsync(q, k, options)
+                .thenApply(result -> envelope ? idsOnly(result, ResonanceMatchDetailed::id) : result.matches());
+    }
+
+    /**
+     * Best matches across the corpora listed in the request, ranked as one scan. The response is
+     * always the {@code QueryResult} envelope; each match names its corpus.
+     */
+    public CompletableFuture<QueryResult<CorpusMatch>> queryMany(HttpExchange ex, FederatedQueryRequest req) {
+        if (req.corpusIds() == null || req.corpusIds().isEmpty()) {
+            throw new BadRequestException("corpusIds must not be empty");
+        }
+        List<String> ids = new ArrayList<>(req.corpusIds().size());
+        for (String corpusId : req.corpusIds()) {
+            try {
+                ids.add(CorpusService.normalizeCorpusId(corpusId));
+            } catch (IllegalArgumentException | NullPointerException e) {
+                throw new BadRequestException("Invalid corpusId: " + e.getMessage(), e);
+            }
+        }
+        WavePattern q = validator.toWavePattern(req.query());
+        int k = topK.clamp(req.topK());
+        QueryOptions options = requestOptions(ex, req.options());
+        return corpora.queryManyAsync(ids, q, k, options);
+    }
+
+    public PatternResponse pattern(HttpExchange ex) {
+        ResonanceStore store = resolveStore(ex);
+        String id = RestRouter.pathParam(ex, "patternId");
+        try {
+            return new PatternResponse(id, store.getPattern(id), store.getMetadata(id));
+        } catch (IllegalArgumentException e) {
+            throw new BadRequestException("Invalid pattern id: " + id, e);
+        }
+    }
+
+    /** One page of at most {@code topK} matches and the cursor for the next page. */
+    public QueryPage<?> queryPage(HttpExchange ex, PageQueryRequest req) {
+        ResonanceStore store = resolveStore(ex);
+        WavePattern q = validator.toWavePattern(req.query());
+        int k = topK.clamp(req.topK());
+        QueryOptions options = requestOptions(ex, req.options());
+        QueryPage<ResonanceMatch> page;
+        try {
+            page = store.queryPage(q, k, req.cursor(), options);
+        } catch (IllegalArgumentException e) {
+            throw new BadRequestException("Invalid cursor: " + e.getMessage(), e);
+        }
+        if (page.options().projection() != QueryOptions.Projection.IDS) {
+            return page;
+        }
+        List<IdResponse> ids = page.matches().stream().map(m -> new IdResponse(m.id())).toList();
+        return new QueryPage<>(ids, page.nextCursor(), page.options(), page.corpusVersion(), page.partial());
+    }
+
+    public CompletableFuture<List<List<ResonanceMatch>>> queryBatch(HttpExchange ex, BatchQueryRequest req) {
+        ResonanceStore store = resolveStore(ex);
+        List<WavePattern> queries = toPatterns(req.queries());
+        int k = topK.clamp(req.topK());
+        return store.queryBatchAsync(queries, k);
+    }
+
+    /**
+     * Streams every match with energy ≥ {@code minEnergy} as NDJSON, one match per line, followed by
+     * a final line with the {@code ThresholdResult} summary.
+     */
+    public void queryThreshold(HttpExchange ex, HttpIO io) throws IOException {
+        ResonanceStore store = resolveStore(ex);
+        ThresholdQueryRequest req = io.readJson(ex, ThresholdQueryRequest.class);
+        WavePattern q = validator.toWavePattern(req.query());
+        if (req.minEnergy() == null || !Float.isFinite(req.minEnergy())) {
+            throw new BadRequestException("minEnergy must be a finite number");
+        }
+        QueryOptions options = requestOptions(ex, req.options());
+        boolean idsOnly = options.projection() == QueryOptions.Projection.IDS;
+
+        try (NdjsonStream out = io.startNdjson(ex)) {
+            ThresholdResult summary = store.queryThreshold(q, req.minEnergy(), options,
+                    m -> out.writeUnchecked(idsOnly ? new IdResponse(m.id()) : m));
+            out.write(summary);
+        }
     }
 
     public InterferenceMap queryInterference(HttpExchange ex, QueryRequest req) {
@@ -91,11 +201,97 @@ public final class QueryHandlers {
         return store.queryCompositeDetailed(patterns, req.weights(), k);
     }
 
+    public QueryCacheStats queryCacheStats(HttpExchange ex) {
+        return resolveStore(ex).queryCacheStats();
+    }
+
     private ResonanceStore resolveStore(HttpExchange ex) {
         String corpusId = RestRouter.pathParam(ex, "corpusId");
         return corpora.store(corpusId);
     }
 
+    private static <T> QueryResult<?> idsOnly(QueryResult<T> result, Function<T, String> id) {
+        if (result.options().projection() != QueryOptions.Projection.IDS) {
+            return result;
+        }
+        List<IdResponse> ids = result.matches().stream().map(m -> new IdResponse(id.apply(m))).toList();
+        return new QueryResult<>(ids, result.options(), result.segmentsScanned(), result.candidatesScored(), result.partial());
+    }
+
+    private static boolean wantsEnvelope(HttpExchange ex, QueryOptionsDto dto) {
+        if (dto != null || ex.getRequestHeaders().getFirst(TIMEOUT_HEADER) != null) {
+            return true;
+        }
+        String query = ex.getRequestURI().getRawQuery();
+        if (query == null) {
+            return false;
+        }
+        for (String param : query.split("&")) {
+            if (param.equals(ENVELOPE_PARAM) || param.equalsIgnoreCase(ENVELOPE_PARAM + "=true")) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    private static QueryOptions requestOptions(HttpExchange ex, QueryOptionsDto dto) {
+        String header = ex.getRequestHeaders().getFirst(TIMEOUT_HEADER);
+        QueryOptions options = dto == null ? QueryOptions.defaultOptions() : toOptions(dto);
+        if (header != null) {
+            long millis;
+            try {
+                millis = Long.parseLong(header.trim());
+            } catch (NumberFormatException e) {
+                throw new BadRequestException("Invalid " + TIMEOUT_HEADER + " header: " + header, e);
+            }
+            if (millis <= 0) {
+                throw new BadRequestException(TIMEOUT_HEADER + " must be > 0, got: " + millis);
+            }
+            long current = options.timeoutMillis();
+            options = options.withTimeoutMillis(current > 0 ? Math.min(current, millis) : millis);
+        }
+        return options;
+    }
+
+    private static QueryOptions toOptions(QueryOptionsDto dto) {
+        QueryOptions options = QueryOptions.defaultOptions();
+        try {
+            if (dto.scanMode() != null) {
+                options = options.withScanMode(QueryOptions.ScanMode.valueOf(dto.scanMode().trim().toUpperCase(Locale.ROOT)));
+            }
+            if (dto.sketchPrefilter() != null) {
+                options = options.withSketchPrefilter(dto.sketchPrefilter());
+            }
+            if (dto.phaseEpsilon() != null) {
+                options = options.withPhaseEpsilon(dto.phaseEpsilon());
+            }
+            if (dto.maxSegments() != null) {
+                options = options.withMaxSegments(dto.maxSegments());
+            }
+            if (dto.maxCandidates() != null) {
+                options = options.withMaxCandidates(dto.maxCandidates());
+            }
+            if (dto.overfetch() != null) {
+                options = options.withOverfetch(dto.overfetch());
+            }
+            if (dto.exact() != null) {
+                options = options.withExact(dto.exact());
+            }
+            if (dto.timeoutMillis() != null) {
+                options = options.withTimeoutMillis(dto.timeoutMillis());
+            }
+            if (dto.projection() != null) {
+                options = options.withProjection(QueryOptions.Projection.parse(dto.projection()));
+            }
+            if (dto.priority() != null) {
+                options = options.withPriority(QueryOptions.Priority.valueOf(dto.priority().trim().toUpperCase(Locale.ROOT)));
+            }
+        } catch (IllegalArgumentException e) {
+            throw new BadRequestException("Invalid query options: " + e.getMessage(), e);
+        }
+        return options;
+    }
+
     private List<WavePattern> toPatterns(List<WavePatternDto> dtos) {
         if (dtos == null || dtos.isEmpty()) {
             return List.of();
@@ -10,6 +10,8 @@ package ai.evacortex.resonancedb.rest.http;
 
 import com.sun.net.httpserver.HttpExchange;
 
+import java.util.concurrent.CompletionStage;
+
 public final class ExchangeHandlers {
 
     private ExchangeHandlers() {}
@@ -23,4 +25,10 @@ public final class ExchangeHandlers {
     public interface ExchangeJsonHandler<Req, Resp> {
         Resp handle(HttpExchange ex, Req req) throws Exception;
     }
+
+    /** Starts the work and returns at once; the response is written when the stage completes. */
+    @FunctionalInterface
+    public interface ExchangeAsyncJsonHandler<Req, Resp> {
+        CompletionStage<Resp> handle(HttpExchange ex, Req req) throws Exception;
+    }
 }
\ No newline at end of file
@@ -17,17 +17,29 @@ import com.sun.net.httpserver.HttpExchange;
 
 import java.io.IOException;
 import java.util.Objects;
+import java.util.concurrent.CompletionException;
+import java.util.concurrent.CompletionStage;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.Executor;
+import java.util.concurrent.RejectedExecutionException;
 
 public final class RestPipeline {
 
     private final HttpIO io;
     private final CorsSupport cors;
     private final ErrorMapper errors;
+    private final Executor responder;
 
     public RestPipeline(HttpIO io, CorsSupport cors, ErrorMapper errors) {
+        this(io, cors, errors, Runnable::run);
+    }
+
+    /** {@code responder} writes async responses, keeping socket I/O off the threads that complete the work. */
+    public RestPipeline(HttpIO io, CorsSupport cors, ErrorMapper errors, Executor responder) {
         this.io = Objects.requireNonNull(io, "io");
         this.cors = Objects.requireNonNull(cors, "cors");
         this.errors = Objects.requireNonNull(errors, "errors");
+        this.responder = Objects.requireNonNull(responder, "responder");
     }
 
     public void handleGet(HttpExchange ex, ExchangeHandlers.ExchangeHandler handler) {
@@ -102,9 +114,77 @@ public final class RestPipeline {
         }
     }
 
+    /**
+     * Like {@link #handlePostJson}, but the handler only starts the work: the request thread returns at
+     * once and the response is written and the exchange closed when the returned stage completes.
+     */
+    public <Req, Resp> void handlePostJsonAsync(
+            HttpExchange ex,
+            Class<Req> reqType,
+            ExchangeHandlers.ExchangeAsyncJsonHandler<Req, Resp> handler
+    ) {
+        CompletionStage<Resp> pending = null;
+        try {
+            cors.apply(ex);
+
+            if (isOptions(ex)) {
+                cors.preflight(ex);
+                return;
+            }
+            if (!"POST".equalsIgnoreCase(ex.getRequestMethod())) {
+                io.writeJson(ex, 405, new ErrorResponse("method_not_allowed", "Use POST"));
+                return;
+            }
+
+            Req req = io.readJson(ex, reqType);
+            pending = handler.handle(ex, req);
+
+        } catch (Throwable t) {
+            writeMappedError(ex, t);
+        } finally {
+            if (pending == null) {
+                io.safeClose(ex);
+            }
+        }
+
+        if (pending != null) {
+            pending.whenComplete((resp, error) -> {
+                try {
+                    responder.execute(() -> complete(ex, resp, error));
+                } catch (RejectedExecutionException rejected) {
+                    complete(ex, resp, error);
+                }
+            });
+        }
+    }
+
+    private void complete(HttpExchange ex, Object resp, Throwable error) {
+        try {
+            if (error != null) {
+                writeMappedError(ex, unwrap(error));
+            } else {
+                io.writeJson(ex, 200, resp);
+            }
+        } catch (Throwable t) {
+            writeMappedError(ex, t);
+        } finally {
+            io.safeClose(ex);
+        }
+    }
+
+    private static Throwable unwrap(Throwable t) {
+        while ((t instanceof CompletionException || t instanceof ExecutionException) && t.getCause() != null) {
+            t = t.getCause();
+        }
+        return t;
+    }
+
     private void writeMappedError(HttpExchange ex, Throwable t) {
         try {
             RestError err = errors.map(t);
+            if (err.status() == 429) {
+                ex.getResponseHeaders().set("Retry-After", "1");
+            }
             io.writeJson(ex, err.status(), err.payload());
         } catch (IOException ignored) {
         }
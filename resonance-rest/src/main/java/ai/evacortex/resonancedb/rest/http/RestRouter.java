@@ -54,6 +54,17 @@ public final class RestRouter {
         routes.add(Route.forPostJson(path, reqType, handler));
     }
 
+    public <Req, Resp> void postJsonAsync(
+            String path,
+            Class<Req> reqType,
+            ExchangeHandlers.ExchangeAsyncJsonHandler<Req, Resp> handler
+    ) {
+        Objects.requireNonNull(path, "path");
+        Objects.requireNonNull(reqType, "reqType");
+        Objects.requireNonNull(handler, "handler");
+        routes.add(Route.forPostJsonAsync(path, reqType, handler));
+    }
+
     public static String pathParam(HttpExchange ex, String name) {
         Objects.requireNonNull(ex, "exchange");
         Objects.requireNonNull(name, "name");
@@ -101,6 +112,7 @@ public final class RestRouter {
                 case GET -> pipeline.handleGet(ex, best.exchangeHandler);
                 case POST -> pipeline.handlePost(ex, best.exchangeHandler);
                 case POST_JSON -> dispatchPostJson(best, ex);
+                case POST_JSON_ASYNC -> dispatchPostJsonAsync(best, ex);
                 default -> throw new IllegalStateException("Unsupported route kind: " + best.kind);
             }
         } catch (IOException e) {
@@ -115,6 +127,11 @@ public final class RestRouter {
         pipeline.handlePostJson(ex, (Class) route.reqType, (ExchangeHandlers.ExchangeJsonHandler) route.jsonHandler);
     }
 
+    @SuppressWarnings({"rawtypes", "unchecked"})
+    private void dispatchPostJsonAsync(Route route, HttpExchange ex) {
+        pipeline.handlePostJsonAsync(ex, (Class) route.reqType, (ExchangeHandlers.ExchangeAsyncJsonHandler) route.asyncHandler);
+    }
+
     private static void writeNotFound(HttpExchange ex) throws IOException {
         byte[] body = "{\"code\":\"not_found\",\"message\":\"Route not found\"}".getBytes(StandardCharsets.UTF_8);
         ex.getResponseHeaders().set("Content-Type", "application/json; charset=utf-8");
@@ -153,7 +170,8 @@ public final class RestRouter {
     private enum RouteKind {
         GET,
         POST,
-        POST_JSON
+        POST_JSON,
+        POST_JSON_ASYNC
     }
 
     private static final class Route {
@@ -162,31 +180,40 @@ public final class RestRouter {
         private final ExchangeHandlers.ExchangeHandler exchangeHandler;
         private final Class<?> reqType;
         private final ExchangeHandlers.ExchangeJsonHandler<?, ?> jsonHandler;
+        private final ExchangeHandlers.ExchangeAsyncJsonHandler<?, ?> asyncHandler;
 
         private Route(RouteKind kind,
                       CompiledPath path,
                       ExchangeHandlers.ExchangeHandler exchangeHandler,
                       Class<?> reqType,
-                      ExchangeHandlers.ExchangeJsonHandler<?, ?> jsonHandler) {
+                      ExchangeHandlers.ExchangeJsonHandler<?, ?> jsonHandler,
+                      ExchangeHandlers.ExchangeAsyncJsonHandler<?, ?> asyncHandler) {
             this.kind = kind;
             this.path = path;
             this.exchangeHandler = exchangeHandler;
             this.reqType = reqType;
             this.jsonHandler = jsonHandler;
+            this.asyncHandler = asyncHandler;
         }
 
         static Route forGet(String path, ExchangeHandlers.ExchangeHandler handler) {
-            return new Route(RouteKind.GET, CompiledPath.compile(path), handler, null, null);
+            return new Route(RouteKind.GET, CompiledPath.compile(path), handler, null, null, null);
         }
 
         static Route forPost(String path, ExchangeHandlers.ExchangeHandler handler) {
-            return new Route(RouteKind.POST, CompiledPath.compile(path), handler, null, null);
+            return new Route(RouteKind.POST, CompiledPath.compile(path), handler, null, null, null);
         }
 
         static <Req, Resp> Route forPostJson(String path,
                                              Class<Req> reqType,
                                              ExchangeHandlers.ExchangeJsonHandler<Req, Resp> handler) {
-            return new Route(RouteKind.POST_JSON, CompiledPath.compile(path), null, reqType, handler);
+            return new Route(RouteKind.POST_JSON, CompiledPath.compile(path), null, reqType, handler, null);
+        }
+
+        static <Req, Resp> Route forPostJsonAsync(String path,
+                                                  Class<Req> reqType,
+                                                  ExchangeHandlers.ExchangeAsyncJsonHandler<Req, Resp> handler) {
+            return new Route(RouteKind.POST_JSON_ASYNC, CompiledPath.compile(path), null, reqType, null, handler);
         }
 
         boolean supportsMethod(String method) {
@@ -195,7 +222,7 @@ public final class RestRouter {
             }
             return switch (kind) {
                 case GET -> "GET".equals(method);
-                case POST, POST_JSON -> "POST".equals(method);
+                case POST, POST_JSON, POST_JSON_ASYNC -> "POST".equals(method);
             };
         }
     }
@@ -52,6 +52,19 @@ public final class HttpIO {
         ex.getResponseBody().write(bytes);
     }
 
+    /**
+     * Sends {@code 200} with a chunked {@code application/x-ndjson} body; errors raised after this
+     * point can no longer change the status code.
+     */
+    public NdjsonStream startNdjson(HttpExchange ex) throws IOException {
+        Headers h = ex.getResponseHeaders();
+        h.set("Content-Type", "application/x-ndjson; charset=utf-8");
+        h.set("Cache-Control", "no-store");
+
+        ex.sendResponseHeaders(200, 0);
+        return new NdjsonStream(json, ex.getResponseBody());
+    }
+
     // =========================
     // Body handling
     // =========================
@@ -0,0 +1,58 @@
+/*
+ * ResonanceDB — Waveform Semantic Engine
+ * Copyright © 2025-2026 Aleksandr Listopad
+ * SPDX-License-Identifier: LicenseRef-ResonanceDB-License-v1.0
+ *
+ * Patent notice: The authors intend to seek patent protection for this software.
+ * Commercial use >30 days → license@evacortex.ai
+ */
+package ai.evacortex.resonancedb.rest.io;
+
+import ai.evacortex.resonancedb.rest.json.JsonCodec;
+
+import java.io.BufferedOutputStream;
+import java.io.Closeable;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.io.UncheckedIOException;
+import java.util.Objects;
+
+/**
+ * Newline-delimited JSON body written over a chunked response; lines are flushed in small groups
+ * so clients see matches while the query is still running.
+ */
+public final class NdjsonStream implements Closeable {
+
+    private static final int FLUSH_EVERY = 64;
+
+    private final JsonCodec json;
+    private final OutputStream out;
+    private int pending;
+
+    NdjsonStream(JsonCodec json, OutputStream out) {
+        this.json = Objects.requireNonNull(json, "json");
+        this.out = new BufferedOutputStream(Objects.requireNonNull(out, "out"));
+    }
+
+    public void write(Object value) throws IOException {
+        out.write(json.write(value));
+        out.write('\n');
+        if (++pending >= FLUSH_EVERY) {
+            out.flush();
+            pending = 0;
+        }
+    }
+
+    public void writeUnchecked(Object value) {
+        try {
+            write(value);
+        } catch (IOException e) {
+            throw new UncheckedIOException(e);
+        }
+    }
+
+    @Override
+    public void close() throws IOException {
+        out.flush();
+    }
+}
@@ -28,6 +28,7 @@ import java.nio.file.SimpleFileVisitor;
 import java.nio.file.attribute.BasicFileAttributes;
 import java.time.Duration;
 import java.util.Arrays;
+import java.util.List;
 import java.util.Map;
 
 import static org.junit.jupiter.api.Assertions.*;
@@ -151,6 +152,34 @@ public final class ResonanceDBRestEndpointIT {
         assertTrue(err.message().contains(id), "error message must mention existing id");
     }
 
+    @Test
+    void federated_query_with_unknown_corpus_returns_404() throws Exception {
+        WavePatternDto p = constantDto(0.75, 0.4, patternLen());
+        HttpResponse<String> ins = post(corpusPath("/insert"), new InsertRequest(p, Map.of()));
+        assertEquals(200, ins.statusCode(), ins.body());
+
+        HttpResponse<String> missing = post("/query",
+                new FederatedQueryRequest(List.of(CORPUS_ID, "it-missing"), p, 5, null));
+        assertEquals(404, missing.statusCode(), missing.body());
+        ErrorResponse err = read(missing, ErrorResponse.class);
+        assertEquals("corpus_not_found", err.code());
+        assertTrue(err.message().contains("it-missing"), "error message must name the unknown corpus");
+
+        HttpResponse<String> known = post("/query", new FederatedQueryRequest(List.of(CORPUS_ID), p, 5, null));
+        assertEquals(200, known.statusCode(), known.body());
+        JsonNode result = MAPPER.readTree(known.body());
+        assertFalse(result.path("partial").asBoolean(true));
+        assertQueryArrayContainsId(result.get("matches").toString(), read(ins, IdResponse.class).id(),
+                "federated query must find the inserted id");
+
+        HttpResponse<String> envelope = post(corpusPath("/query?envelope=true"), new QueryRequest(p, 5));
+        assertEquals(200, envelope.statusCode(), envelope.body());
+        JsonNode wrapped = MAPPER.readTree(envelope.body());
+        assertTrue(wrapped.path("candidatesScored").asLong() > 0, "the envelope must report scored candidates");
+        assertQueryArrayContainsId(wrapped.get("matches").toString(), read(ins, IdResponse.class).id(),
+                "enveloped query must find the inserted id");
+    }
+
     @Test
     void bad_json_returns_400_bad_json() throws Exception {
         HttpResponse<String> r = postRaw(corpusPath("/query"), "{bad json}");